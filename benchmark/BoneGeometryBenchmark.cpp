@@ -0,0 +1,987 @@
+//
+// File: BoneGeometryBenchmark.cpp
+//
+// Standalone benchmark suite for the bone geometry and drawable helpers.
+// Results are written as JSON or CSV so they can be compared against a stored baseline using compare.py.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryData.h"
+#include "BoneGeometryDrawData.h"
+#include "BoneGeometryDrawOverride.h"
+#include "BoneGeometryRegistry.h"
+#include "BoneGenerator.h"
+#include "Drawable.h"
+#include "PrimitiveCache.h"
+#include "PreparedGeometryCache.h"
+#include "TransformKernel.h"
+
+#include <maya/MLibrary.h>
+#include <maya/MObject.h>
+#include <maya/MPoint.h>
+#include <maya/MPointArray.h>
+#include <maya/MVectorArray.h>
+#include <maya/MIntArray.h>
+#include <maya/MMatrix.h>
+#include <maya/MStatus.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+	const unsigned int	BONE_COUNTS[] = { 1, 10, 100, 1000, 10000, 100000 };
+	const unsigned int	SUBDIVISIONS[] = { 4, 8, 16, 32, 64, 128, 256 };
+	const unsigned int	NUM_SAMPLES = 5;
+
+	struct Options
+	{
+
+		std::string			format = "json";
+		std::string			output;
+		std::string			filter;
+		double				minTime = 0.1;
+		unsigned int		maxBones = 100000;
+		unsigned int		maxSubdivisions = 256;
+
+	};
+
+	struct Result
+	{
+
+		std::string			name;
+		unsigned int		size;
+		unsigned long long	iterations;
+		double				nsPerIteration;
+		double				nsPerItem;
+
+	};
+
+	typedef std::chrono::steady_clock Clock;
+
+
+	double elapsed(const Clock::time_point& start)
+	/**
+	Returns the number of nanoseconds since the supplied time point.
+
+	@param start: The time point to measure from.
+	@return: Elapsed nanoseconds.
+	*/
+	{
+
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+	};
+
+
+	void measure(const std::string& name, const unsigned int size, const unsigned int items, const std::function<void()>& operation, const Options& options, std::vector<Result>& results)
+	/**
+	Times the supplied operation and appends the median time per iteration to the results.
+	The iteration count is calibrated so that each sample runs for at least a fraction of the minimum time.
+
+	@param name: The name of the benchmark.
+	@param size: The swept size, either a bone count or a subdivision count.
+	@param items: The number of items processed per iteration, used to derive the per-item cost.
+	@param operation: The operation to time.
+	@param options: The command line options.
+	@param results: The passed array to append the result to.
+	@return: Void.
+	*/
+	{
+
+		// Check if benchmark has been filtered out
+		//
+		if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+		{
+
+			return;
+
+		}
+
+		// Warm up and calibrate iteration count
+		//
+		Clock::time_point start = Clock::now();
+		operation();
+
+		double sampleTime = (options.minTime * 1e9) / static_cast<double>(NUM_SAMPLES);
+		double firstTime = std::max(elapsed(start), 1.0);
+
+		unsigned long long iterations = static_cast<unsigned long long>(std::max(1.0, sampleTime / firstTime));
+
+		// Collect samples
+		//
+		std::vector<double> samples(NUM_SAMPLES, 0.0);
+
+		for (unsigned int i = 0; i < NUM_SAMPLES; i++)
+		{
+
+			start = Clock::now();
+
+			for (unsigned long long j = 0; j < iterations; j++)
+			{
+
+				operation();
+
+			}
+
+			samples[i] = elapsed(start) / static_cast<double>(iterations);
+
+		}
+
+		std::sort(samples.begin(), samples.end());
+		double median = samples[NUM_SAMPLES / 2];
+
+		results.push_back(Result{ name, size, iterations * NUM_SAMPLES, median, median / static_cast<double>(std::max(items, 1u)) });
+
+	};
+
+
+	std::vector<BoneGeometryData*> createBones(const unsigned int count)
+	/**
+	Creates a series of bone geometry data objects with varying parameters.
+
+	@param count: The number of bones to create.
+	@return: The bone geometry data objects.
+	*/
+	{
+
+		std::vector<BoneGeometryData*> bones(count, nullptr);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+
+			double fraction = static_cast<double>(i % 97) / 97.0;
+
+			BoneGeometryData* bone = new BoneGeometryData();
+			bone->width = 0.5 + fraction;
+			bone->height = 0.5 + (1.0 - fraction);
+			bone->length = 2.0 + (fraction * 10.0);
+			bone->taper = fraction;
+			bone->localPosition = MVector(fraction, 0.0, 0.0);
+			bone->localRotate = MVector(0.0, fraction, 0.0);
+			bone->dirtyObjectMatrix();
+
+			bones[i] = bone;
+
+		}
+
+		return bones;
+
+	};
+
+
+	void deleteBones(std::vector<BoneGeometryData*>& bones)
+	/**
+	Deletes the supplied bone geometry data objects.
+
+	@param bones: The bone geometry data objects to delete.
+	@return: Void.
+	*/
+	{
+
+		for (BoneGeometryData* bone : bones)
+		{
+
+			delete bone;
+
+		}
+
+		bones.clear();
+
+	};
+
+
+	void benchmarkBones(const Options& options, std::vector<Result>& results)
+	/**
+	Benchmarks bone generation along with the transform and line list helpers over a sweep of bone counts.
+
+	@param options: The command line options.
+	@param results: The passed array to append results to.
+	@return: Void.
+	*/
+	{
+
+		MStatus status;
+
+		for (unsigned int count : BONE_COUNTS)
+		{
+
+			if (count > options.maxBones)
+			{
+
+				break;
+
+			}
+
+			std::vector<BoneGeometryData*> bones = createBones(count);
+
+			// Bone body generation
+			//
+			measure("bone.body", count, count, [&]()
+			{
+
+				for (BoneGeometryData* bone : bones)
+				{
+
+					MObject meshData = BoneGeometryDrawOverride::createMeshData(bone, &status);
+
+				}
+
+			}, options, results);
+
+			// Bone body generation including triangle and line extraction, as performed by prepareForDraw()
+			//
+			MPointArray bonePoints, triangles, lines;
+			MVectorArray normals;
+
+			measure("bone.prepare", count, count, [&]()
+			{
+
+				for (BoneGeometryData* bone : bones)
+				{
+
+					BoneGeometryDrawOverride::getPoints(bone, bonePoints);
+					BoneGeometryDrawOverride::getGeometry(bonePoints, bone->shapeKey.finMask, triangles, normals, lines);
+
+				}
+
+			}, options, results);
+
+			// Prepared geometry lookups, as when cached playback restores a frame that has already been drawn
+			//
+			PreparedGeometryCache::clear();
+
+			measure("bone.preparedCache", count, count, [&]()
+			{
+
+				for (BoneGeometryData* bone : bones)
+				{
+
+					std::shared_ptr<const PreparedGeometryCache::PreparedGeometry> prepared = PreparedGeometryCache::get(bone->shapeKey);
+
+				}
+
+			}, options, results);
+
+			PreparedGeometryCache::clear();
+
+			// Same as above with every fin generated, fins are not drawn yet so this exercises the fin generators directly
+			//
+			measure("bone.prepareFins", count, count, [&]()
+			{
+
+				for (BoneGeometryData* bone : bones)
+				{
+
+					BoneGeometryDrawOverride::getPoints(BoneTopology::kAllFins, bone->parameters(), bone->shapeKey.matrix, bonePoints);
+					BoneGeometryDrawOverride::getGeometry(bonePoints, BoneTopology::kAllFins, triangles, normals, lines);
+
+				}
+
+			}, options, results);
+
+			// Screen-size level of detail selection from a perspective camera fifty units away
+			//
+			const double viewProjection[4][4] = { { 2.0, 0.0, 0.0, 0.0 }, { 0.0, 2.0, 0.0, 0.0 }, { 0.0, 0.0, -1.0, -1.0 }, { 0.0, 0.0, 50.0, 50.0 } };
+			unsigned int levels[4] = { 0, 0, 0, 0 };
+
+			measure("bone.levelOfDetail", count, count, [&]()
+			{
+
+				for (BoneGeometryData* bone : bones)
+				{
+
+					MPoint min = bone->boundingBox.min(), max = bone->boundingBox.max();
+					const double boxMin[3] = { min.x, min.y, min.z }, boxMax[3] = { max.x, max.y, max.z };
+
+					double size = LevelOfDetail::projectedSize(boxMin, boxMax, viewProjection, 1920.0, 1080.0);
+					levels[LevelOfDetail::select(size, { bone->wireThreshold, bone->lineThreshold, bone->hideThreshold })]++;
+
+				}
+
+			}, options, results);
+
+			// Same projection as a linear scan over the registry columns
+			//
+			double projectedSize = 0.0;
+
+			measure("registry.projectedSize", count, count, [&]()
+			{
+
+				BoneGeometryRegistry::Reader reader;
+				const BoneGeometryRegistry::Columns& columns = reader.columns();
+
+				for (size_t i = 0; i < columns.numSlots; i++)
+				{
+
+					if (!columns.isAlive[i])
+					{
+
+						continue;
+
+					}
+
+					const double boxMin[3] = { columns.min[0][i], columns.min[1][i], columns.min[2][i] };
+					const double boxMax[3] = { columns.max[0][i], columns.max[1][i], columns.max[2][i] };
+
+					projectedSize += LevelOfDetail::projectedSize(boxMin, boxMax, viewProjection, 1920.0, 1080.0);
+
+				}
+
+			}, options, results);
+
+			// Draw data churn, as when Viewport 2.0 recreates the user data of every bone
+			//
+			std::vector<BoneGeometryDrawData*> drawData(count, nullptr);
+
+			measure("bone.drawData", count, count, [&]()
+			{
+
+				for (unsigned int i = 0; i < count; i++)
+				{
+
+					drawData[i] = new BoneGeometryDrawData();
+
+				}
+
+				for (BoneGeometryDrawData* data : drawData)
+				{
+
+					delete data;
+
+				}
+
+			}, options, results);
+
+			// Specialised generators over a mix of all eight fin configurations
+			//
+			std::vector<unsigned int> finMasks(count);
+			std::vector<BoneGenerator::BoneParameters> parameters(count);
+			std::vector<double> boneMatrices(count * 16);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+
+				finMasks[i] = i % BoneTopology::NUM_CONFIGURATIONS;
+				parameters[i] = bones[i]->parameters();
+				bones[i]->objectMatrix.get(reinterpret_cast<double(*)[4]>(&boneMatrices[i * 16]));
+
+			}
+
+			std::vector<double> batchPoints(BoneGenerator::numVertices(finMasks.data(), count) * 4);
+			const double (*batchMatrices)[4][4] = reinterpret_cast<const double(*)[4][4]>(boneMatrices.data());
+
+			measure("generator.mixed", count, count, [&]()
+			{
+
+				BoneGenerator::generateBatch(finMasks.data(), parameters.data(), batchMatrices, count, reinterpret_cast<BoneGenerator::Point4*>(batchPoints.data()));
+
+			}, options, results);
+
+			BoneGenerator::Point4 boneBuffer[BoneTopology::MAX_VERTICES];
+			BoneGenerator::Point4 triangleBuffer[BoneTopology::MAX_TRIANGLES * 3], lineBuffer[BoneTopology::MAX_EDGES * 2];
+			BoneGenerator::Vector3 normalBuffer[BoneTopology::MAX_TRIANGLES * 3];
+
+			measure("generator.mixedPrepare", count, count, [&]()
+			{
+
+				for (unsigned int i = 0; i < count; i++)
+				{
+
+					BoneGenerator::generate(finMasks[i], parameters[i], batchMatrices[i], boneBuffer);
+					BoneGenerator::buildGeometry(finMasks[i], boneBuffer, triangleBuffer, normalBuffer, lineBuffer);
+
+				}
+
+			}, options, results);
+
+			// Structure-of-arrays generation across bones, without fins and with every fin
+			//
+			std::vector<double> widths(count), heights(count), lengths(count), tapers(count);
+			std::vector<double> finSizes(count), finStartTapers(count), finEndTapers(count);
+			std::vector<double> components(count * 12);
+
+			BoneGenerator::BoneArrays boneArrays;
+			boneArrays.width = widths.data();
+			boneArrays.height = heights.data();
+			boneArrays.length = lengths.data();
+			boneArrays.taper = tapers.data();
+
+			for (unsigned int type = 0; type < BoneGenerator::kNumFinTypes; type++)
+			{
+
+				boneArrays.finSize[type] = finSizes.data();
+				boneArrays.finStartTaper[type] = finStartTapers.data();
+				boneArrays.finEndTaper[type] = finEndTapers.data();
+
+			}
+
+			for (unsigned int row = 0; row < 4; row++)
+			{
+
+				for (unsigned int column = 0; column < 3; column++)
+				{
+
+					boneArrays.matrix[row][column] = components.data() + (((row * 3) + column) * count);
+
+				}
+
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+
+				widths[i] = parameters[i].width;
+				heights[i] = parameters[i].height;
+				lengths[i] = parameters[i].length;
+				tapers[i] = parameters[i].taper;
+				finSizes[i] = parameters[i].sideFins.size;
+				finStartTapers[i] = parameters[i].sideFins.startTaper;
+				finEndTapers[i] = parameters[i].sideFins.endTaper;
+
+				for (unsigned int row = 0; row < 4; row++)
+				{
+
+					for (unsigned int column = 0; column < 3; column++)
+					{
+
+						components[(((row * 3) + column) * count) + i] = batchMatrices[i][row][column];
+
+					}
+
+				}
+
+			}
+
+			std::vector<double> planarX(BoneTopology::MAX_VERTICES * count), planarY(BoneTopology::MAX_VERTICES * count), planarZ(BoneTopology::MAX_VERTICES * count);
+			BoneGenerator::PointArrays pointArrays = { planarX.data(), planarY.data(), planarZ.data() };
+
+			measure("generator.arrays", count, count, [&]()
+			{
+
+				BoneGenerator::generateArrays(BoneTopology::kNoFins, boneArrays, count, pointArrays);
+
+			}, options, results);
+
+			measure("generator.arraysFins", count, count, [&]()
+			{
+
+				BoneGenerator::generateArrays(BoneTopology::kAllFins, boneArrays, count, pointArrays);
+
+			}, options, results);
+
+			// Point transforms, nine points per bone
+			//
+			MPointArray points(count * 9, MPoint(1.0, 2.0, 3.0));
+			MMatrix matrix = bones[0]->objectMatrix;
+
+			measure("drawable.transform", count, count * 9, [&]()
+			{
+
+				Drawable::transform(matrix, points);
+
+			}, options, results);
+
+			// Transform kernels for each supported instruction set
+			//
+			std::vector<double> x(count * 9, 1.0), y(count * 9, 2.0), z(count * 9, 3.0);
+			std::vector<double> matrices(count * 16, 0.0);
+			std::vector<size_t> offsets(count + 1, 0);
+
+			for (unsigned int i = 0; i <= count; i++)
+			{
+
+				offsets[i] = i * 9;
+
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+
+				matrix.get(reinterpret_cast<double(*)[4]>(&matrices[i * 16]));
+
+			}
+
+			TransformKernel::InstructionSet supported = TransformKernel::supportedInstructionSet();
+
+			for (int i = 0; i <= static_cast<int>(supported); i++)
+			{
+
+				TransformKernel::InstructionSet instructionSet = static_cast<TransformKernel::InstructionSet>(i);
+				TransformKernel::setInstructionSet(instructionSet);
+
+				std::string suffix = TransformKernel::instructionSetName(instructionSet);
+
+				measure("kernel.packed." + suffix, count, count * 9, [&]()
+				{
+
+					TransformKernel::transform(matrix.matrix, Drawable::pointData(points), points.length());
+
+				}, options, results);
+
+				measure("kernel.planar." + suffix, count, count * 9, [&]()
+				{
+
+					TransformKernel::transform(matrix.matrix, x.data(), y.data(), z.data(), x.size());
+
+				}, options, results);
+
+				measure("kernel.batch." + suffix, count, count * 9, [&]()
+				{
+
+					TransformKernel::transformBatch(reinterpret_cast<const double(*)[4][4]>(matrices.data()), offsets.data(), count, Drawable::pointData(points));
+
+				}, options, results);
+
+			}
+
+			TransformKernel::setInstructionSet(supported);
+
+			// Line list assembly, one sixteen point curve per bone
+			//
+			std::vector<MPointArray> curves(count, Drawable::circle(MVector::zero, MVector::xAxis, 1.0, 16));
+
+			measure("drawable.stagger", count, count, [&]()
+			{
+
+				MPointArray lineList = Drawable::stagger(curves);
+
+			}, options, results);
+
+			measure("drawable.chain", count, count, [&]()
+			{
+
+				MPointArray lineList = Drawable::chain(curves);
+
+			}, options, results);
+
+			MPointArray lineList, chainList;
+			MUintArray indices;
+
+			measure("drawable.staggerInto", count, count, [&]()
+			{
+
+				Drawable::stagger(curves, lineList);
+
+			}, options, results);
+
+			measure("drawable.chainInto", count, count, [&]()
+			{
+
+				Drawable::chain(curves, chainList);
+
+			}, options, results);
+
+			measure("drawable.staggerIndices", count, count, [&]()
+			{
+
+				Drawable::staggerIndices(curves, indices);
+
+			}, options, results);
+
+			deleteBones(bones);
+
+		}
+
+	};
+
+
+	void benchmarkPrimitives(const Options& options, std::vector<Result>& results)
+	/**
+	Benchmarks the drawable primitives and the mesh extraction helpers over a sweep of subdivision counts.
+
+	@param options: The command line options.
+	@param results: The passed array to append results to.
+	@return: Void.
+	*/
+	{
+
+		MStatus status;
+
+		for (unsigned int subdivisions : SUBDIVISIONS)
+		{
+
+			if (subdivisions > options.maxSubdivisions)
+			{
+
+				break;
+
+			}
+
+			int numPoints = static_cast<int>(subdivisions);
+
+			// Line primitives
+			//
+			measure("drawable.arc", subdivisions, subdivisions, [&]()
+			{
+
+				MPointArray points = Drawable::arc(MVector::zero, MVector::yAxis, 1.0, 0.0, 90.0, numPoints);
+
+			}, options, results);
+
+			measure("drawable.circle", subdivisions, subdivisions, [&]()
+			{
+
+				MPointArray points = Drawable::circle(MVector::zero, MVector::yAxis, 1.0, numPoints);
+
+			}, options, results);
+
+			// Mesh primitives
+			//
+			measure("drawable.sphere", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				MObject meshData;
+				Drawable::sphere(MVector::zero, 1.0, numPoints, numPoints, meshData);
+
+			}, options, results);
+
+			measure("drawable.cylinder", subdivisions, subdivisions, [&]()
+			{
+
+				MObject meshData;
+				Drawable::cylinder(MVector::zero, MVector::xAxis, 1.0, 2.0, numPoints, meshData);
+
+			}, options, results);
+
+			measure("drawable.disc", subdivisions, subdivisions, [&]()
+			{
+
+				MObject meshData;
+				Drawable::disc(MVector::zero, MVector::xAxis, 1.0, numPoints, meshData);
+
+			}, options, results);
+
+			measure("drawable.sector", subdivisions, subdivisions, [&]()
+			{
+
+				MObject meshData;
+				Drawable::sector(MVector::zero, MVector::xAxis, 1.0, 0.0, 90.0, numPoints, meshData);
+
+			}, options, results);
+
+			// Cached primitive instances, without and with point materialisation
+			//
+			measure("primitive.instance", subdivisions, 1, [&]()
+			{
+
+				PrimitiveCache::Instance instance = PrimitiveCache::sphere(MVector::zero, 2.0, numPoints, numPoints);
+
+			}, options, results);
+
+			MPointArray instancePoints;
+
+			measure("primitive.instancePoints", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				PrimitiveCache::sphere(MVector::zero, 2.0, numPoints, numPoints).getPoints(instancePoints);
+
+			}, options, results);
+
+			// Transformed mesh views, bounds and draw buffers without mesh data
+			//
+			TransformedMesh view = PrimitiveCache::sphere(MVector::zero, 2.0, numPoints, numPoints);
+			MPointArray viewTriangles;
+			MVectorArray viewNormals;
+
+			measure("primitive.viewBounds", subdivisions, 1, [&]()
+			{
+
+				MBoundingBox boundingBox = view.boundingBox();
+
+			}, options, results);
+
+			measure("primitive.viewTriangles", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				view.getTriangles(viewTriangles, viewNormals);
+
+			}, options, results);
+
+			// Normal and edge extraction
+			//
+			MObject sphere;
+			Drawable::sphere(MVector::zero, 1.0, numPoints, numPoints, sphere);
+
+			MObject sector;
+			Drawable::sector(MVector::zero, MVector::xAxis, 1.0, 0.0, 90.0, numPoints, sector);
+
+			MPointArray triangles, lines;
+			MVectorArray normals;
+			MIntArray boundary;
+
+			measure("mesh.triangles", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				Drawable::getTriangles(sphere, triangles, normals);
+
+			}, options, results);
+
+			measure("mesh.lines", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				Drawable::getLines(sphere, lines);
+
+			}, options, results);
+
+			measure("mesh.boundary", subdivisions, subdivisions, [&]()
+			{
+
+				Drawable::getBoundary(sector, boundary);
+
+			}, options, results);
+
+			// Half-edge topology, built once and queried without the API
+			//
+			HalfEdgeMesh halfEdgeMesh;
+
+			measure("mesh.halfEdge", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				Drawable::getHalfEdgeMesh(sphere, halfEdgeMesh);
+
+			}, options, results);
+
+			measure("mesh.halfEdgeMatched", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				Drawable::getHalfEdgeMesh(sphere, halfEdgeMesh);
+				Drawable::matchEdgeOrder(sphere, halfEdgeMesh);
+
+			}, options, results);
+
+			MPointArray spherePoints;
+			Drawable::getPoints(sphere, spherePoints);
+
+			measure("mesh.halfEdgeLines", subdivisions, subdivisions * subdivisions, [&]()
+			{
+
+				Drawable::getLines(halfEdgeMesh, spherePoints, lines);
+
+			}, options, results);
+
+		}
+
+	};
+
+
+	void writeJson(std::ostream& stream, const std::vector<Result>& results)
+	/**
+	Writes the supplied results to the stream as JSON.
+
+	@param stream: The output stream.
+	@param results: The results to write.
+	@return: Void.
+	*/
+	{
+
+		stream << "{\n\t\"benchmark\": \"BoneGeometry\",\n\t\"results\": [\n";
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+
+			const Result& result = results[i];
+
+			stream << "\t\t{ \"name\": \"" << result.name << "\", \"size\": " << result.size << ", \"iterations\": " << result.iterations
+				<< ", \"nsPerIteration\": " << result.nsPerIteration << ", \"nsPerItem\": " << result.nsPerItem << " }"
+				<< ((i + 1) < results.size() ? ",\n" : "\n");
+
+		}
+
+		stream << "\t]\n}\n";
+
+	};
+
+
+	void writeCsv(std::ostream& stream, const std::vector<Result>& results)
+	/**
+	Writes the supplied results to the stream as CSV.
+
+	@param stream: The output stream.
+	@param results: The results to write.
+	@return: Void.
+	*/
+	{
+
+		stream << "name,size,iterations,nsPerIteration,nsPerItem\n";
+
+		for (const Result& result : results)
+		{
+
+			stream << result.name << "," << result.size << "," << result.iterations << "," << result.nsPerIteration << "," << result.nsPerItem << "\n";
+
+		}
+
+	};
+
+
+	void printUsage()
+	/**
+	Prints the command line usage.
+
+	@return: Void.
+	*/
+	{
+
+		std::cout << "Usage: BoneGeometryBenchmark [options]\n"
+			<< "  --format json|csv        Output format (default: json)\n"
+			<< "  --output <path>          Output file (default: stdout)\n"
+			<< "  --filter <text>          Only keep benchmarks whose name contains the text\n"
+			<< "  --min-time <seconds>     Minimum time spent per benchmark (default: 0.1)\n"
+			<< "  --max-bones <count>      Largest bone count in the sweep (default: 100000)\n"
+			<< "  --max-subdivisions <n>   Largest subdivision count in the sweep (default: 256)\n";
+
+	};
+
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	/**
+	Parses the command line arguments into the supplied options.
+
+	@param argc: The number of arguments.
+	@param argv: The arguments.
+	@param options: The passed options to populate.
+	@return: Whether the arguments were valid.
+	*/
+	{
+
+		for (int i = 1; i < argc; i++)
+		{
+
+			std::string flag = argv[i];
+			bool hasValue = (i + 1) < argc;
+
+			if (flag == "--format" && hasValue)
+			{
+
+				options.format = argv[++i];
+
+			}
+			else if (flag == "--output" && hasValue)
+			{
+
+				options.output = argv[++i];
+
+			}
+			else if (flag == "--filter" && hasValue)
+			{
+
+				options.filter = argv[++i];
+
+			}
+			else if (flag == "--min-time" && hasValue)
+			{
+
+				options.minTime = std::atof(argv[++i]);
+
+			}
+			else if (flag == "--max-bones" && hasValue)
+			{
+
+				options.maxBones = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else if (flag == "--max-subdivisions" && hasValue)
+			{
+
+				options.maxSubdivisions = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return options.format == "json" || options.format == "csv";
+
+	};
+
+};
+
+
+int main(int argc, char** argv)
+{
+
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+
+		printUsage();
+		return 1;
+
+	}
+
+	// Initialize Maya library
+	//
+	MStatus status = MLibrary::initialize(argv[0], true);
+
+	if (!status)
+	{
+
+		status.perror("MLibrary::initialize");
+		return 1;
+
+	}
+
+	// Run benchmarks
+	//
+	std::vector<Result> results;
+
+	benchmarkBones(options, results);
+	benchmarkPrimitives(options, results);
+
+	// Write results
+	//
+	std::ofstream file;
+
+	if (!options.output.empty())
+	{
+
+		file.open(options.output);
+
+		if (!file)
+		{
+
+			std::cerr << "Unable to open " << options.output << " for writing!\n";
+			MLibrary::cleanup(1);
+
+		}
+
+	}
+
+	std::ostream& stream = options.output.empty() ? std::cout : file;
+
+	if (options.format == "csv")
+	{
+
+		writeCsv(stream, results);
+
+	}
+	else
+	{
+
+		writeJson(stream, results);
+
+	}
+
+	file.close();
+	MLibrary::cleanup(0);
+
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+//
+// File: BoneBoundsCheck.cpp
+//
+// Randomised check that BoneGenerator::bounds() contains every point BoneGenerator::generate() emits, for every fin combination.
+// Parameters and object-matrices are drawn from ranges that include negative sizes, inverted tapers and sheared matrices.
+// The box must also be tight, every face of the box has to be touched by at least one generated point.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGenerator.h"
+#include "BoneTopology.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+
+namespace
+{
+
+	struct Options
+	{
+
+		unsigned int	bones = 100000;
+		unsigned int	seed = 3;
+
+	};
+
+
+	BoneGenerator::BoneParameters createParameters(std::mt19937& random, std::uniform_real_distribution<double>& distribution)
+	/**
+	Returns random bone parameters.
+
+	@param random: The random number generator.
+	@param distribution: The distribution to draw every value from.
+	@return: BoneParameters
+	*/
+	{
+
+		BoneGenerator::BoneParameters parameters;
+
+		parameters.width = distribution(random);
+		parameters.height = distribution(random);
+		parameters.length = distribution(random);
+		parameters.taper = distribution(random);
+		parameters.sideFins = { distribution(random), distribution(random), distribution(random) };
+		parameters.frontFin = { distribution(random), distribution(random), distribution(random) };
+		parameters.backFin = { distribution(random), distribution(random), distribution(random) };
+
+		return parameters;
+
+	};
+
+
+	void createMatrix(std::mt19937& random, std::uniform_real_distribution<double>& distribution, double matrix[4][4])
+	/**
+	Populates a random affine row-vector matrix.
+
+	@param random: The random number generator.
+	@param distribution: The distribution to draw every value from.
+	@param matrix: The passed matrix to populate.
+	@return: Void.
+	*/
+	{
+
+		for (int row = 0; row < 4; row++)
+		{
+
+			for (int column = 0; column < 3; column++)
+			{
+
+				matrix[row][column] = distribution(random);
+
+			}
+
+			matrix[row][3] = (row == 3) ? 1.0 : 0.0;
+
+		}
+
+	};
+
+
+	bool checkBone(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double matrix[4][4])
+	/**
+	Checks the bounds of a single bone against its generated points.
+
+	@param finMask: The fins to generate.
+	@param parameters: The bone parameters.
+	@param matrix: The object-matrix.
+	@return: True if the box contains every point and every face of the box is touched.
+	*/
+	{
+
+		double min[3], max[3];
+		BoneGenerator::bounds(finMask, parameters, matrix, min, max);
+
+		BoneGenerator::Point4 points[BoneTopology::MAX_VERTICES];
+		BoneGenerator::generate(finMask, parameters, matrix, points);
+
+		unsigned int numVertices = BoneTopology::numVertices(finMask);
+		bool touched[6] = {};
+
+		for (unsigned int i = 0; i < numVertices; i++)
+		{
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+
+				if (points[i][axis] < min[axis] || points[i][axis] > max[axis])
+				{
+
+					return false;
+
+				}
+
+				touched[axis] = touched[axis] || (points[i][axis] == min[axis]);
+				touched[axis + 3] = touched[axis + 3] || (points[i][axis] == max[axis]);
+
+			}
+
+		}
+
+		for (bool isTouched : touched)
+		{
+
+			if (!isTouched)
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return true;
+
+	};
+
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	/**
+	Parses the command line arguments into the supplied options.
+
+	@param argc: The number of arguments.
+	@param argv: The arguments.
+	@param options: The passed options to populate.
+	@return: Whether the arguments were valid.
+	*/
+	{
+
+		for (int i = 1; i < argc; i++)
+		{
+
+			std::string flag = argv[i];
+			bool hasValue = (i + 1) < argc;
+
+			if (flag == "--bones" && hasValue)
+			{
+
+				options.bones = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else if (flag == "--seed" && hasValue)
+			{
+
+				options.seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return options.bones > 0;
+
+	};
+
+};
+
+
+int main(int argc, char** argv)
+{
+
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+
+		std::cout << "Usage: BoneBoundsCheck [--bones <count>] [--seed <seed>]\n";
+		return 1;
+
+	}
+
+	std::mt19937 random(options.seed);
+	std::uniform_real_distribution<double> distribution(-2.0, 3.0);
+
+	unsigned int failures = 0;
+
+	for (unsigned int bone = 0; bone < options.bones; bone++)
+	{
+
+		unsigned int finMask = random() % (BoneTopology::kAllFins + 1);
+		BoneGenerator::BoneParameters parameters = createParameters(random, distribution);
+
+		double matrix[4][4];
+		createMatrix(random, distribution, matrix);
+
+		if (!checkBone(finMask, parameters, matrix))
+		{
+
+			std::cerr << "Bone " << bone << " with fin mask " << finMask << " is not tightly bound!\n";
+			failures++;
+
+		}
+
+	}
+
+	std::cout << (options.bones - failures) << " of " << options.bones << " bones passed\n";
+	return (failures == 0) ? 0 : 2;
+
+}
\ No newline at end of file
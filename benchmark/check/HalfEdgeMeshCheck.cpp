@@ -0,0 +1,409 @@
+//
+// File: HalfEdgeMeshCheck.cpp
+//
+// Randomised check of HalfEdgeMesh against the per-edge queries the Drawable mesh functions used to make.
+// Random polygon soups are built and every edge is compared to a brute force edge table, both in first appearance order and after adopting a shuffled external numbering.
+// The external numbering stands in for Maya's edge indices, which Drawable::matchEdgeOrder() adopts through setEdgeOrder().
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "HalfEdgeMesh.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+	typedef std::pair<int, int> EdgeKey;
+	typedef std::map<EdgeKey, std::vector<int>> EdgeTable;
+
+	struct Options
+	{
+
+		unsigned int	trials = 2000;
+		unsigned int	seed = 7;
+
+	};
+
+	struct Polygons
+	{
+
+		int					numVertices = 0;
+		std::vector<int>	counts;
+		std::vector<int>	connects;
+
+	};
+
+
+	EdgeKey makeKey(const int start, const int end)
+	/**
+	Returns an order independent key for the edge between the supplied vertices.
+
+	@param start: The first vertex.
+	@param end: The second vertex.
+	@return: EdgeKey
+	*/
+	{
+
+		return EdgeKey(std::min(start, end), std::max(start, end));
+
+	};
+
+
+	Polygons createPolygons(std::mt19937& random)
+	/**
+	Creates a random polygon soup of triangles, quads and pentagons.
+	Faces pick distinct vertices at random so the result mixes boundary, manifold and non-manifold edges.
+
+	@param random: The random number generator.
+	@return: Polygons
+	*/
+	{
+
+		Polygons polygons;
+		polygons.numVertices = 3 + static_cast<int>(random() % 30);
+
+		int numPolygons = 1 + static_cast<int>(random() % 40);
+
+		std::vector<int> vertices(polygons.numVertices);
+
+		for (int i = 0; i < polygons.numVertices; i++)
+		{
+
+			vertices[i] = i;
+
+		}
+
+		for (int polygon = 0; polygon < numPolygons; polygon++)
+		{
+
+			int count = std::min(3 + static_cast<int>(random() % 3), polygons.numVertices);
+			std::shuffle(vertices.begin(), vertices.end(), random);
+
+			polygons.counts.push_back(count);
+			polygons.connects.insert(polygons.connects.end(), vertices.begin(), vertices.begin() + count);
+
+		}
+
+		return polygons;
+
+	};
+
+
+	EdgeTable createEdgeTable(const Polygons& polygons)
+	/**
+	Returns the faces connected to every edge by walking each polygon, the way the per-edge iterator queries did.
+
+	@param polygons: The polygons to walk.
+	@return: EdgeTable
+	*/
+	{
+
+		EdgeTable table;
+		int offset = 0;
+
+		for (size_t polygon = 0; polygon < polygons.counts.size(); polygon++)
+		{
+
+			int count = polygons.counts[polygon];
+
+			for (int corner = 0; corner < count; corner++)
+			{
+
+				int start = polygons.connects[offset + corner];
+				int end = polygons.connects[offset + ((corner + 1) % count)];
+
+				table[makeKey(start, end)].push_back(static_cast<int>(polygon));
+
+			}
+
+			offset += count;
+
+		}
+
+		return table;
+
+	};
+
+
+	bool compareEdge(const HalfEdgeMesh& mesh, const int edge, const EdgeKey& key, const std::vector<int>& faces)
+	/**
+	Compares a single half-edge mesh edge against the brute force edge table.
+
+	@param mesh: The half-edge mesh.
+	@param edge: The edge index to test.
+	@param key: The expected edge vertices.
+	@param faces: The expected connected faces.
+	@return: True if the edge matches.
+	*/
+	{
+
+		if (makeKey(mesh.edgeStart(edge), mesh.edgeEnd(edge)) != key)
+		{
+
+			return false;
+
+		}
+
+		if (mesh.edgeFaceCount(edge) != static_cast<int>(faces.size()) || mesh.isBoundaryEdge(edge) != (faces.size() == 1))
+		{
+
+			return false;
+
+		}
+
+		int edgeFaces[2] = { -1, -1 };
+		int numEdgeFaces = mesh.edgeFaces(edge, edgeFaces);
+
+		if (numEdgeFaces == 1)
+		{
+
+			return edgeFaces[0] == faces[0];
+
+		}
+		else if (numEdgeFaces == 2)
+		{
+
+			return std::set<int>(edgeFaces, edgeFaces + 2) == std::set<int>(faces.begin(), faces.end());
+
+		}
+
+		return true;
+
+	};
+
+
+	bool checkPolygons(const Polygons& polygons, std::mt19937& random)
+	/**
+	Checks a half-edge mesh built from the supplied polygons against the brute force edge table.
+
+	@param polygons: The polygons to check.
+	@param random: The random number generator used to shuffle the external edge order.
+	@return: True if every query matched.
+	*/
+	{
+
+		HalfEdgeMesh mesh;
+		mesh.build(polygons.numVertices, polygons.counts.data(), static_cast<int>(polygons.counts.size()), polygons.connects.data());
+
+		EdgeTable table = createEdgeTable(polygons);
+
+		if (mesh.numEdges() != static_cast<int>(table.size()))
+		{
+
+			return false;
+
+		}
+
+		// Lines only need the set of edges, not their order
+		//
+		std::set<EdgeKey> lines;
+
+		for (int edge = 0; edge < mesh.numEdges(); edge++)
+		{
+
+			lines.insert(makeKey(mesh.edgeStart(edge), mesh.edgeEnd(edge)));
+
+		}
+
+		if (lines.size() != table.size())
+		{
+
+			return false;
+
+		}
+
+		// Adopt a shuffled external numbering with random edge directions
+		//
+		std::vector<EdgeKey> order;
+
+		for (const auto& item : table)
+		{
+
+			order.push_back(item.first);
+
+		}
+
+		std::shuffle(order.begin(), order.end(), random);
+
+		std::vector<int> edgeVertices;
+
+		for (const EdgeKey& key : order)
+		{
+
+			bool flip = (random() % 2) == 0;
+
+			edgeVertices.push_back(flip ? key.second : key.first);
+			edgeVertices.push_back(flip ? key.first : key.second);
+
+		}
+
+		if (!mesh.setEdgeOrder(edgeVertices.data(), static_cast<int>(order.size())))
+		{
+
+			return false;
+
+		}
+
+		// Compare every edge by its external index
+		//
+		size_t numBoundaries = 0;
+
+		for (int edge = 0; edge < mesh.numEdges(); edge++)
+		{
+
+			const std::vector<int>& faces = table[order[edge]];
+
+			if (!compareEdge(mesh, edge, order[edge], faces))
+			{
+
+				return false;
+
+			}
+
+			numBoundaries += (faces.size() == 1) ? 1 : 0;
+
+		}
+
+		std::vector<int> boundaries;
+		mesh.getBoundaryEdges(boundaries);
+
+		if (boundaries.size() != numBoundaries)
+		{
+
+			return false;
+
+		}
+
+		// Compare vertex one-rings
+		//
+		for (int vertex = 0; vertex < polygons.numVertices; vertex++)
+		{
+
+			std::set<int> expected;
+
+			for (const auto& item : table)
+			{
+
+				if (item.first.first == vertex)
+				{
+
+					expected.insert(item.first.second);
+
+				}
+				else if (item.first.second == vertex)
+				{
+
+					expected.insert(item.first.first);
+
+				}
+
+			}
+
+			std::vector<int> ring;
+			mesh.getVertexOneRing(vertex, ring);
+
+			if (ring.size() != expected.size() || std::set<int>(ring.begin(), ring.end()) != expected)
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return true;
+
+	};
+
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	/**
+	Parses the command line arguments into the supplied options.
+
+	@param argc: The number of arguments.
+	@param argv: The arguments.
+	@param options: The passed options to populate.
+	@return: Whether the arguments were valid.
+	*/
+	{
+
+		for (int i = 1; i < argc; i++)
+		{
+
+			std::string flag = argv[i];
+			bool hasValue = (i + 1) < argc;
+
+			if (flag == "--trials" && hasValue)
+			{
+
+				options.trials = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else if (flag == "--seed" && hasValue)
+			{
+
+				options.seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return options.trials > 0;
+
+	};
+
+};
+
+
+int main(int argc, char** argv)
+{
+
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+
+		std::cout << "Usage: HalfEdgeMeshCheck [--trials <count>] [--seed <seed>]\n";
+		return 1;
+
+	}
+
+	std::mt19937 random(options.seed);
+	unsigned int failures = 0;
+
+	for (unsigned int trial = 0; trial < options.trials; trial++)
+	{
+
+		Polygons polygons = createPolygons(random);
+
+		if (!checkPolygons(polygons, random))
+		{
+
+			std::cerr << "Trial " << trial << " does not match the edge table!\n";
+			failures++;
+
+		}
+
+	}
+
+	std::cout << (options.trials - failures) << " of " << options.trials << " trials passed\n";
+	return (failures == 0) ? 0 : 2;
+
+}
\ No newline at end of file
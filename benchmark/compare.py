@@ -0,0 +1,120 @@
+"""
+Compares two BoneGeometryBenchmark result files and flags regressions beyond a threshold.
+Both JSON and CSV results are supported, the format is derived from the file extension.
+
+Usage: python compare.py baseline.json current.json [--threshold 0.1]
+Returns a non-zero exit code if any benchmark regressed.
+"""
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+
+def load(path):
+    """
+    Loads the benchmark results from the supplied path.
+
+    :type path: str
+    :rtype: dict[tuple[str, int], float]
+    """
+
+    extension = os.path.splitext(path)[-1].lower()
+
+    with open(path, 'r') as file:
+
+        if extension == '.csv':
+
+            rows = list(csv.DictReader(file))
+
+        else:
+
+            rows = json.load(file)['results']
+
+    return {(row['name'], int(row['size'])): float(row['nsPerIteration']) for row in rows}
+
+
+def compare(baseline, current, threshold):
+    """
+    Compares the current results against the baseline.
+    Returns a list of rows containing the key, baseline time, current time, ratio and status.
+
+    :type baseline: dict[tuple[str, int], float]
+    :type current: dict[tuple[str, int], float]
+    :type threshold: float
+    :rtype: list[tuple[tuple[str, int], float, float, float, str]]
+    """
+
+    rows = []
+
+    for key in sorted(set(baseline) | set(current)):
+
+        if key not in current:
+
+            rows.append((key, baseline[key], float('nan'), float('nan'), 'MISSING'))
+            continue
+
+        elif key not in baseline:
+
+            rows.append((key, float('nan'), current[key], float('nan'), 'NEW'))
+            continue
+
+        else:
+
+            ratio = current[key] / baseline[key] if baseline[key] > 0.0 else 1.0
+
+            if ratio > (1.0 + threshold):
+
+                status = 'REGRESSED'
+
+            elif ratio < (1.0 - threshold):
+
+                status = 'IMPROVED'
+
+            else:
+
+                status = 'OK'
+
+            rows.append((key, baseline[key], current[key], ratio, status))
+
+    return rows
+
+
+def main():
+    """
+    Entry point.
+
+    :rtype: int
+    """
+
+    parser = argparse.ArgumentParser(description='Compares BoneGeometryBenchmark results against a baseline.')
+    parser.add_argument('baseline', help='The stored baseline results.')
+    parser.add_argument('current', help='The current results.')
+    parser.add_argument('--threshold', type=float, default=0.1, help='Allowed slowdown as a fraction, defaults to 0.1 (10%%).')
+
+    args = parser.parse_args()
+    rows = compare(load(args.baseline), load(args.current), args.threshold)
+
+    print('{:<24} {:>8} {:>16} {:>16} {:>8}  {}'.format('name', 'size', 'baseline (ns)', 'current (ns)', 'ratio', 'status'))
+
+    for ((name, size), before, after, ratio, status) in rows:
+
+        print('{:<24} {:>8} {:>16.1f} {:>16.1f} {:>8.3f}  {}'.format(name, size, before, after, ratio, status))
+
+    regressions = [row for row in rows if row[-1] == 'REGRESSED']
+
+    if regressions:
+
+        print('\n{} benchmark(s) regressed beyond {:.0%}!'.format(len(regressions), args.threshold))
+        return 1
+
+    else:
+
+        return 0
+
+
+if __name__ == '__main__':
+
+    sys.exit(main())
@@ -0,0 +1,1224 @@
+//
+// File: BoneGeometryStress.cpp
+//
+// Headless stress harness that replays the Viewport 2.0 prepare and draw cycle for synthetic skeletons.
+// Only the Maya-free geometry core is linked so it runs on any machine without Maya, a GPU or a display.
+// Each frame animates the skeleton, then walks every bone through the same stages as BoneGeometryDrawOverride:
+// level of detail selection, the plugin's own PreparedGeometrySlot and PreparedGeometryStore, and the copies MUIDrawManager makes on submission.
+// Only the geometry type differs from the plugin, the buffers are plain vectors instead of Maya arrays.
+// Per-draw data mirrors BoneGeometryDrawData and comes from the same SlabPool, it is created once per bone the way Viewport 2.0 hands user data back.
+// The residentBytes and userDataBytes gauges are reported alongside each result, matching boneGeometryStats for the same scene.
+// Results use the BoneGeometryBenchmark JSON layout so compare.py can gate regressions against a baseline.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGenerator.h"
+#include "BoneTopology.h"
+#include "LevelOfDetail.h"
+#include "PreparedGeometryStore.h"
+#include "BoneGeometryStats.h"
+#include "SlabPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+
+// Allocation tracking
+// Every allocation carries a small header holding its size so live and peak bytes can be measured without platform hooks
+//
+namespace
+{
+
+	const size_t				HEADER_SIZE = alignof(std::max_align_t);
+
+	std::atomic<unsigned long long>	allocationCount(0);
+	std::atomic<unsigned long long>	allocationBytes(0);
+	std::atomic<long long>			liveBytes(0);
+	std::atomic<long long>			peakLiveBytes(0);
+
+	void* trackedAllocate(const size_t size)
+	/**
+	Allocates the supplied number of bytes and records the allocation.
+
+	@param size: The number of bytes requested.
+	@return: A pointer to the usable memory, or null on failure.
+	*/
+	{
+
+		unsigned char* memory = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+
+		if (memory == nullptr)
+		{
+
+			return nullptr;
+
+		}
+
+		std::memcpy(memory, &size, sizeof(size_t));
+
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+		long long live = liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + static_cast<long long>(size);
+		long long peak = peakLiveBytes.load(std::memory_order_relaxed);
+
+		while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+
+		return memory + HEADER_SIZE;
+
+	};
+
+	void trackedFree(void* pointer)
+	/**
+	Releases memory returned by trackedAllocate().
+
+	@param pointer: The pointer to release.
+	@return: Void.
+	*/
+	{
+
+		if (pointer == nullptr)
+		{
+
+			return;
+
+		}
+
+		// Step back to the header through an integer so the compiler does not track the offset against the user allocation
+		//
+		unsigned char* memory = reinterpret_cast<unsigned char*>(reinterpret_cast<std::uintptr_t>(pointer) - HEADER_SIZE);
+
+		size_t size = 0;
+		std::memcpy(&size, memory, sizeof(size_t));
+
+		liveBytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+
+		std::free(memory);
+
+	};
+
+};
+
+
+void* operator new(size_t size)
+{
+
+	void* pointer = trackedAllocate(size);
+
+	if (pointer == nullptr)
+	{
+
+		throw std::bad_alloc();
+
+	}
+
+	return pointer;
+
+}
+
+void* operator new[](size_t size)
+{
+
+	return operator new(size);
+
+}
+
+void operator delete(void* pointer) noexcept
+{
+
+	trackedFree(pointer);
+
+}
+
+void operator delete[](void* pointer) noexcept
+{
+
+	trackedFree(pointer);
+
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+
+	trackedFree(pointer);
+
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+
+	trackedFree(pointer);
+
+}
+
+
+namespace
+{
+
+	const unsigned int	BONE_COUNTS[] = { 100, 1000, 10000, 100000 };
+	const unsigned int	CHAIN_LENGTH = 32;
+	const int			VIEWPORT_WIDTH = 1920;
+	const int			VIEWPORT_HEIGHT = 1080;
+
+	typedef std::chrono::steady_clock Clock;
+	typedef double Matrix[4][4];
+
+	struct Options
+	{
+
+		std::string					format = "json";
+		std::string					output;
+		std::vector<unsigned int>	boneCounts;
+		unsigned int				frames = 60;
+		double						animatedFraction = 0.1;
+		unsigned int				loop = 0;
+		double						budget = 0.0;
+
+	};
+
+	struct Bone
+	{
+
+		int								parent;
+		BoneGenerator::BoneParameters	parameters;
+		double							rotate;
+		Matrix							localMatrix;
+		Matrix							worldMatrix;
+		Matrix							objectMatrix;
+		PreparedGeometryKey				shapeKey;
+		double							min[3];
+		double							max[3];
+		unsigned long long				revision;
+
+	};
+
+	struct PreparedGeometry
+	{
+
+												~PreparedGeometry();
+
+		void									build(const PreparedGeometryKey& key);
+
+		std::vector<double>						points;
+		std::vector<double>						triangles;
+		std::vector<double>						normals;
+		std::vector<double>						lines;
+
+		int64_t									residentBytes = 0;
+
+		static BoneGenerator::Point4*			pointData(std::vector<double>& buffer) { return reinterpret_cast<BoneGenerator::Point4*>(buffer.data()); };
+		static const BoneGenerator::Point4*	pointData(const std::vector<double>& buffer) { return reinterpret_cast<const BoneGenerator::Point4*>(buffer.data()); };
+
+	};
+
+	struct DrawData
+	{
+
+		static void*							operator new(size_t size);
+		static void								operator delete(void* pointer);
+
+		static SlabPool&						pool();
+
+		float									wireColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		unsigned int							depthPriority = 0;
+		LevelOfDetail::Level					level = LevelOfDetail::kFull;
+
+	};
+
+	struct DrawCache
+	{
+
+		std::unique_ptr<DrawData>				drawData;
+		PreparedGeometrySlot<PreparedGeometry>	prepared;
+
+	};
+
+	struct DrawSubmission
+	{
+
+		std::vector<float>	positions;
+		std::vector<float>	normals;
+		unsigned long long	drawables = 0;
+
+	};
+
+	struct Counts
+	{
+
+		unsigned long long	allocations;
+		unsigned long long	bytes;
+
+		static Counts		now() { return { allocationCount.load(), allocationBytes.load() }; };
+
+	};
+
+	struct Stage
+	{
+
+		std::vector<double>	samples;
+		unsigned long long	allocations = 0;
+		unsigned long long	bytes = 0;
+
+		void				addAllocations(const Counts& start, const Counts& end);
+
+		double				mean() const;
+		double				percentile(const double fraction) const;
+		double				maximum() const;
+
+	};
+
+	struct Result
+	{
+
+		std::string			name;
+		unsigned int		size;
+		unsigned int		frames;
+		double				nsPerIteration;
+		double				p95;
+		double				max;
+		double				allocationsPerFrame;
+		double				bytesPerFrame;
+		long long			peakLiveBytes;
+		long long			peakRssBytes;
+		long long			residentBytes;
+		long long			userDataBytes;
+
+	};
+
+
+	double Stage::mean() const
+	/**
+	Returns the mean sample in nanoseconds.
+
+	@return: double
+	*/
+	{
+
+		double total = 0.0;
+
+		for (double sample : this->samples)
+		{
+
+			total += sample;
+
+		}
+
+		return this->samples.empty() ? 0.0 : total / static_cast<double>(this->samples.size());
+
+	};
+
+
+	void Stage::addAllocations(const Counts& start, const Counts& end)
+	/**
+	Adds the allocations made between the supplied counts to this stage.
+
+	@param start: The counts when the stage started.
+	@param end: The counts when the stage ended.
+	@return: Void.
+	*/
+	{
+
+		this->allocations += end.allocations - start.allocations;
+		this->bytes += end.bytes - start.bytes;
+
+	};
+
+
+	double Stage::percentile(const double fraction) const
+	/**
+	Returns the sample at the supplied fraction using the nearest-rank method.
+
+	@param fraction: The percentile as a fraction between zero and one.
+	@return: double
+	*/
+	{
+
+		if (this->samples.empty())
+		{
+
+			return 0.0;
+
+		}
+
+		std::vector<double> sorted = this->samples;
+		std::sort(sorted.begin(), sorted.end());
+
+		size_t index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size()))) - 1;
+		return sorted[std::min(index, sorted.size() - 1)];
+
+	};
+
+
+	double Stage::maximum() const
+	/**
+	Returns the slowest sample in nanoseconds.
+
+	@return: double
+	*/
+	{
+
+		return this->samples.empty() ? 0.0 : *std::max_element(this->samples.begin(), this->samples.end());
+
+	};
+
+
+	PreparedGeometry::~PreparedGeometry()
+	/**
+	Destructor.
+	Releases the buffers from the resident bytes gauge, the same as PreparedGeometryCache::PreparedGeometry.
+	*/
+	{
+
+		BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, -this->residentBytes);
+
+	};
+
+
+	void PreparedGeometry::build(const PreparedGeometryKey& key)
+	/**
+	Regenerates the points and draw buffers for the supplied key, see PreparedGeometryCache::PreparedGeometry::build().
+	The vectors only reallocate when the topology grows, so rebuilding an animated shape in place never allocates.
+
+	@param key: The shape to build.
+	@return: Void.
+	*/
+	{
+
+		const BoneTopology::TopologyView& topology = BoneTopology::topology(key.finMask);
+
+		this->points.resize(topology.numVertices * 4);
+		this->triangles.resize(topology.numTriangles * 3 * 4);
+		this->normals.resize(topology.numTriangles * 3 * 3);
+		this->lines.resize(topology.numEdges * 2 * 4);
+
+		BoneGenerator::generate(key.finMask, key.parameters, key.matrix, PreparedGeometry::pointData(this->points));
+		BoneGenerator::buildGeometry(key.finMask, PreparedGeometry::pointData(this->points), PreparedGeometry::pointData(this->triangles), reinterpret_cast<BoneGenerator::Vector3*>(this->normals.data()), PreparedGeometry::pointData(this->lines));
+
+		this->residentBytes = static_cast<int64_t>((this->points.size() + this->triangles.size() + this->normals.size() + this->lines.size()) * sizeof(double));
+
+	};
+
+
+	void* DrawData::operator new(size_t size)
+	/**
+	Allocates an instance from the shared slab pool, see BoneGeometryDrawData::operator new().
+
+	@param size: The size of the instance.
+	@return: void*
+	*/
+	{
+
+		if (size > DrawData::pool().slotSize())
+		{
+
+			throw std::bad_alloc();
+
+		}
+
+		BoneGeometryStats::addGauge(BoneGeometryStats::kUserDataBytes, static_cast<int64_t>(DrawData::pool().slotSize()));
+		return DrawData::pool().allocate();
+
+	};
+
+
+	void DrawData::operator delete(void* pointer)
+	/**
+	Returns an instance to the shared slab pool.
+
+	@param pointer: The instance to release.
+	@return: Void.
+	*/
+	{
+
+		if (pointer == nullptr)
+		{
+
+			return;
+
+		}
+
+		BoneGeometryStats::addGauge(BoneGeometryStats::kUserDataBytes, -static_cast<int64_t>(DrawData::pool().slotSize()));
+		DrawData::pool().deallocate(pointer);
+
+	};
+
+
+	SlabPool& DrawData::pool()
+	/**
+	Returns the pool shared by every instance.
+
+	@return: SlabPool
+	*/
+	{
+
+		static SlabPool pool(sizeof(DrawData), 1024);
+		return pool;
+
+	};
+
+
+	double elapsed(const Clock::time_point& start)
+	/**
+	Returns the number of nanoseconds since the supplied time point.
+
+	@param start: The time point to measure from.
+	@return: Elapsed nanoseconds.
+	*/
+	{
+
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+	};
+
+
+	long long peakRss()
+	/**
+	Returns the peak resident set size of the process in bytes, or zero where it cannot be queried.
+
+	@return: long long
+	*/
+	{
+
+#if defined(__linux__)
+		struct rusage usage;
+		return (getrusage(RUSAGE_SELF, &usage) == 0) ? static_cast<long long>(usage.ru_maxrss) * 1024 : 0;
+#elif defined(__APPLE__)
+		struct rusage usage;
+		return (getrusage(RUSAGE_SELF, &usage) == 0) ? static_cast<long long>(usage.ru_maxrss) : 0;
+#else
+		return 0;
+#endif
+
+	};
+
+
+	void multiply(const Matrix a, const Matrix b, Matrix result)
+	/**
+	Multiplies two row-vector matrices.
+
+	@param a: The left-hand matrix.
+	@param b: The right-hand matrix.
+	@param result: The passed matrix to populate, this must not alias either input.
+	@return: Void.
+	*/
+	{
+
+		for (int i = 0; i < 4; i++)
+		{
+
+			for (int j = 0; j < 4; j++)
+			{
+
+				result[i][j] = (a[i][0] * b[0][j]) + (a[i][1] * b[1][j]) + (a[i][2] * b[2][j]) + (a[i][3] * b[3][j]);
+
+			}
+
+		}
+
+	};
+
+
+	void setRotateTranslate(const double angle, const double x, const double y, const double z, Matrix matrix)
+	/**
+	Populates a row-vector matrix that rotates around the z-axis followed by a translation.
+
+	@param angle: The rotation in radians.
+	@param x: The x translation.
+	@param y: The y translation.
+	@param z: The z translation.
+	@param matrix: The passed matrix to populate.
+	@return: Void.
+	*/
+	{
+
+		double c = std::cos(angle), s = std::sin(angle);
+
+		const double values[4][4] =
+		{
+			{ c, s, 0.0, 0.0 },
+			{ -s, c, 0.0, 0.0 },
+			{ 0.0, 0.0, 1.0, 0.0 },
+			{ x, y, z, 1.0 }
+		};
+
+		std::memcpy(matrix, values, sizeof(values));
+
+	};
+
+
+	void createViewProjection(Matrix matrix)
+	/**
+	Populates a row-vector view-projection matrix for a camera that looks down the negative z-axis at the skeletons.
+
+	@param matrix: The passed matrix to populate.
+	@return: Void.
+	*/
+	{
+
+		const double fov = 0.8, nearClip = 0.1, farClip = 10000.0;
+		const double aspect = static_cast<double>(VIEWPORT_WIDTH) / static_cast<double>(VIEWPORT_HEIGHT);
+		const double f = 1.0 / std::tan(fov * 0.5);
+
+		Matrix view, projection;
+
+		setRotateTranslate(0.0, -100.0, -20.0, -400.0, view);
+
+		const double values[4][4] =
+		{
+			{ f / aspect, 0.0, 0.0, 0.0 },
+			{ 0.0, f, 0.0, 0.0 },
+			{ 0.0, 0.0, (farClip + nearClip) / (nearClip - farClip), -1.0 },
+			{ 0.0, 0.0, (2.0 * farClip * nearClip) / (nearClip - farClip), 0.0 }
+		};
+
+		std::memcpy(projection, values, sizeof(values));
+		multiply(view, projection, matrix);
+
+	};
+
+
+	std::vector<Bone> createSkeleton(const unsigned int count)
+	/**
+	Creates chains of bones laid out in a grid, with varying shapes and fin configurations.
+
+	@param count: The number of bones to create.
+	@return: The bones, parents always precede their children.
+	*/
+	{
+
+		std::vector<Bone> bones(count);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+
+			Bone& bone = bones[i];
+			unsigned int link = i % CHAIN_LENGTH;
+			unsigned int chain = i / CHAIN_LENGTH;
+			double fraction = static_cast<double>(i % 97) / 97.0;
+
+			bone.parent = (link == 0) ? -1 : static_cast<int>(i - 1);
+			bone.parameters.width = 0.5 + fraction;
+			bone.parameters.height = 0.5 + (1.0 - fraction);
+			bone.parameters.length = 2.0 + (fraction * 4.0);
+			bone.parameters.taper = fraction;
+			bone.parameters.sideFins = { 0.5, 0.1, 0.1 };
+			bone.parameters.frontFin = { 0.5, 0.1, 0.1 };
+			bone.parameters.backFin = { 0.5, 0.1, 0.1 };
+			bone.rotate = 0.05 * fraction;
+
+			if (bone.parent < 0)
+			{
+
+				setRotateTranslate(0.0, static_cast<double>(chain % 64) * 4.0, 0.0, -static_cast<double>(chain / 64) * 4.0, bone.localMatrix);
+
+			}
+			else
+			{
+
+				setRotateTranslate(bone.rotate, bones[bone.parent].parameters.length, 0.0, 0.0, bone.localMatrix);
+
+			}
+
+			setRotateTranslate(0.0, 0.0, 0.0, 0.0, bone.objectMatrix);
+			bone.revision = 0;
+
+		}
+
+		return bones;
+
+	};
+
+
+	void evaluate(std::vector<Bone>& bones, const unsigned int frame, const double animatedFraction)
+	/**
+	Animates the skeleton for the supplied frame.
+	Every joint rotation is animated so all world matrices change, a fraction of the bones also animate their length which forces a rebuild.
+	Shape keys, bounds and revisions are refreshed for reshaped bones the same way BoneGeometryData::dirtyBoundingBox() does.
+	Only the body is drawn and it is drawn in bone space, see BoneGeometryData::drawnShape().
+
+	@param bones: The bones to animate.
+	@param frame: The frame number.
+	@param animatedFraction: The fraction of bones whose shape is animated.
+	@return: Void.
+	*/
+	{
+
+		double time = static_cast<double>(frame) / 24.0;
+		unsigned int stride = (animatedFraction > 0.0) ? static_cast<unsigned int>(std::max(1.0, std::round(1.0 / animatedFraction))) : 0;
+
+		for (size_t i = 0; i < bones.size(); i++)
+		{
+
+			Bone& bone = bones[i];
+			bool isReshaped = (bone.revision == 0) || (stride > 0 && (i % stride) == (frame % stride));
+
+			if (isReshaped)
+			{
+
+				bone.parameters.length = 2.0 + (static_cast<double>(i % 97) / 97.0 * 4.0) + (0.5 * std::sin(time + static_cast<double>(i)));
+
+				PreparedGeometryKey shapeKey(BoneTopology::kNoFins, bone.parameters, bone.objectMatrix);
+
+				if (shapeKey != bone.shapeKey)
+				{
+
+					bone.shapeKey = shapeKey;
+
+					BoneGenerator::bounds(shapeKey.finMask, shapeKey.parameters, shapeKey.matrix, bone.min, bone.max);
+					bone.revision++;
+
+				}
+
+			}
+
+			if (bone.parent < 0)
+			{
+
+				std::memcpy(bone.worldMatrix, bone.localMatrix, sizeof(Matrix));
+
+			}
+			else
+			{
+
+				const Bone& parent = bones[bone.parent];
+				setRotateTranslate(bone.rotate + (0.1 * std::sin(time + static_cast<double>(i % CHAIN_LENGTH))), parent.parameters.length, 0.0, 0.0, bone.localMatrix);
+
+				multiply(bone.localMatrix, parent.worldMatrix, bone.worldMatrix);
+
+			}
+
+		}
+
+	};
+
+
+	void prepareForDraw(const Bone& bone, const Matrix viewProjection, PreparedGeometryStore<PreparedGeometry>& store, DrawCache& cache)
+	/**
+	Mirrors BoneGeometryDrawOverride::prepareForDraw().
+	The level of detail is selected from the projected bounds and the buffers come from the same slot and store the plugin uses.
+
+	@param bone: The bone to prepare.
+	@param viewProjection: The camera view-projection matrix.
+	@param store: The store shared by every bone, standing in for PreparedGeometryCache.
+	@param cache: The per-bone draw cache, standing in for the draw override's members and the user data Viewport 2.0 hands back.
+	@return: Void.
+	*/
+	{
+
+		if (cache.drawData == nullptr)
+		{
+
+			cache.drawData.reset(new DrawData());
+
+		}
+
+		DrawData* drawData = cache.drawData.get();
+
+		Matrix matrix;
+		multiply(bone.worldMatrix, viewProjection, matrix);
+
+		double size = LevelOfDetail::projectedSize(bone.min, bone.max, matrix, static_cast<double>(VIEWPORT_WIDTH), static_cast<double>(VIEWPORT_HEIGHT));
+		drawData->level = LevelOfDetail::select(size, LevelOfDetail::Thresholds{ 16.0, 4.0, 1.0 });
+
+		if (drawData->level == LevelOfDetail::kHidden)
+		{
+
+			return;
+
+		}
+
+		cache.prepared.prepare(bone.shapeKey, bone.revision, store);
+
+	};
+
+
+	void appendPoints(const BoneGenerator::Point4* points, const size_t count, std::vector<float>& buffer)
+	/**
+	Appends the supplied homogeneous points to a float buffer, dropping the w component.
+
+	@param points: The points to append.
+	@param count: The number of points.
+	@param buffer: The passed buffer to append to.
+	@return: Void.
+	*/
+	{
+
+		for (size_t i = 0; i < count; i++)
+		{
+
+			buffer.push_back(static_cast<float>(points[i][0]));
+			buffer.push_back(static_cast<float>(points[i][1]));
+			buffer.push_back(static_cast<float>(points[i][2]));
+
+		}
+
+	};
+
+
+	void addUIDrawables(const DrawCache& cache, DrawSubmission& submission)
+	/**
+	Mirrors BoneGeometryDrawOverride::addUIDrawables().
+	MUIDrawManager copies the submitted arrays into its own float buffers, which is reproduced here per level of detail.
+
+	@param cache: The per-bone draw cache.
+	@param submission: The frame's accumulated draw data.
+	@return: Void.
+	*/
+	{
+
+		const DrawData* drawData = cache.drawData.get();
+		const PreparedGeometry* prepared = cache.prepared.geometry();
+
+		if (drawData == nullptr || prepared == nullptr)
+		{
+
+			return;
+
+		}
+
+		switch (drawData->level)
+		{
+
+			case LevelOfDetail::kFull:
+			{
+
+				appendPoints(PreparedGeometry::pointData(prepared->triangles), prepared->triangles.size() / 4, submission.positions);
+
+				for (double normal : prepared->normals)
+				{
+
+					submission.normals.push_back(static_cast<float>(normal));
+
+				}
+
+				appendPoints(PreparedGeometry::pointData(prepared->lines), prepared->lines.size() / 4, submission.positions);
+				submission.drawables += 2;
+				break;
+
+			}
+
+			case LevelOfDetail::kWire:
+			{
+
+				appendPoints(PreparedGeometry::pointData(prepared->lines), prepared->lines.size() / 4, submission.positions);
+				submission.drawables += 1;
+				break;
+
+			}
+
+			case LevelOfDetail::kLine:
+			{
+
+				const BoneGenerator::Point4* points = PreparedGeometry::pointData(prepared->points);
+				BoneGenerator::Point4 line[2];
+
+				std::memcpy(line[0], points[0], sizeof(BoneGenerator::Point4));
+
+				for (int i = 0; i < 4; i++)
+				{
+
+					line[1][i] = points[5][i] + ((points[7][i] - points[5][i]) * 0.5);
+
+				}
+
+				appendPoints(line, 2, submission.positions);
+				submission.drawables += 1;
+				break;
+
+			}
+
+			default:
+			{
+
+				break;
+
+			}
+
+		}
+
+	};
+
+
+	void run(const unsigned int count, const Options& options, std::vector<Result>& results)
+	/**
+	Runs the stress test for the supplied bone count and appends a result for each stage.
+
+	@param count: The number of bones.
+	@param options: The command line options.
+	@param results: The passed array to append the results to.
+	@return: Void.
+	*/
+	{
+
+		PreparedGeometryStore<PreparedGeometry> store;
+
+		std::vector<Bone> bones = createSkeleton(count);
+		std::vector<DrawCache> caches(count);
+		DrawSubmission submission;
+
+		Matrix viewProjection;
+		createViewProjection(viewProjection);
+
+		Stage evaluateStage, prepareStage, drawStage, frameStage;
+
+		for (Stage* stage : { &evaluateStage, &prepareStage, &drawStage, &frameStage })
+		{
+
+			stage->samples.reserve(options.frames);
+
+		}
+
+		peakLiveBytes.store(liveBytes.load());
+
+		// The first frame builds every cache and is excluded from the statistics
+		//
+		for (unsigned int frame = 0; frame <= options.frames; frame++)
+		{
+
+			Counts evaluateCounts = Counts::now();
+
+			Clock::time_point start = Clock::now();
+			evaluate(bones, (options.loop > 0) ? (frame % options.loop) : frame, options.animatedFraction);
+			double evaluateTime = elapsed(start);
+
+			Counts prepareCounts = Counts::now();
+
+			start = Clock::now();
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+
+				prepareForDraw(bones[i], viewProjection, store, caches[i]);
+
+			}
+
+			double prepareTime = elapsed(start);
+
+			// MUIDrawManager releases its buffers at the end of each frame
+			//
+			Counts drawCounts = Counts::now();
+
+			start = Clock::now();
+
+			submission.positions.clear();
+			submission.normals.clear();
+			submission.drawables = 0;
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+
+				addUIDrawables(caches[i], submission);
+
+			}
+
+			double drawTime = elapsed(start);
+
+			Counts endCounts = Counts::now();
+
+			if (frame == 0)
+			{
+
+				continue;
+
+			}
+
+			evaluateStage.samples.push_back(evaluateTime);
+			prepareStage.samples.push_back(prepareTime);
+			drawStage.samples.push_back(drawTime);
+			frameStage.samples.push_back(evaluateTime + prepareTime + drawTime);
+
+			evaluateStage.addAllocations(evaluateCounts, prepareCounts);
+			prepareStage.addAllocations(prepareCounts, drawCounts);
+			drawStage.addAllocations(drawCounts, endCounts);
+			frameStage.addAllocations(evaluateCounts, endCounts);
+
+		}
+
+		double frames = static_cast<double>(std::max(options.frames, 1u));
+
+		uint64_t counters[BoneGeometryStats::kNumCounters];
+		int64_t gauges[BoneGeometryStats::kNumGauges];
+
+		BoneGeometryStats::snapshot(counters, gauges);
+
+		const std::pair<const char*, const Stage*> stages[] =
+		{
+			{ "stress.evaluate", &evaluateStage },
+			{ "stress.prepare", &prepareStage },
+			{ "stress.draw", &drawStage },
+			{ "stress.frame", &frameStage }
+		};
+
+		for (const std::pair<const char*, const Stage*>& stage : stages)
+		{
+
+			results.push_back(Result{ stage.first, count, options.frames, stage.second->mean(), stage.second->percentile(0.95), stage.second->maximum(), static_cast<double>(stage.second->allocations) / frames, static_cast<double>(stage.second->bytes) / frames, peakLiveBytes.load(), peakRss(), gauges[BoneGeometryStats::kResidentBytes], gauges[BoneGeometryStats::kUserDataBytes] });
+
+		}
+
+	};
+
+
+	void writeJson(std::ostream& stream, const std::vector<Result>& results)
+	/**
+	Writes the supplied results to the stream as JSON.
+
+	@param stream: The output stream.
+	@param results: The results to write.
+	@return: Void.
+	*/
+	{
+
+		stream << "{\n\t\"benchmark\": \"BoneGeometryStress\",\n\t\"results\": [\n";
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+
+			const Result& result = results[i];
+
+			stream << "\t\t{ \"name\": \"" << result.name << "\", \"size\": " << result.size << ", \"iterations\": " << result.frames
+				<< ", \"nsPerIteration\": " << result.nsPerIteration << ", \"p95\": " << result.p95 << ", \"max\": " << result.max
+				<< ", \"allocationsPerFrame\": " << result.allocationsPerFrame << ", \"bytesPerFrame\": " << result.bytesPerFrame
+				<< ", \"peakLiveBytes\": " << result.peakLiveBytes << ", \"peakRssBytes\": " << result.peakRssBytes
+				<< ", \"residentBytes\": " << result.residentBytes << ", \"userDataBytes\": " << result.userDataBytes << " }"
+				<< ((i + 1) < results.size() ? ",\n" : "\n");
+
+		}
+
+		stream << "\t]\n}\n";
+
+	};
+
+
+	void writeCsv(std::ostream& stream, const std::vector<Result>& results)
+	/**
+	Writes the supplied results to the stream as CSV.
+
+	@param stream: The output stream.
+	@param results: The results to write.
+	@return: Void.
+	*/
+	{
+
+		stream << "name,size,iterations,nsPerIteration,p95,max,allocationsPerFrame,bytesPerFrame,peakLiveBytes,peakRssBytes,residentBytes,userDataBytes\n";
+
+		for (const Result& result : results)
+		{
+
+			stream << result.name << "," << result.size << "," << result.frames << "," << result.nsPerIteration << "," << result.p95 << "," << result.max << ","
+				<< result.allocationsPerFrame << "," << result.bytesPerFrame << "," << result.peakLiveBytes << "," << result.peakRssBytes << "," << result.residentBytes << "," << result.userDataBytes << "\n";
+
+		}
+
+	};
+
+
+	void printUsage()
+	/**
+	Prints the command line usage.
+
+	@return: Void.
+	*/
+	{
+
+		std::cout << "Usage: BoneGeometryStress [options]\n"
+			<< "  --format json|csv        Output format (default: json)\n"
+			<< "  --output <path>          Output file (default: stdout)\n"
+			<< "  --bones <n,n,...>        Bone counts to run (default: 100,1000,10000,100000)\n"
+			<< "  --frames <count>         Frames to time per bone count (default: 60)\n"
+			<< "  --animated <fraction>    Fraction of bones reshaped each frame (default: 0.1)\n"
+			<< "  --loop <frames>          Replay the first frames in a loop, as cached playback does (default: off)\n"
+			<< "  --budget <ms>            Fail if any mean frame time exceeds the budget\n";
+
+	};
+
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	/**
+	Parses the command line arguments into the supplied options.
+
+	@param argc: The number of arguments.
+	@param argv: The arguments.
+	@param options: The passed options to populate.
+	@return: Whether the arguments were valid.
+	*/
+	{
+
+		for (int i = 1; i < argc; i++)
+		{
+
+			std::string flag = argv[i];
+			bool hasValue = (i + 1) < argc;
+
+			if (flag == "--format" && hasValue)
+			{
+
+				options.format = argv[++i];
+
+			}
+			else if (flag == "--output" && hasValue)
+			{
+
+				options.output = argv[++i];
+
+			}
+			else if (flag == "--bones" && hasValue)
+			{
+
+				std::stringstream stream(argv[++i]);
+				std::string item;
+
+				while (std::getline(stream, item, ','))
+				{
+
+					options.boneCounts.push_back(static_cast<unsigned int>(std::atoi(item.c_str())));
+
+				}
+
+			}
+			else if (flag == "--frames" && hasValue)
+			{
+
+				options.frames = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else if (flag == "--animated" && hasValue)
+			{
+
+				options.animatedFraction = std::atof(argv[++i]);
+
+			}
+			else if (flag == "--loop" && hasValue)
+			{
+
+				options.loop = static_cast<unsigned int>(std::atoi(argv[++i]));
+
+			}
+			else if (flag == "--budget" && hasValue)
+			{
+
+				options.budget = std::atof(argv[++i]);
+
+			}
+			else
+			{
+
+				return false;
+
+			}
+
+		}
+
+		if (options.boneCounts.empty())
+		{
+
+			options.boneCounts.assign(std::begin(BONE_COUNTS), std::end(BONE_COUNTS));
+
+		}
+
+		return (options.format == "json" || options.format == "csv") && options.frames > 0;
+
+	};
+
+};
+
+
+int main(int argc, char** argv)
+{
+
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+
+		printUsage();
+		return 1;
+
+	}
+
+	// Run stress tests
+	//
+	std::vector<Result> results;
+
+	for (unsigned int count : options.boneCounts)
+	{
+
+		run(count, options, results);
+
+	}
+
+	// Write results
+	//
+	std::ofstream file;
+
+	if (!options.output.empty())
+	{
+
+		file.open(options.output);
+
+		if (!file)
+		{
+
+			std::cerr << "Unable to open " << options.output << " for writing!\n";
+			return 1;
+
+		}
+
+	}
+
+	std::ostream& stream = options.output.empty() ? std::cout : file;
+
+	if (options.format == "csv")
+	{
+
+		writeCsv(stream, results);
+
+	}
+	else
+	{
+
+		writeJson(stream, results);
+
+	}
+
+	file.close();
+
+	// Check frame budget
+	//
+	if (options.budget > 0.0)
+	{
+
+		for (const Result& result : results)
+		{
+
+			if (result.name == "stress.frame" && (result.nsPerIteration / 1e6) > options.budget)
+			{
+
+				std::cerr << result.size << " bones took " << (result.nsPerIteration / 1e6) << "ms per frame, exceeding the " << options.budget << "ms budget!\n";
+				return 2;
+
+			}
+
+		}
+
+	}
+
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,669 @@
+//
+// File: BoneGenerator.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__clang__)
+#define BONE_GENERATOR_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define BONE_GENERATOR_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define BONE_GENERATOR_IVDEP __pragma(loop(ivdep))
+#else
+#define BONE_GENERATOR_IVDEP
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BONE_GENERATOR_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define BONE_GENERATOR_INLINE [[msvc::forceinline]]
+#else
+#define BONE_GENERATOR_INLINE
+#endif
+
+
+namespace
+{
+
+	inline double clampUnit(const double value)
+	/**
+	Clamps the supplied value to the unit range.
+	This is written without comparisons so loops that use it remain branch-free and can be vectorised.
+
+	@param value: The value to clamp.
+	@return: double
+	*/
+	{
+
+		return 0.5 * (std::fabs(value) - std::fabs(value - 1.0) + 1.0);
+
+	};
+
+
+	inline void setPoint(double point[3], const double x, const double y, const double z)
+	/**
+	Assigns the supplied components to a local point.
+
+	@param point: The point to write to.
+	@param x: The x component.
+	@param y: The y component.
+	@param z: The z component.
+	@return: Void.
+	*/
+	{
+
+		point[0] = x;
+		point[1] = y;
+		point[2] = z;
+
+	};
+
+
+	inline void addFin(double (*points)[3], const double base[3], const double tip[3], const int axis, const double sign, const BoneGenerator::FinParameters& fin)
+	/**
+	Writes the four points of a fin.
+	The fin runs along the body surface from the base to the tip, while its outer edge is inset by the start and end tapers.
+
+	@param points: The buffer to write to.
+	@param base: The surface point at the base of the bone.
+	@param tip: The surface point at the tip of the bone.
+	@param axis: The axis the fin extends along.
+	@param sign: The direction along the axis, either 1 or -1.
+	@param fin: The fin parameters.
+	@return: Void.
+	*/
+	{
+
+		double start = clampUnit(fin.startTaper);
+		double end = 1.0 - clampUnit(fin.endTaper);
+		end = (end > start) ? end : start;
+
+		for (int i = 0; i < 3; i++)
+		{
+
+			double edge = tip[i] - base[i];
+			double offset = (i == axis) ? (fin.size * sign) : 0.0;
+
+			points[0][i] = base[i];
+			points[1][i] = tip[i];
+			points[2][i] = base[i] + (edge * end) + offset;
+			points[3][i] = base[i] + (edge * start) + offset;
+
+		}
+
+	};
+
+
+	template<unsigned int Mask>
+	void generatePoints(const BoneGenerator::BoneParameters& parameters, const double matrix[4][4], BoneGenerator::Point4* points)
+	/**
+	Generates the points for a single bone with the fin configuration fixed at compile time.
+
+	@param parameters: The bone parameters.
+	@param matrix: The matrix to transform the points by.
+	@param points: The buffer to write to, this must hold BoneTopology::numVertices(Mask) points.
+	@return: Void.
+	*/
+	{
+
+		constexpr unsigned int NUM_VERTICES = BoneTopology::numVertices(Mask);
+		double local[NUM_VERTICES][3];
+
+		// Compute body points
+		//
+		double minLength = std::max(parameters.width, parameters.height);
+		double length = std::max(parameters.length, minLength);
+
+		double baseX = parameters.width * 0.5, baseY = parameters.height * 0.5, baseZ = parameters.width * 0.5;
+		double tipX = length, tipY = (1.0 - parameters.taper) * 0.5, tipZ = (1.0 - parameters.taper) * 0.5;
+
+		setPoint(local[0], 0.0, 0.0, 0.0);
+		setPoint(local[1], baseX, -baseY, baseZ);
+		setPoint(local[2], baseX, baseY, baseZ);
+		setPoint(local[3], baseX, baseY, -baseZ);
+		setPoint(local[4], baseX, -baseY, -baseZ);
+		setPoint(local[5], tipX, -tipY, tipZ);
+		setPoint(local[6], tipX, tipY, tipZ);
+		setPoint(local[7], tipX, tipY, -tipZ);
+		setPoint(local[8], tipX, -tipY, -tipZ);
+
+		// Compute fin points
+		//
+		unsigned int offset = BoneTopology::BODY_NUM_VERTICES;
+
+		if constexpr ((Mask & BoneTopology::kSideFins) != 0)
+		{
+
+			const double leftBase[3] = { baseX, 0.0, baseZ }, leftTip[3] = { tipX, 0.0, tipZ };
+			const double rightBase[3] = { baseX, 0.0, -baseZ }, rightTip[3] = { tipX, 0.0, -tipZ };
+
+			addFin(&local[offset], leftBase, leftTip, 2, 1.0, parameters.sideFins);
+			addFin(&local[offset + BoneTopology::FIN_NUM_VERTICES], rightBase, rightTip, 2, -1.0, parameters.sideFins);
+
+			offset += BoneTopology::FIN_NUM_VERTICES * 2;
+
+		}
+
+		if constexpr ((Mask & BoneTopology::kFrontFin) != 0)
+		{
+
+			const double base[3] = { baseX, baseY, 0.0 }, tip[3] = { tipX, tipY, 0.0 };
+
+			addFin(&local[offset], base, tip, 1, 1.0, parameters.frontFin);
+			offset += BoneTopology::FIN_NUM_VERTICES;
+
+		}
+
+		if constexpr ((Mask & BoneTopology::kBackFin) != 0)
+		{
+
+			const double base[3] = { baseX, -baseY, 0.0 }, tip[3] = { tipX, -tipY, 0.0 };
+
+			addFin(&local[offset], base, tip, 1, -1.0, parameters.backFin);
+			offset += BoneTopology::FIN_NUM_VERTICES;
+
+		}
+
+		// Transform points, this is the same homogeneous multiplication as MPoint * MMatrix
+		//
+		for (unsigned int i = 0; i < NUM_VERTICES; i++)
+		{
+
+			double x = local[i][0], y = local[i][1], z = local[i][2];
+
+			points[i][0] = (x * matrix[0][0]) + (y * matrix[1][0]) + (z * matrix[2][0]) + matrix[3][0];
+			points[i][1] = (x * matrix[0][1]) + (y * matrix[1][1]) + (z * matrix[2][1]) + matrix[3][1];
+			points[i][2] = (x * matrix[0][2]) + (y * matrix[1][2]) + (z * matrix[2][2]) + matrix[3][2];
+			points[i][3] = (x * matrix[0][3]) + (y * matrix[1][3]) + (z * matrix[2][3]) + matrix[3][3];
+
+		}
+
+	};
+
+
+	template<unsigned int Mask>
+	void buildTopology(const BoneGenerator::Point4* points, BoneGenerator::Point4* triangles, BoneGenerator::Vector3* normals, BoneGenerator::Point4* lines)
+	/**
+	Fills the triangle, normal and line buffers for a single bone with the fin configuration fixed at compile time.
+	Each triangle vertex receives the flat normal of the face it belongs to.
+
+	@param points: The bone points.
+	@param triangles: The buffer to write triangle points to.
+	@param normals: The buffer to write triangle normals to.
+	@param lines: The buffer to write line segments to.
+	@return: Void.
+	*/
+	{
+
+		constexpr const BoneTopology::Topology<Mask>& topology = BoneTopology::TOPOLOGY<Mask>;
+
+		// Compute flat face normals
+		//
+		double faceNormals[topology.NUM_POLYGONS][3];
+
+		for (unsigned int i = 0; i < topology.NUM_POLYGONS; i++)
+		{
+
+			const int* connects = topology.polygonConnects.data() + topology.polygonOffsets[i];
+			const int last = topology.polygonCounts[i] - 1;
+
+			const double* p0 = points[connects[0]];
+			const double* p1 = points[connects[1]];
+			const double* p2 = points[connects[2]];
+			const double* p3 = points[connects[last]];
+
+			double a[3], b[3];
+
+			for (int j = 0; j < 3; j++)
+			{
+
+				a[j] = (last == 2) ? (p1[j] - p0[j]) : (p2[j] - p0[j]);
+				b[j] = (last == 2) ? (p2[j] - p0[j]) : (p3[j] - p1[j]);
+
+			}
+
+			double x = (a[1] * b[2]) - (a[2] * b[1]);
+			double y = (a[2] * b[0]) - (a[0] * b[2]);
+			double z = (a[0] * b[1]) - (a[1] * b[0]);
+
+			double length = std::sqrt((x * x) + (y * y) + (z * z));
+			double scale = (length > 0.0) ? (1.0 / length) : 0.0;
+
+			faceNormals[i][0] = x * scale;
+			faceNormals[i][1] = y * scale;
+			faceNormals[i][2] = z * scale;
+
+		}
+
+		// Copy triangles
+		//
+		for (unsigned int i = 0; i < (topology.NUM_TRIANGLES * 3); i++)
+		{
+
+			const double* point = points[topology.triangleVertices[i]];
+			const double* normal = faceNormals[topology.triangleFaces[i / 3]];
+
+			triangles[i][0] = point[0];
+			triangles[i][1] = point[1];
+			triangles[i][2] = point[2];
+			triangles[i][3] = point[3];
+
+			normals[i][0] = normal[0];
+			normals[i][1] = normal[1];
+			normals[i][2] = normal[2];
+
+		}
+
+		// Copy edges
+		//
+		for (unsigned int i = 0; i < (topology.NUM_EDGES * 2); i++)
+		{
+
+			const double* point = points[topology.edgeVertices[i]];
+
+			lines[i][0] = point[0];
+			lines[i][1] = point[1];
+			lines[i][2] = point[2];
+			lines[i][3] = point[3];
+
+		}
+
+	};
+
+
+	template<unsigned int Mask>
+	void generatePointArrays(const BoneGenerator::BoneArrays& bones, const size_t numBones, const BoneGenerator::PointArrays& points)
+	/**
+	Generates the points for many bones sharing the fin configuration fixed at compile time.
+	The loop runs across bones with every vertex written to its own contiguous stream, which allows the compiler to vectorise it.
+
+	@param bones: The bone parameters and affine matrices as structure-of-arrays.
+	@param numBones: The number of bones.
+	@param points: The planar buffers to write to, each holding numVertices(Mask) * numBones values in vertex-major order.
+	@return: Void.
+	*/
+	{
+
+		// Hoist every stream into a local restricted pointer so the stores cannot alias the inputs
+		//
+		double* __restrict x = points.x;
+		double* __restrict y = points.y;
+		double* __restrict z = points.z;
+
+		const double* __restrict widths = bones.width;
+		const double* __restrict heights = bones.height;
+		const double* __restrict lengths = bones.length;
+		const double* __restrict tapers = bones.taper;
+
+		const double* __restrict m00s = bones.matrix[0][0]; const double* __restrict m01s = bones.matrix[0][1]; const double* __restrict m02s = bones.matrix[0][2];
+		const double* __restrict m10s = bones.matrix[1][0]; const double* __restrict m11s = bones.matrix[1][1]; const double* __restrict m12s = bones.matrix[1][2];
+		const double* __restrict m20s = bones.matrix[2][0]; const double* __restrict m21s = bones.matrix[2][1]; const double* __restrict m22s = bones.matrix[2][2];
+		const double* __restrict m30s = bones.matrix[3][0]; const double* __restrict m31s = bones.matrix[3][1]; const double* __restrict m32s = bones.matrix[3][2];
+
+		const double* __restrict finSizes[BoneGenerator::kNumFinTypes];
+		const double* __restrict finStartTapers[BoneGenerator::kNumFinTypes];
+		const double* __restrict finEndTapers[BoneGenerator::kNumFinTypes];
+
+		for (unsigned int type = 0; type < BoneGenerator::kNumFinTypes; type++)
+		{
+
+			finSizes[type] = bones.finSize[type];
+			finStartTapers[type] = bones.finStartTaper[type];
+			finEndTapers[type] = bones.finEndTaper[type];
+
+		}
+
+		// Bones are processed in blocks that are staged in a small scratch buffer
+		// Writing every vertex stream directly would keep dozens of output streams open at once which thrashes the cache
+		//
+		constexpr unsigned int NUM_VERTICES = BoneTopology::numVertices(Mask);
+		constexpr size_t BLOCK_SIZE = 32;
+
+		double blockX[NUM_VERTICES][BLOCK_SIZE];
+		double blockY[NUM_VERTICES][BLOCK_SIZE];
+		double blockZ[NUM_VERTICES][BLOCK_SIZE];
+
+		for (size_t first = 0; first < numBones; first += BLOCK_SIZE)
+		{
+
+			const size_t count = std::min(BLOCK_SIZE, numBones - first);
+
+			BONE_GENERATOR_IVDEP
+			for (size_t j = 0; j < count; j++)
+			{
+
+				// Load matrix
+				//
+				const size_t i = first + j;
+
+				const double m00 = m00s[i], m01 = m01s[i], m02 = m02s[i];
+				const double m10 = m10s[i], m11 = m11s[i], m12 = m12s[i];
+				const double m20 = m20s[i], m21 = m21s[i], m22 = m22s[i];
+				const double m30 = m30s[i], m31 = m31s[i], m32 = m32s[i];
+
+				auto emit = [&](const unsigned int vertex, const double px, const double py, const double pz) BONE_GENERATOR_INLINE
+				{
+
+					blockX[vertex][j] = (px * m00) + (py * m10) + (pz * m20) + m30;
+					blockY[vertex][j] = (px * m01) + (py * m11) + (pz * m21) + m31;
+					blockZ[vertex][j] = (px * m02) + (py * m12) + (pz * m22) + m32;
+
+				};
+
+				// Compute body points
+				//
+				const double width = widths[i], height = heights[i];
+				const double minLength = (width > height) ? width : height;
+				const double length = (lengths[i] > minLength) ? lengths[i] : minLength;
+				const double taper = tapers[i];
+
+				const double baseX = width * 0.5, baseY = height * 0.5, baseZ = width * 0.5;
+				const double tipX = length, tipY = (1.0 - taper) * 0.5, tipZ = (1.0 - taper) * 0.5;
+
+				emit(0, 0.0, 0.0, 0.0);
+				emit(1, baseX, -baseY, baseZ);
+				emit(2, baseX, baseY, baseZ);
+				emit(3, baseX, baseY, -baseZ);
+				emit(4, baseX, -baseY, -baseZ);
+				emit(5, tipX, -tipY, tipZ);
+				emit(6, tipX, tipY, tipZ);
+				emit(7, tipX, tipY, -tipZ);
+				emit(8, tipX, -tipY, -tipZ);
+
+				// Compute fin points
+				// Fins sit on the centre line of a face, running from v at the base to tipV at the tip, where v is the axis the fin extends along
+				//
+				auto emitFin = [&](const unsigned int vertex, const unsigned int type, const bool alongZ, const double v, const double tipV, const double sign) BONE_GENERATOR_INLINE
+				{
+
+					const double size = finSizes[type][i] * sign;
+					const double startTaper = finStartTapers[type][i], endTaper = finEndTapers[type][i];
+
+					const double start = clampUnit(startTaper);
+					double end = 1.0 - clampUnit(endTaper);
+					end = (end > start) ? end : start;
+
+					const double edgeX = tipX - baseX, edgeV = tipV - v;
+
+					const double outerEndX = baseX + (edgeX * end), outerEndV = v + (edgeV * end) + size;
+					const double outerStartX = baseX + (edgeX * start), outerStartV = v + (edgeV * start) + size;
+
+					if (alongZ)
+					{
+
+						emit(vertex, baseX, 0.0, v);
+						emit(vertex + 1, tipX, 0.0, tipV);
+						emit(vertex + 2, outerEndX, 0.0, outerEndV);
+						emit(vertex + 3, outerStartX, 0.0, outerStartV);
+
+					}
+					else
+					{
+
+						emit(vertex, baseX, v, 0.0);
+						emit(vertex + 1, tipX, tipV, 0.0);
+						emit(vertex + 2, outerEndX, outerEndV, 0.0);
+						emit(vertex + 3, outerStartX, outerStartV, 0.0);
+
+					}
+
+				};
+
+				unsigned int offset = BoneTopology::BODY_NUM_VERTICES;
+
+				if constexpr ((Mask & BoneTopology::kSideFins) != 0)
+				{
+
+					emitFin(offset, BoneGenerator::kSideFinIndex, true, baseZ, tipZ, 1.0);
+					emitFin(offset + BoneTopology::FIN_NUM_VERTICES, BoneGenerator::kSideFinIndex, true, -baseZ, -tipZ, -1.0);
+
+					offset += BoneTopology::FIN_NUM_VERTICES * 2;
+
+				}
+
+				if constexpr ((Mask & BoneTopology::kFrontFin) != 0)
+				{
+
+					emitFin(offset, BoneGenerator::kFrontFinIndex, false, baseY, tipY, 1.0);
+					offset += BoneTopology::FIN_NUM_VERTICES;
+
+				}
+
+				if constexpr ((Mask & BoneTopology::kBackFin) != 0)
+				{
+
+					emitFin(offset, BoneGenerator::kBackFinIndex, false, -baseY, -tipY, -1.0);
+					offset += BoneTopology::FIN_NUM_VERTICES;
+
+				}
+
+			}
+
+			// Flush block into the vertex streams
+			//
+			for (unsigned int vertex = 0; vertex < NUM_VERTICES; vertex++)
+			{
+
+				const size_t index = (vertex * numBones) + first;
+
+				std::copy(blockX[vertex], blockX[vertex] + count, x + index);
+				std::copy(blockY[vertex], blockY[vertex] + count, y + index);
+				std::copy(blockZ[vertex], blockZ[vertex] + count, z + index);
+
+			}
+
+		}
+
+	};
+
+
+	const BoneGenerator::PointGenerator POINT_GENERATORS[BoneTopology::NUM_CONFIGURATIONS] =
+	{
+		generatePoints<0>, generatePoints<1>, generatePoints<2>, generatePoints<3>,
+		generatePoints<4>, generatePoints<5>, generatePoints<6>, generatePoints<7>
+	};
+
+	const BoneGenerator::GeometryBuilder GEOMETRY_BUILDERS[BoneTopology::NUM_CONFIGURATIONS] =
+	{
+		buildTopology<0>, buildTopology<1>, buildTopology<2>, buildTopology<3>,
+		buildTopology<4>, buildTopology<5>, buildTopology<6>, buildTopology<7>
+	};
+
+	typedef void (*ArrayGenerator)(const BoneGenerator::BoneArrays& bones, const size_t numBones, const BoneGenerator::PointArrays& points);
+
+	const ArrayGenerator ARRAY_GENERATORS[BoneTopology::NUM_CONFIGURATIONS] =
+	{
+		generatePointArrays<0>, generatePointArrays<1>, generatePointArrays<2>, generatePointArrays<3>,
+		generatePointArrays<4>, generatePointArrays<5>, generatePointArrays<6>, generatePointArrays<7>
+	};
+
+};
+
+
+BoneGenerator::PointGenerator BoneGenerator::pointGenerator(const unsigned int finMask)
+/**
+Returns the point generator specialised for the supplied fin configuration.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@return: PointGenerator
+*/
+{
+
+	return POINT_GENERATORS[finMask & BoneTopology::kAllFins];
+
+};
+
+
+BoneGenerator::GeometryBuilder BoneGenerator::geometryBuilder(const unsigned int finMask)
+/**
+Returns the triangle and line builder specialised for the supplied fin configuration.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@return: GeometryBuilder
+*/
+{
+
+	return GEOMETRY_BUILDERS[finMask & BoneTopology::kAllFins];
+
+};
+
+
+void BoneGenerator::generate(const unsigned int finMask, const BoneParameters& parameters, const double matrix[4][4], Point4* points)
+/**
+Generates the points for a single bone.
+The supplied buffer must hold BoneTopology::numVertices(finMask) points.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@param parameters: The bone parameters.
+@param matrix: The matrix to transform the points by.
+@param points: The buffer to write to.
+@return: Void.
+*/
+{
+
+	POINT_GENERATORS[finMask & BoneTopology::kAllFins](parameters, matrix, points);
+
+};
+
+
+void BoneGenerator::bounds(const unsigned int finMask, const BoneParameters& parameters, const double matrix[4][4], double min[3], double max[3])
+/**
+Computes the tightest axis-aligned box around a single bone, including its fins.
+Since every face is planar and spans the generated points the box is taken from their extents, this remains exact under rotation.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@param parameters: The bone parameters.
+@param matrix: The matrix to transform the points by.
+@param min: The minimum corner to write to.
+@param max: The maximum corner to write to.
+@return: Void.
+*/
+{
+
+	Point4 points[BoneTopology::MAX_VERTICES];
+	POINT_GENERATORS[finMask & BoneTopology::kAllFins](parameters, matrix, points);
+
+	unsigned int numVertices = BoneTopology::topology(finMask).numVertices;
+
+	for (int j = 0; j < 3; j++)
+	{
+
+		min[j] = points[0][j];
+		max[j] = points[0][j];
+
+	}
+
+	for (unsigned int i = 1; i < numVertices; i++)
+	{
+
+		for (int j = 0; j < 3; j++)
+		{
+
+			min[j] = std::min(min[j], points[i][j]);
+			max[j] = std::max(max[j], points[i][j]);
+
+		}
+
+	}
+
+};
+
+
+void BoneGenerator::buildGeometry(const unsigned int finMask, const Point4* points, Point4* triangles, Vector3* normals, Point4* lines)
+/**
+Fills the triangle, normal and line buffers for a single bone.
+The triangle and normal buffers must hold numTriangles(finMask) * 3 items, and the line buffer numEdges(finMask) * 2 points.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@param points: The bone points.
+@param triangles: The buffer to write triangle points to.
+@param normals: The buffer to write triangle normals to.
+@param lines: The buffer to write line segments to.
+@return: Void.
+*/
+{
+
+	GEOMETRY_BUILDERS[finMask & BoneTopology::kAllFins](points, triangles, normals, lines);
+
+};
+
+
+size_t BoneGenerator::numVertices(const unsigned int* finMasks, const size_t numBones)
+/**
+Returns the number of points required to generate the supplied bones back to back.
+
+@param finMasks: The fin configuration for each bone.
+@param numBones: The number of bones.
+@return: size_t
+*/
+{
+
+	size_t numVertices = 0;
+
+	for (size_t i = 0; i < numBones; i++)
+	{
+
+		numVertices += BoneTopology::topology(finMasks[i]).numVertices;
+
+	}
+
+	return numVertices;
+
+};
+
+
+size_t BoneGenerator::generateBatch(const unsigned int* finMasks, const BoneParameters* parameters, const double (*matrices)[4][4], const size_t numBones, Point4* points)
+/**
+Generates the points for the supplied bones back to back.
+Each bone selects its specialised generator once, the points buffer must hold numVertices(finMasks, numBones) points.
+
+@param finMasks: The fin configuration for each bone.
+@param parameters: The parameters for each bone.
+@param matrices: The matrix for each bone.
+@param numBones: The number of bones.
+@param points: The buffer to write to.
+@return: The number of points written.
+*/
+{
+
+	size_t offset = 0;
+
+	for (size_t i = 0; i < numBones; i++)
+	{
+
+		unsigned int finMask = finMasks[i] & BoneTopology::kAllFins;
+
+		POINT_GENERATORS[finMask](parameters[i], matrices[i], points + offset);
+		offset += BoneTopology::topology(finMask).numVertices;
+
+	}
+
+	return offset;
+
+};
+
+
+void BoneGenerator::generateArrays(const unsigned int finMask, const BoneArrays& bones, const size_t numBones, const PointArrays& points)
+/**
+Generates the points for many bones that share the supplied fin configuration.
+Matrices are supplied per component as bones.matrix[row][column] and are assumed to be affine.
+Each output buffer holds numVertices(finMask) * numBones values, where vertex v of bone i lives at (v * numBones) + i.
+Fin arrays for disabled fins are never read and may be null.
+
+@param finMask: A combination of BoneTopology::FinMask flags.
+@param bones: The bone parameters as structure-of-arrays.
+@param numBones: The number of bones.
+@param points: The planar buffers to write to.
+@return: Void.
+*/
+{
+
+	ARRAY_GENERATORS[finMask & BoneTopology::kAllFins](bones, numBones, points);
+
+};
\ No newline at end of file
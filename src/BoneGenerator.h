@@ -0,0 +1,99 @@
+#ifndef _BONE_GENERATOR
+#define _BONE_GENERATOR
+//
+// File: BoneGenerator.h
+//
+// Maya-free bone generators specialised for each fin configuration.
+// Every configuration is compiled separately with its vertex count known up front, the matching instantiation is selected once per bone through a dispatch table.
+// Points are written in the order described by BoneTopology.h and transformed by a row-vector matrix.
+// The array variants take structure-of-arrays input for many bones sharing a fin configuration and vectorise across bones.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneTopology.h"
+
+#include <cstddef>
+
+
+namespace BoneGenerator
+{
+
+	typedef double Point4[4];
+	typedef double Vector3[3];
+
+	struct FinParameters
+	{
+
+		double	size;
+		double	startTaper;
+		double	endTaper;
+
+	};
+
+	struct BoneParameters
+	{
+
+		double			width;
+		double			height;
+		double			length;
+		double			taper;
+
+		FinParameters	sideFins;
+		FinParameters	frontFin;
+		FinParameters	backFin;
+
+	};
+
+	enum FinType : unsigned int
+	{
+
+		kSideFinIndex = 0,
+		kFrontFinIndex = 1,
+		kBackFinIndex = 2,
+		kNumFinTypes = 3
+
+	};
+
+	struct BoneArrays
+	{
+
+		const double*	width;
+		const double*	height;
+		const double*	length;
+		const double*	taper;
+
+		const double*	finSize[kNumFinTypes];
+		const double*	finStartTaper[kNumFinTypes];
+		const double*	finEndTaper[kNumFinTypes];
+
+		const double*	matrix[4][3];
+
+	};
+
+	struct PointArrays
+	{
+
+		double*	x;
+		double*	y;
+		double*	z;
+
+	};
+
+	typedef void (*PointGenerator)(const BoneParameters& parameters, const double matrix[4][4], Point4* points);
+	typedef void (*GeometryBuilder)(const Point4* points, Point4* triangles, Vector3* normals, Point4* lines);
+
+	PointGenerator	pointGenerator(const unsigned int finMask);
+	GeometryBuilder	geometryBuilder(const unsigned int finMask);
+
+	void			generate(const unsigned int finMask, const BoneParameters& parameters, const double matrix[4][4], Point4* points);
+	void			bounds(const unsigned int finMask, const BoneParameters& parameters, const double matrix[4][4], double min[3], double max[3]);
+	void			buildGeometry(const unsigned int finMask, const Point4* points, Point4* triangles, Vector3* normals, Point4* lines);
+
+	size_t			numVertices(const unsigned int* finMasks, const size_t numBones);
+	size_t			generateBatch(const unsigned int* finMasks, const BoneParameters* parameters, const double (*matrices)[4][4], const size_t numBones, Point4* points);
+
+	void			generateArrays(const unsigned int finMask, const BoneArrays& bones, const size_t numBones, const PointArrays& points);
+
+};
+#endif
\ No newline at end of file
@@ -29,6 +29,10 @@ MObject	BoneGeometry::backFin;
 MObject	BoneGeometry::backFinSize;
 MObject	BoneGeometry::backFinStartTaper;
 MObject	BoneGeometry::backFinEndTaper;
+MObject	BoneGeometry::levelOfDetail;
+MObject	BoneGeometry::wireThreshold;
+MObject	BoneGeometry::lineThreshold;
+MObject	BoneGeometry::hideThreshold;
 
 MObject	BoneGeometry::objectMatrix;
 MObject	BoneGeometry::objectInverseMatrix;
@@ -42,6 +46,9 @@ MString	BoneGeometry::sizeCategory("Size");
 MString	BoneGeometry::sideFinsCategory("SideFins");
 MString	BoneGeometry::frontFinCategory("FrontFin");
 MString	BoneGeometry::backFinCategory("BackFin");
+MString	BoneGeometry::levelOfDetailCategory("LevelOfDetail");
+
+std::vector<BoneGeometry::DrawAttribute>	BoneGeometry::drawAttributes;
 
 MString	BoneGeometry::drawDbClassification("drawdb/geometry/BoneGeometry");
 MString	BoneGeometry::drawRegistrantId("BoneGeometryPlugin");
@@ -53,8 +60,8 @@ BoneGeometry::BoneGeometry()
 Constructor.
 */
 {
-	
-	this->data = new BoneGeometryData();
+
+	BoneGeometryBatch::registerBone(this, this->data.handle);
 
 };
 
@@ -65,7 +72,9 @@ Destructor.
 */
 {
 
-	delete this->data;
+	BoneGeometryBatch::deregisterBone(this, this->data.handle);
+	BoneGeometryCameraWatch::watch(this, false);
+	BoneGeometryDirtyQueue::remove(this);
 
 };
 
@@ -84,8 +93,22 @@ Only these values should be used when performing computations!
 */
 {
 
+	BONE_GEOMETRY_PROFILE("compute", kColorE_L1, this->thisMObject());
+	BoneGeometryTrace::Scope trace("BoneGeometry::compute");
+
 	MStatus status;
 
+	// Record compute call against the requested plug
+	//
+	BoneGeometryStats::Counter counter = (plug == BoneGeometry::objectMatrix) ? BoneGeometryStats::kComputeObjectMatrix :
+		(plug == BoneGeometry::objectInverseMatrix) ? BoneGeometryStats::kComputeObjectInverseMatrix :
+		(plug == BoneGeometry::objectWorldMatrix) ? BoneGeometryStats::kComputeObjectWorldMatrix :
+		(plug == BoneGeometry::objectWorldInverseMatrix) ? BoneGeometryStats::kComputeObjectWorldInverseMatrix :
+		BoneGeometryStats::kComputeOther;
+
+	BoneGeometryStats::add(counter);
+	this->stats.computes.fetch_add(1, std::memory_order_relaxed);
+
 	// Check requested attribute
 	//
 	if (plug == BoneGeometry::objectMatrix || plug == BoneGeometry::objectInverseMatrix)
@@ -115,30 +138,9 @@ Only these values should be used when performing computations!
 		MMatrix objectMatrix = scaleMatrix * rotateMatrix * positionMatrix;
 		MMatrix objectInverseMatrix = objectMatrix.inverse();
 
-		// Get output data handles
+		// Commit values to the data block
 		//
-		MDataHandle objectMatrixHandle = data.outputValue(BoneGeometry::objectMatrix, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
-
-		MDataHandle objectInverseMatrixHandle = data.outputValue(BoneGeometry::objectInverseMatrix, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
-
-		// Commit values to data handle
-		//
-		objectMatrixHandle.setMMatrix(objectMatrix);
-		objectInverseMatrixHandle.setMMatrix(objectInverseMatrix);
-
-		// Mark handles as clean
-		//
-		objectMatrixHandle.setClean();
-		objectInverseMatrixHandle.setClean();
-
-		// Mark plug as clean
-		//
-		status = data.setClean(plug);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
-
-		return MS::kSuccess;
+		return BoneGeometry::setObjectMatrices(data, objectMatrix, objectInverseMatrix);
 
 	}
 	else if (plug == BoneGeometry::objectWorldMatrix || plug == BoneGeometry::objectWorldInverseMatrix)
@@ -162,72 +164,149 @@ Only these values should be used when performing computations!
 
 		unsigned int numPaths = dagPaths.length();
 
-		// Define data builders
+		// Compute matrices for each path
 		//
-		MArrayDataHandle objectWorldMatrixArrayHandle = data.outputArrayValue(BoneGeometry::objectWorldMatrix, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
+		std::vector<MMatrix> objectWorldMatrices(numPaths);
+		std::vector<MMatrix> objectWorldInverseMatrices(numPaths);
 
-		MArrayDataBuilder objectWorldMatrixBuilder(&data, BoneGeometry::objectWorldMatrix, numPaths, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
+		for (unsigned int i = 0; i < numPaths; i++)
+		{
 
-		MArrayDataHandle objectWorldInverseMatrixArrayHandle = data.outputArrayValue(BoneGeometry::objectWorldInverseMatrix, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
+			MMatrix inclusiveMatrix = dagPaths[i].inclusiveMatrix();
 
-		MArrayDataBuilder objectWorldInverseMatrixBuilder(&data, BoneGeometry::objectWorldInverseMatrix, numPaths, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
+			objectWorldMatrices[i] = objectMatrix * inclusiveMatrix;
+			objectWorldInverseMatrices[i] = objectWorldMatrices[i].inverse();
 
-		for (unsigned int i = 0; i < numPaths; i++)
-		{
+		}
 
-			// Create new data handles for elements
-			//
-			MDataHandle hObjectWorldMatrix = objectWorldMatrixBuilder.addElement(i, &status);
-			MDataHandle hObjectWorldInverseMatrix = objectWorldInverseMatrixBuilder.addElement(i, &status);
+		// Commit values to the data block
+		//
+		return BoneGeometry::setObjectWorldMatrices(data, objectWorldMatrices.data(), objectWorldInverseMatrices.data(), numPaths);
 
-			// Get inclusive matrix to dag path
-			//
-			MDagPath dagPath = dagPaths[i];
-			MMatrix inclusiveMatrix = dagPath.inclusiveMatrix();
+	}
+	else
+	{
 
-			MMatrix objectWorldMatrix = objectMatrix * inclusiveMatrix;
-			MMatrix objectWorldInverseMatrix = objectWorldMatrix.inverse();
+		return MS::kUnknownParameter;
 
-			// Assign matrices to elements
-			//
-			hObjectWorldMatrix.setMMatrix(objectWorldMatrix);
-			hObjectWorldInverseMatrix.setMMatrix(objectWorldInverseMatrix);
+	}
 
-			// Mark handles as clean
-			//
-			hObjectWorldMatrix.setClean();
-			hObjectWorldInverseMatrix.setClean();
+};
 
-		}
 
-		// Assign builders to data handles
-		//
-		objectWorldMatrixArrayHandle.set(objectWorldMatrixBuilder);
-		objectWorldInverseMatrixArrayHandle.set(objectWorldInverseMatrixBuilder);
+MStatus BoneGeometry::setObjectMatrices(MDataBlock& data, const MMatrix& objectMatrix, const MMatrix& objectInverseMatrix)
+/**
+Commits the object-matrix and its inverse to the supplied data block and marks both as clean.
+This is shared by compute() and the boneGeometry evaluator.
+
+@param data: Data block containing storage for the node's attributes.
+@param objectMatrix: The object-matrix.
+@param objectInverseMatrix: The inverse object-matrix.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	// Get output data handles
+	//
+	MDataHandle objectMatrixHandle = data.outputValue(BoneGeometry::objectMatrix, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MDataHandle objectInverseMatrixHandle = data.outputValue(BoneGeometry::objectInverseMatrix, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
 
-		// Mark data handles as clean
+	// Commit values to data handle
+	//
+	objectMatrixHandle.setMMatrix(objectMatrix);
+	objectInverseMatrixHandle.setMMatrix(objectInverseMatrix);
+
+	// Mark handles as clean
+	//
+	objectMatrixHandle.setClean();
+	objectInverseMatrixHandle.setClean();
+
+	// Mark data block as clean
+	//
+	status = data.setClean(BoneGeometry::objectMatrix);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = data.setClean(BoneGeometry::objectInverseMatrix);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	return MS::kSuccess;
+
+};
+
+
+MStatus BoneGeometry::setObjectWorldMatrices(MDataBlock& data, const MMatrix* objectWorldMatrices, const MMatrix* objectWorldInverseMatrices, const unsigned int numPaths)
+/**
+Commits the world-space object-matrices and their inverses, one element per dag path, to the supplied data block and marks them as clean.
+This is shared by compute() and the boneGeometry evaluator.
+
+@param data: Data block containing storage for the node's attributes.
+@param objectWorldMatrices: The object-matrix multiplied by the inclusive matrix of each path.
+@param objectWorldInverseMatrices: The inverse of each world-space object-matrix.
+@param numPaths: The number of dag paths.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	// Define data builders
+	//
+	MArrayDataHandle objectWorldMatrixArrayHandle = data.outputArrayValue(BoneGeometry::objectWorldMatrix, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MArrayDataBuilder objectWorldMatrixBuilder(&data, BoneGeometry::objectWorldMatrix, numPaths, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MArrayDataHandle objectWorldInverseMatrixArrayHandle = data.outputArrayValue(BoneGeometry::objectWorldInverseMatrix, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MArrayDataBuilder objectWorldInverseMatrixBuilder(&data, BoneGeometry::objectWorldInverseMatrix, numPaths, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	for (unsigned int i = 0; i < numPaths; i++)
+	{
+
+		// Create new data handles for elements
 		//
-		objectWorldMatrixArrayHandle.setAllClean();
-		objectWorldInverseMatrixArrayHandle.setAllClean();
+		MDataHandle hObjectWorldMatrix = objectWorldMatrixBuilder.addElement(i, &status);
+		MDataHandle hObjectWorldInverseMatrix = objectWorldInverseMatrixBuilder.addElement(i, &status);
 
-		// Mark data block as clean
+		// Assign matrices to elements
 		//
-		status = data.setClean(plug);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
+		hObjectWorldMatrix.setMMatrix(objectWorldMatrices[i]);
+		hObjectWorldInverseMatrix.setMMatrix(objectWorldInverseMatrices[i]);
 
-		return MS::kSuccess;
+		// Mark handles as clean
+		//
+		hObjectWorldMatrix.setClean();
+		hObjectWorldInverseMatrix.setClean();
 
 	}
-	else
-	{
 
-		return MS::kUnknownParameter;
+	// Assign builders to data handles
+	//
+	objectWorldMatrixArrayHandle.set(objectWorldMatrixBuilder);
+	objectWorldInverseMatrixArrayHandle.set(objectWorldInverseMatrixBuilder);
 
-	}
+	// Mark data handles as clean
+	//
+	objectWorldMatrixArrayHandle.setAllClean();
+	objectWorldInverseMatrixArrayHandle.setAllClean();
+
+	// Mark data block as clean
+	//
+	status = data.setClean(BoneGeometry::objectWorldMatrix);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = data.setClean(BoneGeometry::objectWorldInverseMatrix);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	return MS::kSuccess;
 
 };
 
@@ -239,6 +318,9 @@ During the evaluation graph execution each node gets a chance to reset its inter
 This code has to be thread safe, non-blocking and work only on data owned by the node.
 The timing of this callback is at the discretion of evaluation graph dependencies and individual evaluators. This means, it should be used purely to prepare this node for evaluation and no particular order should be assumed.
 This call will most likely happen from a worker thread.
+The draw-affecting attributes are walked once from a table built by initialize(), each dirty plug contributes its dirty groups.
+Shape and level of detail changes dirty the draw without a topology change, the groups are only used to tell them apart in the stats.
+Rather than calling into the renderer from this thread the node is queued, see BoneGeometryDirtyQueue.h.
 When using Evaluation Caching or VP2 Custom Caching, preEvaluation() is called as part of the evaluation process. This function is not called as part of the cache restore process because no evaluation takes place in that case.
 
 @param context: Context in which the evaluation is happening. This should be respected and only internal state information pertaining to it should be modified.
@@ -247,20 +329,64 @@ When using Evaluation Caching or VP2 Custom Caching, preEvaluation() is called a
 */
 {
 
+	BONE_GEOMETRY_PROFILE("preEvaluation", kColorE_L1, this->thisMObject());
+
 	MStatus status;
 
 	if (context.isNormal())
 	{
 
-		if (evaluationNode.dirtyPlugExists(BoneGeometry::width, &status) && status ||
-			evaluationNode.dirtyPlugExists(BoneGeometry::height, &status) && status ||
-			evaluationNode.dirtyPlugExists(BoneGeometry::length, &status) && status ||
-			evaluationNode.dirtyPlugExists(BoneGeometry::localPosition, &status) && status ||
-			evaluationNode.dirtyPlugExists(BoneGeometry::localRotate, &status) && status ||
-			evaluationNode.dirtyPlugExists(BoneGeometry::localScale, &status) && status)
+		// Collect dirty groups, stopping early once every group is dirty
+		//
+		const unsigned int allGroups = (1u << kNumDirtyGroups) - 1;
+		unsigned int dirtyGroups = kDirtyNone;
+
+		for (const DrawAttribute& drawAttribute : BoneGeometry::drawAttributes)
 		{
 
-			MHWRender::MRenderer::setGeometryDrawDirty(this->thisMObject(), true);
+			if ((dirtyGroups & drawAttribute.groups) == drawAttribute.groups)
+			{
+
+				continue;
+
+			}
+
+			if (evaluationNode.dirtyPlugExists(drawAttribute.attribute, &status) && status)
+			{
+
+				dirtyGroups |= drawAttribute.groups;
+
+				if (dirtyGroups == allGroups)
+				{
+
+					break;
+
+				}
+
+			}
+
+		}
+
+		// Record each dirty group, the counters are declared in the same order as the group bits
+		//
+		for (unsigned int i = 0; i < kNumDirtyGroups; i++)
+		{
+
+			if (dirtyGroups & (1u << i))
+			{
+
+				BoneGeometryStats::add(BoneGeometryStats::Counter(BoneGeometryStats::kShapeDirty + i));
+
+			}
+
+		}
+
+		// Queue the draw to be dirtied for any draw-affecting change
+		//
+		if (dirtyGroups != kDirtyNone)
+		{
+
+			BoneGeometryDirtyQueue::push(this);
 
 		}
 
@@ -324,6 +450,7 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 	bool isSideFins = fnAttribute.hasCategory(BoneGeometry::sideFinsCategory);
 	bool isFrontFin = fnAttribute.hasCategory(BoneGeometry::frontFinCategory);
 	bool isBackFin = fnAttribute.hasCategory(BoneGeometry::backFinCategory);
+	bool isLevelOfDetail = fnAttribute.hasCategory(BoneGeometry::levelOfDetailCategory);
 
 	if (isLocalPosition)
 	{
@@ -331,25 +458,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::localPosition)
 		{
 
-			handle.setMVector(this->data->localPosition);
+			handle.setMVector(this->data.localPosition);
 
 		}
 		else if (attribute == BoneGeometry::localPositionX)
 		{
 
-			handle.setMDistance(MDistance(this->data->localPosition.x, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localPosition.x, MDistance::kCentimeters));
 
 		}
 		else if (attribute == BoneGeometry::localPositionY)
 		{
 
-			handle.setMDistance(MDistance(this->data->localPosition.y, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localPosition.y, MDistance::kCentimeters));
 
 		}
 		else if (attribute == BoneGeometry::localPositionZ)
 		{
 
-			handle.setMDistance(MDistance(this->data->localPosition.z, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localPosition.z, MDistance::kCentimeters));
 
 		}
 		else;
@@ -363,25 +490,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::localRotate)
 		{
 
-			handle.setMVector(this->data->localRotate);
+			handle.setMVector(this->data.localRotate);
 
 		}
 		else if (attribute == BoneGeometry::localRotateX)
 		{
 
-			handle.setMAngle(MAngle(this->data->localRotate.x, MAngle::kRadians));
+			handle.setMAngle(MAngle(this->data.localRotate.x, MAngle::kRadians));
 
 		}
 		else if (attribute == BoneGeometry::localRotateY)
 		{
 
-			handle.setMAngle(MAngle(this->data->localRotate.y, MAngle::kRadians));
+			handle.setMAngle(MAngle(this->data.localRotate.y, MAngle::kRadians));
 
 		}
 		else if (attribute == BoneGeometry::localRotateZ)
 		{
 
-			handle.setMAngle(MAngle(this->data->localRotate.z, MAngle::kRadians));
+			handle.setMAngle(MAngle(this->data.localRotate.z, MAngle::kRadians));
 
 		}
 		else;
@@ -395,25 +522,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::localScale)
 		{
 
-			handle.setMVector(this->data->localScale);
+			handle.setMVector(this->data.localScale);
 
 		}
 		else if (attribute == BoneGeometry::localScaleX)
 		{
 
-			handle.setMDistance(MDistance(this->data->localScale.x, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localScale.x, MDistance::kCentimeters));
 
 		}
 		else if (attribute == BoneGeometry::localScaleY)
 		{
 
-			handle.setMDistance(MDistance(this->data->localScale.y, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localScale.y, MDistance::kCentimeters));
 
 		}
 		else if (attribute == BoneGeometry::localScaleZ)
 		{
 
-			handle.setMDistance(MDistance(this->data->localScale.z, MDistance::kCentimeters));
+			handle.setMDistance(MDistance(this->data.localScale.z, MDistance::kCentimeters));
 
 		}
 		else;
@@ -427,25 +554,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::length)
 		{
 
-			handle.setDouble(this->data->length);
+			handle.setDouble(this->data.length);
 
 		}
 		else if (attribute == BoneGeometry::width)
 		{
 
-			handle.setDouble(this->data->width);
+			handle.setDouble(this->data.width);
 
 		}
 		else if (attribute == BoneGeometry::height)
 		{
 
-			handle.setDouble(this->data->height);
+			handle.setDouble(this->data.height);
 
 		}
 		else if (attribute == BoneGeometry::taper)
 		{
 
-			handle.setDouble(this->data->taper);
+			handle.setDouble(this->data.taper);
 
 		}
 		else;
@@ -459,25 +586,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::sideFins)
 		{
 
-			handle.setBool(this->data->sideFins);
+			handle.setBool(this->data.sideFins);
 
 		}
 		else if (attribute == BoneGeometry::sideFinsSize)
 		{
 
-			handle.setDouble(this->data->sideFinsSize);
+			handle.setDouble(this->data.sideFinsSize);
 
 		}
 		else if (attribute == BoneGeometry::sideFinsStartTaper)
 		{
 
-			handle.setDouble(this->data->sideFinsStartTaper);
+			handle.setDouble(this->data.sideFinsStartTaper);
 
 		}
 		else if (attribute == BoneGeometry::sideFinsEndTaper)
 		{
 
-			handle.setDouble(this->data->sideFinsEndTaper);
+			handle.setDouble(this->data.sideFinsEndTaper);
 
 		}
 		else;
@@ -491,25 +618,25 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::frontFin)
 		{
 
-			handle.setBool(this->data->frontFin);
+			handle.setBool(this->data.frontFin);
 
 		}
 		else if (attribute == BoneGeometry::frontFinSize)
 		{
 
-			handle.setDouble(this->data->frontFinSize);
+			handle.setDouble(this->data.frontFinSize);
 
 		}
 		else if (attribute == BoneGeometry::frontFinStartTaper)
 		{
 
-			handle.setDouble(this->data->frontFinStartTaper);
+			handle.setDouble(this->data.frontFinStartTaper);
 
 		}
 		else if (attribute == BoneGeometry::frontFinEndTaper)
 		{
 
-			handle.setDouble(this->data->frontFinEndTaper);
+			handle.setDouble(this->data.frontFinEndTaper);
 
 		}
 		else;
@@ -523,25 +650,57 @@ When internal attribute values are queried via getAttr or MPlug::getValue this m
 		if (attribute == BoneGeometry::backFin)
 		{
 
-			handle.setBool(this->data->backFin);
+			handle.setBool(this->data.backFin);
 
 		}
 		else if (attribute == BoneGeometry::backFinSize)
 		{
 
-			handle.setDouble(this->data->backFinSize);
+			handle.setDouble(this->data.backFinSize);
 
 		}
 		else if (attribute == BoneGeometry::backFinStartTaper)
 		{
 
-			handle.setDouble(this->data->backFinStartTaper);
+			handle.setDouble(this->data.backFinStartTaper);
 
 		}
 		else if (attribute == BoneGeometry::backFinEndTaper)
 		{
 
-			handle.setDouble(this->data->backFinEndTaper);
+			handle.setDouble(this->data.backFinEndTaper);
+
+		}
+		else;
+
+		return true;
+
+	}
+	else if (isLevelOfDetail)
+	{
+
+		if (attribute == BoneGeometry::levelOfDetail)
+		{
+
+			handle.setBool(this->data.levelOfDetail);
+
+		}
+		else if (attribute == BoneGeometry::wireThreshold)
+		{
+
+			handle.setDouble(this->data.wireThreshold);
+
+		}
+		else if (attribute == BoneGeometry::lineThreshold)
+		{
+
+			handle.setDouble(this->data.lineThreshold);
+
+		}
+		else if (attribute == BoneGeometry::hideThreshold)
+		{
+
+			handle.setDouble(this->data.hideThreshold);
 
 		}
 		else;
@@ -586,6 +745,7 @@ Another use for this method is to impose attribute limits.
 	bool isSideFins = fnAttribute.hasCategory(BoneGeometry::sideFinsCategory);
 	bool isFrontFin = fnAttribute.hasCategory(BoneGeometry::frontFinCategory);
 	bool isBackFin = fnAttribute.hasCategory(BoneGeometry::backFinCategory);
+	bool isLevelOfDetail = fnAttribute.hasCategory(BoneGeometry::levelOfDetailCategory);
 	
 	if (isLocalPosition)
 	{
@@ -593,30 +753,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::localPosition)
 		{
 
-			this->data->localPosition = handle.asVector();
+			this->data.localPosition = handle.asVector();
 
 		}
 		else if (attribute == BoneGeometry::localPositionX)
 		{
 
-			this->data->localPosition.x = handle.asDistance().asCentimeters();
+			this->data.localPosition.x = handle.asDistance().asCentimeters();
 
 		}
 		else if (attribute == BoneGeometry::localPositionY)
 		{
 
-			this->data->localPosition.y = handle.asDistance().asCentimeters();
+			this->data.localPosition.y = handle.asDistance().asCentimeters();
 
 		}
 		else if (attribute == BoneGeometry::localPositionZ)
 		{
 
-			this->data->localPosition.z = handle.asDistance().asCentimeters();
+			this->data.localPosition.z = handle.asDistance().asCentimeters();
 
 		}
 		else;
 
-		this->data->dirtyObjectMatrix();
+		this->data.dirtyObjectMatrix();
 		return true;
 
 	}
@@ -626,30 +786,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::localRotate)
 		{
 
-			this->data->localRotate = handle.asVector();
+			this->data.localRotate = handle.asVector();
 
 		}
 		else if (attribute == BoneGeometry::localRotateX)
 		{
 
-			this->data->localRotate.x = handle.asAngle().asRadians();
+			this->data.localRotate.x = handle.asAngle().asRadians();
 
 		}
 		else if (attribute == BoneGeometry::localRotateY)
 		{
 
-			this->data->localRotate.y = handle.asAngle().asRadians();
+			this->data.localRotate.y = handle.asAngle().asRadians();
 
 		}
 		else if (attribute == BoneGeometry::localRotateZ)
 		{
 
-			this->data->localRotate.z = handle.asAngle().asRadians();
+			this->data.localRotate.z = handle.asAngle().asRadians();
 
 		}
 		else;
 
-		this->data->dirtyObjectMatrix();
+		this->data.dirtyObjectMatrix();
 		return true;
 
 	}
@@ -659,30 +819,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::localScale)
 		{
 
-			this->data->localScale = handle.asVector();
+			this->data.localScale = handle.asVector();
 
 		}
 		else if (attribute == BoneGeometry::localScaleX)
 		{
 
-			this->data->localScale.x = handle.asDistance().asCentimeters();
+			this->data.localScale.x = handle.asDistance().asCentimeters();
 
 		}
 		else if (attribute == BoneGeometry::localScaleY)
 		{
 
-			this->data->localScale.y = handle.asDistance().asCentimeters();
+			this->data.localScale.y = handle.asDistance().asCentimeters();
 
 		}
 		else if (attribute == BoneGeometry::localScaleZ)
 		{
 
-			this->data->localScale.z = handle.asDistance().asCentimeters();
+			this->data.localScale.z = handle.asDistance().asCentimeters();
 
 		}
 		else;
 
-		this->data->dirtyObjectMatrix();
+		this->data.dirtyObjectMatrix();
 		return true;
 
 	}
@@ -692,29 +852,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::length)
 		{
 
-			this->data->length = handle.asDouble();
+			this->data.length = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::width)
 		{
 
-			this->data->width = handle.asDouble();
+			this->data.width = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::height)
 		{
 
-			this->data->height = handle.asDouble();
+			this->data.height = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::taper)
 		{
 
-			this->data->taper = handle.asDouble();
+			this->data.taper = handle.asDouble();
 
 		}
 		else;
 
+		this->data.dirtyBoundingBox();
 		return true;
 
 	}
@@ -724,29 +885,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::sideFins)
 		{
 
-			this->data->sideFins = handle.asBool();
+			this->data.sideFins = handle.asBool();
 
 		}
 		else if (attribute == BoneGeometry::sideFinsSize)
 		{
 
-			this->data->sideFinsSize = handle.asDouble();
+			this->data.sideFinsSize = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::sideFinsStartTaper)
 		{
 
-			this->data->sideFinsStartTaper = handle.asDouble();
+			this->data.sideFinsStartTaper = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::sideFinsEndTaper)
 		{
 
-			this->data->sideFinsEndTaper = handle.asDouble();
+			this->data.sideFinsEndTaper = handle.asDouble();
 
 		}
 		else;
 
+		this->data.dirtyBoundingBox();
 		return true;
 
 	}
@@ -756,29 +918,30 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::frontFin)
 		{
 
-			this->data->frontFin = handle.asBool();
+			this->data.frontFin = handle.asBool();
 
 		}
 		else if (attribute == BoneGeometry::frontFinSize)
 		{
 
-			this->data->frontFinSize = handle.asDouble();
+			this->data.frontFinSize = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::frontFinStartTaper)
 		{
 
-			this->data->frontFinStartTaper = handle.asDouble();
+			this->data.frontFinStartTaper = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::frontFinEndTaper)
 		{
 
-			this->data->frontFinEndTaper = handle.asDouble();
+			this->data.frontFinEndTaper = handle.asDouble();
 
 		}
 		else;
 
+		this->data.dirtyBoundingBox();
 		return true;
 
 	}
@@ -788,25 +951,59 @@ Another use for this method is to impose attribute limits.
 		if (attribute == BoneGeometry::backFin)
 		{
 
-			this->data->backFin = handle.asBool();
+			this->data.backFin = handle.asBool();
 
 		}
 		else if (attribute == BoneGeometry::backFinSize)
 		{
 
-			this->data->backFinSize = handle.asDouble();
+			this->data.backFinSize = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::backFinStartTaper)
 		{
 
-			this->data->backFinStartTaper = handle.asDouble();
+			this->data.backFinStartTaper = handle.asDouble();
 
 		}
 		else if (attribute == BoneGeometry::backFinEndTaper)
 		{
 
-			this->data->backFinEndTaper = handle.asDouble();
+			this->data.backFinEndTaper = handle.asDouble();
+
+		}
+		else;
+
+		this->data.dirtyBoundingBox();
+		return true;
+
+	}
+	else if (isLevelOfDetail)
+	{
+
+		if (attribute == BoneGeometry::levelOfDetail)
+		{
+
+			this->data.levelOfDetail = handle.asBool();
+			BoneGeometryCameraWatch::watch(this, this->data.levelOfDetail);
+
+		}
+		else if (attribute == BoneGeometry::wireThreshold)
+		{
+
+			this->data.wireThreshold = handle.asDouble();
+
+		}
+		else if (attribute == BoneGeometry::lineThreshold)
+		{
+
+			this->data.lineThreshold = handle.asDouble();
+
+		}
+		else if (attribute == BoneGeometry::hideThreshold)
+		{
+
+			this->data.hideThreshold = handle.asDouble();
 
 		}
 		else;
@@ -826,6 +1023,7 @@ void BoneGeometry::copyInternalData(MPxNode* node)
 This method is overridden by nodes that store attribute data in some internal format.
 On duplication this method is called on the duplicated node with the node being duplicated passed as the parameter.
 Overriding this method gives your node a chance to duplicate any internal data you've been storing and manipulating outside of normal attribute data.
+The data is copied by value, see BoneGeometryData::operator=(), which bumps the revision so any draw override already attached to this node rebuilds.
 
 @param node: The node that is being duplicated.
 @return: Void.
@@ -833,7 +1031,9 @@ Overriding this method gives your node a chance to duplicate any internal data y
 {
 
 	BoneGeometry* boneGeometry = static_cast<BoneGeometry*>(node);
-	this->data = boneGeometry->getUserData();
+
+	this->data = boneGeometry->data;
+	BoneGeometryCameraWatch::watch(this, this->data.levelOfDetail);
 
 };
 
@@ -841,12 +1041,13 @@ Overriding this method gives your node a chance to duplicate any internal data y
 BoneGeometryData* BoneGeometry::getUserData()
 /**
 Returns a pointer to the internal bone geometry data.
+The data is owned by this node and remains valid for its lifetime.
 
 @return: The bone geometry data pointer.
 */
 {
 
-	return this->data;
+	return &this->data;
 
 };
 
@@ -869,18 +1070,13 @@ MBoundingBox BoneGeometry::boundingBox() const
 /**
 This function is used to calculate a bounding box based on the object transform.
 Supplying a bounding box will make selection calculation more efficient!
+The box is cached by the internal data and only updated when the drawn shape changes.
 
 @return: MBoundingBox
 */
 {
 
-	MPoint corner1 = MPoint(0.0, -this->data->height * 0.5, -this->data->width * 0.5);  // x = length, y = height, z = width
-	MPoint corner2 = MPoint(this->data->length, this->data->height * 0.5, this->data->width * 0.5);  // x = length, y = height, z = width
-
-	MBoundingBox boundingBox = MBoundingBox(corner1, corner2);
-	boundingBox.transformUsing(this->data->objectMatrix);
-
-	return boundingBox;
+	return this->data.boundingBox;
 
 };
 
@@ -1159,6 +1355,44 @@ Use this function to define any static attributes.
 	CHECK_MSTATUS(fnNumericAttr.setInternal(true));
 	CHECK_MSTATUS(fnNumericAttr.addToCategory(BoneGeometry::backFinCategory));
 
+	// ".levelOfDetail" attribute
+	//
+	BoneGeometry::levelOfDetail = fnNumericAttr.create("levelOfDetail", "lod", MFnNumericData::kBoolean, false, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	CHECK_MSTATUS(fnNumericAttr.setInternal(true));
+	CHECK_MSTATUS(fnNumericAttr.addToCategory(BoneGeometry::levelOfDetailCategory));
+
+	// ".wireThreshold" attribute
+	//
+	BoneGeometry::wireThreshold = fnNumericAttr.create("wireThreshold", "wth", MFnNumericData::kDouble, 16.0, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	CHECK_MSTATUS(fnNumericAttr.setMin(0.0));
+	CHECK_MSTATUS(fnNumericAttr.setSoftMax(100.0));
+	CHECK_MSTATUS(fnNumericAttr.setInternal(true));
+	CHECK_MSTATUS(fnNumericAttr.addToCategory(BoneGeometry::levelOfDetailCategory));
+
+	// ".lineThreshold" attribute
+	//
+	BoneGeometry::lineThreshold = fnNumericAttr.create("lineThreshold", "lth", MFnNumericData::kDouble, 4.0, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	CHECK_MSTATUS(fnNumericAttr.setMin(0.0));
+	CHECK_MSTATUS(fnNumericAttr.setSoftMax(100.0));
+	CHECK_MSTATUS(fnNumericAttr.setInternal(true));
+	CHECK_MSTATUS(fnNumericAttr.addToCategory(BoneGeometry::levelOfDetailCategory));
+
+	// ".hideThreshold" attribute
+	//
+	BoneGeometry::hideThreshold = fnNumericAttr.create("hideThreshold", "hth", MFnNumericData::kDouble, 1.0, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	CHECK_MSTATUS(fnNumericAttr.setMin(0.0));
+	CHECK_MSTATUS(fnNumericAttr.setSoftMax(100.0));
+	CHECK_MSTATUS(fnNumericAttr.setInternal(true));
+	CHECK_MSTATUS(fnNumericAttr.addToCategory(BoneGeometry::levelOfDetailCategory));
+
 	// Output attributes:
 	// Define ".objectMatrix" attribute
 	//
@@ -1221,6 +1455,10 @@ Use this function to define any static attributes.
 	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::backFinSize));
 	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::backFinStartTaper));
 	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::backFinEndTaper));
+	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::levelOfDetail));
+	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::wireThreshold));
+	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::lineThreshold));
+	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::hideThreshold));
 
 	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::objectMatrix));
 	CHECK_MSTATUS(BoneGeometry::addAttribute(BoneGeometry::objectInverseMatrix));
@@ -1245,6 +1483,23 @@ Use this function to define any static attributes.
 	CHECK_MSTATUS(BoneGeometry::attributeAffects(BoneGeometry::localRotate, BoneGeometry::objectWorldInverseMatrix));
 	CHECK_MSTATUS(BoneGeometry::attributeAffects(BoneGeometry::localScale, BoneGeometry::objectWorldInverseMatrix));
 
+	// Define draw-affecting attributes for preEvaluation()
+	// The draw ignores the object-matrix and fins are not drawn yet, so neither the local transform nor the fin attributes are listed
+	//
+	BoneGeometry::drawAttributes =
+	{
+
+		{ BoneGeometry::width, kDirtyShape },
+		{ BoneGeometry::height, kDirtyShape },
+		{ BoneGeometry::length, kDirtyShape },
+		{ BoneGeometry::taper, kDirtyShape },
+		{ BoneGeometry::levelOfDetail, kDirtyLevelOfDetail },
+		{ BoneGeometry::wireThreshold, kDirtyLevelOfDetail },
+		{ BoneGeometry::lineThreshold, kDirtyLevelOfDetail },
+		{ BoneGeometry::hideThreshold, kDirtyLevelOfDetail }
+
+	};
+
 	return status;
 
 };
\ No newline at end of file
@@ -9,6 +9,12 @@
 //
 
 #include "BoneGeometryData.h"
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryCameraWatch.h"
+#include "BoneGeometryDirtyQueue.h"
+#include "BoneGeometryProfiler.h"
+#include "BoneGeometryStats.h"
+#include "BoneGeometryTrace.h"
 
 #include <maya/MPxLocatorNode.h>
 #include <maya/MPlug.h>
@@ -57,6 +63,7 @@
 #include <maya/MTypeId.h>
 
 #include <assert.h>
+#include <vector>
 
 
 class BoneGeometry : public MPxLocatorNode
@@ -64,6 +71,24 @@ class BoneGeometry : public MPxLocatorNode
 
 public:
 
+	enum DirtyGroup : unsigned int
+	{
+
+		kDirtyNone = 0,
+		kDirtyShape = 1 << 0,
+		kDirtyLevelOfDetail = 1 << 1,
+		kNumDirtyGroups = 2
+
+	};
+
+	struct DrawAttribute
+	{
+
+		MObject			attribute;
+		unsigned int	groups;
+
+	};
+
 								BoneGeometry();
 	virtual						~BoneGeometry();
 
@@ -81,6 +106,9 @@ public:
 	virtual	bool				isBounded() const;
 	virtual	MBoundingBox		boundingBox() const;
 
+	static	MStatus				setObjectMatrices(MDataBlock& data, const MMatrix& objectMatrix, const MMatrix& objectInverseMatrix);
+	static	MStatus				setObjectWorldMatrices(MDataBlock& data, const MMatrix* objectWorldMatrices, const MMatrix* objectWorldInverseMatrices, const unsigned int numPaths);
+
 	static  void*				creator();
 	static  MStatus				initialize();
 
@@ -107,6 +135,10 @@ public:
 	static	MObject				backFinSize;
 	static	MObject				backFinStartTaper;
 	static	MObject				backFinEndTaper;
+	static	MObject				levelOfDetail;
+	static	MObject				wireThreshold;
+	static	MObject				lineThreshold;
+	static	MObject				hideThreshold;
 
 	static  MObject				objectMatrix;
 	static	MObject				objectInverseMatrix;
@@ -120,14 +152,20 @@ public:
 	static	MString				sideFinsCategory;
 	static	MString				frontFinCategory;
 	static	MString				backFinCategory;
+	static	MString				levelOfDetailCategory;
+
+	static	std::vector<DrawAttribute>	drawAttributes;
 
 	static	MString				drawDbClassification;
 	static	MString				drawRegistrantId;
 	static	MTypeId				id;
 
+			BoneGeometryStats::NodeCounters	stats;
+			BoneGeometryDirtyQueue::Link	dirtyLink;
+
 protected:
 
-			BoneGeometryData*	data;
+			BoneGeometryData	data;
 
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,364 @@
+//
+// File: BoneGeometryAllocations.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryAllocations.h"
+#include "BoneGeometryTrace.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+namespace
+{
+
+	const size_t	HISTORY_CAPACITY = 256;
+
+	struct ThreadCounters
+	{
+
+		std::atomic<uint64_t>	allocations[BoneGeometryAllocations::kNumPhases] = {};
+		std::atomic<uint64_t>	bytes[BoneGeometryAllocations::kNumPhases] = {};
+
+	};
+
+	std::mutex										threadsMutex;
+	std::vector<std::unique_ptr<ThreadCounters>>	threads;
+	std::atomic<bool>								enabled(false);
+
+	BoneGeometryAllocations::Frame					baseline = {};
+	BoneGeometryAllocations::Frame					previous = {};
+	BoneGeometryAllocations::Frame					history[HISTORY_CAPACITY] = {};
+	uint64_t										frameCount = 0;
+
+	const char* phaseNames[BoneGeometryAllocations::kNumPhases] =
+	{
+
+		"userData",
+		"points",
+		"geometry",
+		"meshData",
+		"batchInstances",
+		"batchBuffers",
+		"scratch"
+
+	};
+
+	ThreadCounters& localCounters()
+	/**
+	Returns the counter block owned by the calling thread, registering it on first use.
+
+	@return: ThreadCounters
+	*/
+	{
+
+		thread_local ThreadCounters* counters = nullptr;
+
+		if (counters == nullptr)
+		{
+
+			std::lock_guard<std::mutex> lock(threadsMutex);
+
+			threads.emplace_back(new ThreadCounters());
+			counters = threads.back().get();
+
+		}
+
+		return *counters;
+
+	};
+
+	void sumThreads(BoneGeometryAllocations::Frame& totals)
+	/**
+	Sums every thread's counters into the passed frame.
+	The caller must hold the threads mutex.
+
+	@param totals: The passed frame to populate.
+	@return: Void.
+	*/
+	{
+
+		for (unsigned int i = 0; i < BoneGeometryAllocations::kNumPhases; i++)
+		{
+
+			totals.allocations[i] = 0;
+			totals.bytes[i] = 0;
+
+		}
+
+		for (const std::unique_ptr<ThreadCounters>& thread : threads)
+		{
+
+			for (unsigned int i = 0; i < BoneGeometryAllocations::kNumPhases; i++)
+			{
+
+				totals.allocations[i] += thread->allocations[i].load(std::memory_order_relaxed);
+				totals.bytes[i] += thread->bytes[i].load(std::memory_order_relaxed);
+
+			}
+
+		}
+
+	};
+
+};
+
+
+uint64_t BoneGeometryAllocations::Frame::totalAllocations() const
+/**
+Returns the number of allocations across every phase.
+
+@return: uint64_t
+*/
+{
+
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < kNumPhases; i++)
+	{
+
+		total += this->allocations[i];
+
+	}
+
+	return total;
+
+};
+
+
+uint64_t BoneGeometryAllocations::Frame::totalBytes() const
+/**
+Returns the number of bytes allocated across every phase.
+
+@return: uint64_t
+*/
+{
+
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < kNumPhases; i++)
+	{
+
+		total += this->bytes[i];
+
+	}
+
+	return total;
+
+};
+
+
+void BoneGeometryAllocations::setEnabled(const bool enable)
+/**
+Enables or disables accounting.
+Enabling starts a fresh frame so allocations made while disabled are never attributed to it.
+
+@param enable: If true allocations are recorded.
+@return: Void.
+*/
+{
+
+	if (enable && !enabled.load(std::memory_order_relaxed))
+	{
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		sumThreads(previous);
+
+	}
+
+	enabled.store(enable, std::memory_order_relaxed);
+
+};
+
+
+bool BoneGeometryAllocations::isEnabled()
+/**
+Evaluates if allocations are being recorded.
+
+@return: bool
+*/
+{
+
+	return enabled.load(std::memory_order_relaxed);
+
+};
+
+
+void BoneGeometryAllocations::record(const Phase phase, const size_t bytes, const uint64_t count)
+/**
+Records allocations made by the supplied phase if accounting is enabled.
+Each block has a single writer so a relaxed load and store is enough.
+
+@param phase: The phase that allocated.
+@param bytes: The total number of bytes allocated.
+@param count: The number of allocations.
+@return: Void.
+*/
+{
+
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+
+		return;
+
+	}
+
+	ThreadCounters& counters = localCounters();
+
+	counters.allocations[phase].store(counters.allocations[phase].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+	counters.bytes[phase].store(counters.bytes[phase].load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+
+};
+
+
+void BoneGeometryAllocations::endFrame()
+/**
+Closes the current frame by storing the allocations made since the previous one in the history.
+When tracing is enabled each phase is also written to the trace log as a counter event.
+
+@return: Void.
+*/
+{
+
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+
+		return;
+
+	}
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	Frame totals;
+	sumThreads(totals);
+
+	Frame& frame = history[frameCount % HISTORY_CAPACITY];
+	frame.index = frameCount++;
+
+	for (unsigned int i = 0; i < kNumPhases; i++)
+	{
+
+		frame.allocations[i] = totals.allocations[i] - previous.allocations[i];
+		frame.bytes[i] = totals.bytes[i] - previous.bytes[i];
+
+	}
+
+	previous = totals;
+
+	// Counter events are drawn as stacked tracks above the timeline
+	//
+	if (BoneGeometryTrace::isEnabled())
+	{
+
+		for (unsigned int i = 0; i < kNumPhases; i++)
+		{
+
+			std::string name = std::string("allocations.") + phaseNames[i];
+			BoneGeometryTrace::recordCounter(name.c_str(), static_cast<int64_t>(frame.allocations[i]));
+
+		}
+
+		BoneGeometryTrace::recordCounter("allocatedBytes", static_cast<int64_t>(frame.totalBytes()));
+
+	}
+
+};
+
+
+void BoneGeometryAllocations::reset()
+/**
+Discards the frame history and restarts the totals from zero.
+
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	sumThreads(baseline);
+	previous = baseline;
+	frameCount = 0;
+
+};
+
+
+size_t BoneGeometryAllocations::historyCapacity()
+/**
+Returns the maximum number of frames kept in the history.
+
+@return: size_t
+*/
+{
+
+	return HISTORY_CAPACITY;
+
+};
+
+
+void BoneGeometryAllocations::getHistory(std::vector<Frame>& frames)
+/**
+Copies the frame history, oldest first, into the passed vector.
+
+@param frames: The passed vector to populate.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	uint64_t first = (frameCount > HISTORY_CAPACITY) ? frameCount - HISTORY_CAPACITY : 0;
+
+	frames.clear();
+	frames.reserve(static_cast<size_t>(frameCount - first));
+
+	for (uint64_t index = first; index < frameCount; index++)
+	{
+
+		frames.push_back(history[index % HISTORY_CAPACITY]);
+
+	}
+
+};
+
+
+void BoneGeometryAllocations::getTotals(Frame& totals)
+/**
+Populates the passed frame with every allocation recorded since the last reset.
+The frame index is set to the number of frames closed since the last reset.
+
+@param totals: The passed frame to populate.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	sumThreads(totals);
+	totals.index = frameCount;
+
+	for (unsigned int i = 0; i < kNumPhases; i++)
+	{
+
+		totals.allocations[i] -= baseline.allocations[i];
+		totals.bytes[i] -= baseline.bytes[i];
+
+	}
+
+};
+
+
+const char* BoneGeometryAllocations::phaseName(const Phase phase)
+/**
+Returns the name of the supplied phase.
+
+@param phase: The phase.
+@return: const char*
+*/
+{
+
+	return (phase < kNumPhases) ? phaseNames[phase] : "";
+
+};
\ No newline at end of file
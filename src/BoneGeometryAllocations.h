@@ -0,0 +1,62 @@
+#ifndef _BONE_GEOMETRY_ALLOCATIONS
+#define _BONE_GEOMETRY_ALLOCATIONS
+//
+// File: BoneGeometryAllocations.h
+//
+// Maya-free, opt-in accounting of the buffers and temporary arrays allocated by the draw path.
+// Allocations are counted per phase into per-thread blocks, the same single-writer layout as BoneGeometryStats, so parallel prepareForDraw calls never contend on the counters.
+// Each viewport refresh closes a frame, the per-frame deltas are kept in a short history and written to the trace log as counter events.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace BoneGeometryAllocations
+{
+
+	enum Phase : unsigned int
+	{
+
+		kUserData = 0,
+		kPoints,
+		kGeometry,
+		kMeshData,
+		kBatchInstances,
+		kBatchBuffers,
+		kScratch,
+		kNumPhases
+
+	};
+
+	struct Frame
+	{
+
+		uint64_t	index;
+		uint64_t	allocations[kNumPhases];
+		uint64_t	bytes[kNumPhases];
+
+		uint64_t	totalAllocations() const;
+		uint64_t	totalBytes() const;
+
+	};
+
+	void		setEnabled(const bool enable);
+	bool		isEnabled();
+
+	void		record(const Phase phase, const size_t bytes, const uint64_t count = 1);
+	void		endFrame();
+	void		reset();
+
+	size_t		historyCapacity();
+	void		getHistory(std::vector<Frame>& frames);
+	void		getTotals(Frame& totals);
+
+	const char*	phaseName(const Phase phase);
+
+};
+#endif
\ No newline at end of file
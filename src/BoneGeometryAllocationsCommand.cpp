@@ -0,0 +1,395 @@
+//
+// File: BoneGeometryAllocationsCommand.cpp
+//
+// Command: boneGeometryAllocations
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryAllocationsCommand.h"
+
+#include <algorithm>
+#include <sstream>
+
+MString	BoneGeometryAllocationsCommand::commandName("boneGeometryAllocations");
+MString	BoneGeometryAllocationsCommand::optionVarName("boneGeometryAllocations");
+
+static const char* enableFlag = "-e";
+static const char* enableLongFlag = "-enable";
+static const char* framesFlag = "-f";
+static const char* framesLongFlag = "-frames";
+static const char* jsonFlag = "-js";
+static const char* jsonLongFlag = "-json";
+static const char* resetFlag = "-r";
+static const char* resetLongFlag = "-reset";
+
+static const char* notificationName = "boneGeometryAllocationsEndFrame";
+
+
+namespace
+{
+
+	size_t countAllocationFree(const std::vector<BoneGeometryAllocations::Frame>& frames)
+	/**
+	Returns the number of supplied frames that made no allocations at all.
+
+	@param frames: The frames to check.
+	@return: size_t
+	*/
+	{
+
+		return static_cast<size_t>(std::count_if(frames.begin(), frames.end(), [](const BoneGeometryAllocations::Frame& frame) { return frame.totalAllocations() == 0; }));
+
+	};
+
+};
+
+
+BoneGeometryAllocationsCommand::BoneGeometryAllocationsCommand() {};
+BoneGeometryAllocationsCommand::~BoneGeometryAllocationsCommand() {};
+
+
+MStatus BoneGeometryAllocationsCommand::doIt(const MArgList& args)
+/**
+Edits or reports the allocation accounting.
+In query mode -enable returns whether accounting is on.
+Otherwise -enable toggles accounting and the most recent frames, all of the history or the number passed to -frames, are reported.
+With -reset the history is discarded once it has been reported.
+
+@param args: The command arguments.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	MArgDatabase argDatabase(this->syntax(), args, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Check if this is a query
+	//
+	if (argDatabase.isQuery())
+	{
+
+		MPxCommand::setResult(BoneGeometryAllocations::isEnabled());
+		return MS::kSuccess;
+
+	}
+
+	// Toggle accounting
+	//
+	if (argDatabase.isFlagSet(enableFlag))
+	{
+
+		bool enable = false;
+
+		status = argDatabase.getFlagArgument(enableFlag, 0, enable);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		BoneGeometryAllocations::setEnabled(enable);
+
+	}
+
+	// Collect the requested frames
+	//
+	std::vector<BoneGeometryAllocations::Frame> frames;
+	BoneGeometryAllocations::getHistory(frames);
+
+	if (argDatabase.isFlagSet(framesFlag))
+	{
+
+		int numFrames = 0;
+
+		status = argDatabase.getFlagArgument(framesFlag, 0, numFrames);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		if (numFrames < 0)
+		{
+
+			this->displayError("-frames expects a non-negative number!");
+			return MS::kInvalidParameter;
+
+		}
+
+		if (static_cast<size_t>(numFrames) < frames.size())
+		{
+
+			frames.erase(frames.begin(), frames.end() - numFrames);
+
+		}
+
+	}
+
+	// Report frames
+	//
+	if (argDatabase.isFlagSet(jsonFlag))
+	{
+
+		MPxCommand::setResult(MString(BoneGeometryAllocationsCommand::toJson(frames).c_str()));
+
+	}
+	else
+	{
+
+		MPxCommand::setResult(BoneGeometryAllocationsCommand::toStringArray(frames));
+
+	}
+
+	// Reset history if requested
+	//
+	if (argDatabase.isFlagSet(resetFlag))
+	{
+
+		BoneGeometryAllocations::reset();
+
+	}
+
+	return MS::kSuccess;
+
+};
+
+
+std::string BoneGeometryAllocationsCommand::toJson(const std::vector<BoneGeometryAllocations::Frame>& frames)
+/**
+Formats the totals since the last reset and the supplied frames, oldest first, as a JSON object.
+
+@param frames: The frames to report.
+@return: std::string
+*/
+{
+
+	BoneGeometryAllocations::Frame totals;
+	BoneGeometryAllocations::getTotals(totals);
+
+	std::ostringstream stream;
+	stream << "{\"enabled\": " << (BoneGeometryAllocations::isEnabled() ? "true" : "false") << ", ";
+	stream << "\"frameCount\": " << totals.index << ", ";
+	stream << "\"allocationFreeFrames\": " << countAllocationFree(frames) << ", ";
+	stream << "\"totals\": {";
+
+	for (unsigned int i = 0; i < BoneGeometryAllocations::kNumPhases; i++)
+	{
+
+		stream << (i > 0 ? ", " : "") << "\"" << BoneGeometryAllocations::phaseName(BoneGeometryAllocations::Phase(i)) << "\": {\"allocations\": " << totals.allocations[i] << ", \"bytes\": " << totals.bytes[i] << "}";
+
+	}
+
+	stream << "}, \"frames\": [";
+
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+
+		const BoneGeometryAllocations::Frame& frame = frames[i];
+
+		stream << (i > 0 ? ", " : "") << "{\"frame\": " << frame.index << ", \"allocations\": {";
+
+		for (unsigned int j = 0; j < BoneGeometryAllocations::kNumPhases; j++)
+		{
+
+			stream << (j > 0 ? ", " : "") << "\"" << BoneGeometryAllocations::phaseName(BoneGeometryAllocations::Phase(j)) << "\": " << frame.allocations[j];
+
+		}
+
+		stream << "}, \"bytes\": " << frame.totalBytes() << "}";
+
+	}
+
+	stream << "]}";
+
+	return stream.str();
+
+};
+
+
+MStringArray BoneGeometryAllocationsCommand::toStringArray(const std::vector<BoneGeometryAllocations::Frame>& frames)
+/**
+Formats the supplied frames as "name=value" strings.
+Each phase reports the mean allocations and bytes per frame, the peak frame is reported alongside the number of allocation-free frames.
+
+@param frames: The frames to report.
+@return: MStringArray
+*/
+{
+
+	MStringArray results;
+	results.append(MString("frames=") + std::to_string(frames.size()).c_str());
+	results.append(MString("allocationFreeFrames=") + std::to_string(countAllocationFree(frames)).c_str());
+
+	uint64_t peakAllocations = 0;
+	uint64_t peakBytes = 0;
+
+	for (const BoneGeometryAllocations::Frame& frame : frames)
+	{
+
+		peakAllocations = std::max(peakAllocations, frame.totalAllocations());
+		peakBytes = std::max(peakBytes, frame.totalBytes());
+
+	}
+
+	results.append(MString("peakAllocations=") + std::to_string(peakAllocations).c_str());
+	results.append(MString("peakBytes=") + std::to_string(peakBytes).c_str());
+
+	double numFrames = static_cast<double>(std::max(frames.size(), size_t(1)));
+
+	for (unsigned int i = 0; i < BoneGeometryAllocations::kNumPhases; i++)
+	{
+
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+
+		for (const BoneGeometryAllocations::Frame& frame : frames)
+		{
+
+			allocations += frame.allocations[i];
+			bytes += frame.bytes[i];
+
+		}
+
+		MString name(BoneGeometryAllocations::phaseName(BoneGeometryAllocations::Phase(i)));
+
+		results.append(name + ".allocations=" + std::to_string(static_cast<double>(allocations) / numFrames).c_str());
+		results.append(name + ".bytes=" + std::to_string(static_cast<double>(bytes) / numFrames).c_str());
+
+	}
+
+	return results;
+
+};
+
+
+void BoneGeometryAllocationsCommand::initializeFromOptionVar()
+/**
+Enables accounting when the "boneGeometryAllocations" option variable is set, so the first frames after the plugin loads can be measured.
+
+@return: Void.
+*/
+{
+
+	bool exists = false;
+	int value = MGlobal::optionVarIntValue(BoneGeometryAllocationsCommand::optionVarName, &exists);
+
+	BoneGeometryAllocations::setEnabled(exists && value != 0);
+
+};
+
+
+MStatus BoneGeometryAllocationsCommand::addFrameNotification()
+/**
+Closes an accounting frame at the end of every Viewport 2.0 render.
+Does nothing in batch mode where there is no renderer.
+
+@return: Return status.
+*/
+{
+
+	MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+
+	if (renderer == nullptr)
+	{
+
+		return MS::kSuccess;
+
+	}
+
+	return renderer->addNotification(BoneGeometryAllocationsCommand::onEndRender, notificationName, MHWRender::MPassContext::kEndRenderSemantic, nullptr);
+
+};
+
+
+MStatus BoneGeometryAllocationsCommand::removeFrameNotification()
+/**
+Removes the notification added by addFrameNotification().
+
+@return: Return status.
+*/
+{
+
+	MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+
+	if (renderer == nullptr)
+	{
+
+		return MS::kSuccess;
+
+	}
+
+	return renderer->removeNotification(notificationName, MHWRender::MPassContext::kEndRenderSemantic);
+
+};
+
+
+void BoneGeometryAllocationsCommand::onEndRender(MHWRender::MDrawContext& context, void* clientData)
+/**
+Notification function used to close the current accounting frame once a viewport has finished rendering.
+
+@param context: The draw context of the finished render.
+@param clientData: Unused.
+@return: Void.
+*/
+{
+
+	BoneGeometryAllocations::endFrame();
+
+};
+
+
+bool BoneGeometryAllocationsCommand::isUndoable() const
+/**
+Accounting is a diagnostic so changes are not undoable.
+
+@return: bool
+*/
+{
+
+	return false;
+
+};
+
+
+bool BoneGeometryAllocationsCommand::hasSyntax() const
+/**
+This method should return true if the command has a syntax object.
+
+@return: bool
+*/
+{
+
+	return true;
+
+};
+
+
+void* BoneGeometryAllocationsCommand::creator()
+/**
+This function is called by Maya when a new instance is requested.
+See pluginMain.cpp for details.
+
+@return: BoneGeometryAllocationsCommand
+*/
+{
+
+	return new BoneGeometryAllocationsCommand();
+
+};
+
+
+MSyntax BoneGeometryAllocationsCommand::newSyntax()
+/**
+Returns the syntax for this command.
+
+@return: MSyntax
+*/
+{
+
+	MSyntax syntax;
+
+	syntax.addFlag(enableFlag, enableLongFlag, MSyntax::kBoolean);
+	syntax.addFlag(framesFlag, framesLongFlag, MSyntax::kLong);
+	syntax.addFlag(jsonFlag, jsonLongFlag);
+	syntax.addFlag(resetFlag, resetLongFlag);
+
+	syntax.enableQuery(true);
+
+	return syntax;
+
+};
\ No newline at end of file
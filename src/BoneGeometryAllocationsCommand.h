@@ -0,0 +1,59 @@
+#ifndef _BONE_GEOMETRY_ALLOCATIONS_COMMAND
+#define _BONE_GEOMETRY_ALLOCATIONS_COMMAND
+//
+// File: BoneGeometryAllocationsCommand.h
+//
+// Command: boneGeometryAllocations
+// Toggles allocation accounting for the draw path and reports the allocations made per phase per frame.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryAllocations.h"
+
+#include <maya/MPxCommand.h>
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSyntax.h>
+#include <maya/MString.h>
+#include <maya/MStringArray.h>
+#include <maya/MGlobal.h>
+
+#include <maya/MViewport2Renderer.h>
+#include <maya/MDrawContext.h>
+
+#include <string>
+#include <vector>
+
+
+class BoneGeometryAllocationsCommand : public MPxCommand
+{
+
+public:
+
+								BoneGeometryAllocationsCommand();
+	virtual						~BoneGeometryAllocationsCommand();
+
+	virtual	MStatus				doIt(const MArgList& args);
+	virtual	bool				isUndoable() const;
+	virtual	bool				hasSyntax() const;
+
+	static	void*				creator();
+	static	MSyntax				newSyntax();
+
+	static	void				initializeFromOptionVar();
+	static	MStatus				addFrameNotification();
+	static	MStatus				removeFrameNotification();
+
+	static	MString				commandName;
+	static	MString				optionVarName;
+
+protected:
+
+	static	void				onEndRender(MHWRender::MDrawContext& context, void* clientData);
+
+	static	std::string			toJson(const std::vector<BoneGeometryAllocations::Frame>& frames);
+	static	MStringArray		toStringArray(const std::vector<BoneGeometryAllocations::Frame>& frames);
+
+};
+#endif
\ No newline at end of file
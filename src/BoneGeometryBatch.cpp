@@ -0,0 +1,309 @@
+//
+// File: BoneGeometryBatch.cpp
+//
+// Dependency Graph Node: boneGeometryBatch
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryDirtyQueue.h"
+
+MString	BoneGeometryBatch::drawDbClassification("drawdb/subscene/BoneGeometryBatch");
+MString	BoneGeometryBatch::drawRegistrantId("BoneGeometryBatchPlugin");
+MTypeId	BoneGeometryBatch::id(0x0013b1d3);
+
+std::mutex									BoneGeometryBatch::registryMutex;
+std::vector<BoneGeometry*>					BoneGeometryBatch::registry;
+std::atomic<unsigned long long>				BoneGeometryBatch::registryRevision(0);
+std::atomic<const void*>					BoneGeometryBatch::batchOwner(nullptr);
+std::atomic<bool>							BoneGeometryBatch::isOwnerVisible(false);
+std::mutex									BoneGeometryBatch::ownerMutex;
+MObjectHandle								BoneGeometryBatch::ownerNode;
+
+
+BoneGeometryBatch::BoneGeometryBatch() {};
+BoneGeometryBatch::~BoneGeometryBatch() {};
+
+
+bool BoneGeometryBatch::isBounded() const
+/**
+This function indicates if the bounding method will be overrided by the user.
+The batch draws bones from across the whole scene so it is never culled.
+
+@return: bool
+*/
+{
+
+	return false;
+
+};
+
+
+void* BoneGeometryBatch::creator()
+/**
+This function is called by Maya when a new instance is requested.
+See pluginMain.cpp for details.
+
+@return: BoneGeometryBatch
+*/
+{
+
+	return new BoneGeometryBatch();
+
+};
+
+
+MStatus BoneGeometryBatch::initialize()
+/**
+This function is called by Maya after a plugin has been loaded.
+The batch node has no attributes of its own, its existence in the scene is what enables batching.
+
+@return: MStatus
+*/
+{
+
+	return MS::kSuccess;
+
+};
+
+
+void BoneGeometryBatch::registerBone(BoneGeometry* boneGeometry, const BoneGeometryRegistry::Handle& handle)
+/**
+Adds the supplied bone to the registry under its registry slot, so the registry columns can be read alongside it.
+
+@param boneGeometry: The bone to register.
+@param handle: The bone's registry handle.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(BoneGeometryBatch::registryMutex);
+
+	if (handle.index >= BoneGeometryBatch::registry.size())
+	{
+
+		BoneGeometryBatch::registry.resize(handle.index + 1, nullptr);
+
+	}
+
+	BoneGeometryBatch::registry[handle.index] = boneGeometry;
+	BoneGeometryBatch::registryRevision++;
+
+};
+
+
+void BoneGeometryBatch::deregisterBone(BoneGeometry* boneGeometry, const BoneGeometryRegistry::Handle& handle)
+/**
+Removes the supplied bone from the registry.
+The slot is only cleared if the bone still holds it, registry slots are reused once released.
+
+@param boneGeometry: The bone to deregister.
+@param handle: The bone's registry handle.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(BoneGeometryBatch::registryMutex);
+
+	if (handle.index < BoneGeometryBatch::registry.size() && BoneGeometryBatch::registry[handle.index] == boneGeometry)
+	{
+
+		BoneGeometryBatch::registry[handle.index] = nullptr;
+		BoneGeometryBatch::registryRevision++;
+
+	}
+
+};
+
+
+void BoneGeometryBatch::getBones(std::vector<BoneGeometry*>& bones)
+/**
+Copies the registered bones into the passed array, indexed by registry slot.
+Slots without a registered bone are null.
+
+@param bones: The passed array to populate.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(BoneGeometryBatch::registryMutex);
+
+	bones.assign(BoneGeometryBatch::registry.begin(), BoneGeometryBatch::registry.end());
+
+};
+
+
+unsigned long long BoneGeometryBatch::revision()
+/**
+Returns a counter that is bumped whenever a bone is registered or deregistered.
+
+@return: unsigned long long
+*/
+{
+
+	return BoneGeometryBatch::registryRevision.load();
+
+};
+
+
+bool BoneGeometryBatch::claimBatching(const void* owner, const MObject& node)
+/**
+Attempts to make the supplied sub-scene override the one that draws bone wireframes.
+Only a single override may own the batch at a time, so extra batch nodes never draw the bones twice.
+Every bone is dirtied when ownership is first taken so the bones stop drawing their own wireframe.
+
+@param owner: The sub-scene override requesting ownership.
+@param node: The batch node drawn by the override.
+@return: True if the supplied override owns the batch.
+*/
+{
+
+	const void* expected = nullptr;
+
+	if (!BoneGeometryBatch::batchOwner.compare_exchange_strong(expected, owner))
+	{
+
+		return expected == owner;
+
+	}
+
+	{
+
+		std::lock_guard<std::mutex> lock(BoneGeometryBatch::ownerMutex);
+		BoneGeometryBatch::ownerNode = MObjectHandle(node);
+
+	}
+
+	BoneGeometryBatch::isOwnerVisible = BoneGeometryBatch::isOwnerPathVisible();
+	BoneGeometryBatch::dirtyBones();
+
+	return true;
+
+};
+
+
+void BoneGeometryBatch::releaseBatching(const void* owner)
+/**
+Releases ownership of the batch if it is held by the supplied sub-scene override.
+Every bone is dirtied so the bones draw their own wireframe again.
+
+@param owner: The sub-scene override releasing ownership.
+@return: Void.
+*/
+{
+
+	const void* expected = owner;
+
+	if (!BoneGeometryBatch::batchOwner.compare_exchange_strong(expected, nullptr))
+	{
+
+		return;
+
+	}
+
+	{
+
+		std::lock_guard<std::mutex> lock(BoneGeometryBatch::ownerMutex);
+		BoneGeometryBatch::ownerNode = MObjectHandle();
+
+	}
+
+	BoneGeometryBatch::isOwnerVisible = false;
+	BoneGeometryBatch::dirtyBones();
+
+};
+
+
+bool BoneGeometryBatch::isBatching()
+/**
+Evaluates if a batch sub-scene override is drawing bone wireframes on behalf of the bones.
+The batch only counts while its node is visible, otherwise a hidden batch node would hide every bone.
+
+@return: bool
+*/
+{
+
+	return BoneGeometryBatch::batchOwner.load() != nullptr && BoneGeometryBatch::isOwnerVisible.load();
+
+};
+
+
+void BoneGeometryBatch::updateVisibility()
+/**
+Checks if the owning batch node has been shown or hidden, this includes its parents and display layers.
+Called before each model panel renders, the bones are dirtied and flushed straight away so the change is picked up by the same refresh.
+This must be called from the main thread.
+
+@return: Void.
+*/
+{
+
+	if (BoneGeometryBatch::batchOwner.load() == nullptr)
+	{
+
+		return;
+
+	}
+
+	bool isVisible = BoneGeometryBatch::isOwnerPathVisible();
+
+	if (BoneGeometryBatch::isOwnerVisible.exchange(isVisible) != isVisible)
+	{
+
+		BoneGeometryBatch::dirtyBones();
+		BoneGeometryDirtyQueue::flush();
+
+	}
+
+};
+
+
+bool BoneGeometryBatch::isOwnerPathVisible()
+/**
+Evaluates if the batch node drawn by the owning override is visible.
+
+@return: bool
+*/
+{
+
+	std::lock_guard<std::mutex> lock(BoneGeometryBatch::ownerMutex);
+
+	if (!BoneGeometryBatch::ownerNode.isAlive())
+	{
+
+		return false;
+
+	}
+
+	MDagPath dagPath;
+	MStatus status = MDagPath::getAPathTo(BoneGeometryBatch::ownerNode.object(), dagPath);
+
+	return status && dagPath.isVisible();
+
+};
+
+
+void BoneGeometryBatch::dirtyBones()
+/**
+Queues every registered bone to be dirtied, see BoneGeometryDirtyQueue.h.
+
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(BoneGeometryBatch::registryMutex);
+
+	for (BoneGeometry* boneGeometry : BoneGeometryBatch::registry)
+	{
+
+		if (boneGeometry != nullptr)
+		{
+
+			BoneGeometryDirtyQueue::push(boneGeometry);
+
+		}
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef _BONE_GEOMETRY_BATCH_NODE
+#define _BONE_GEOMETRY_BATCH_NODE
+//
+// File: BoneGeometryBatch.h
+//
+// Dependency Graph Node: boneGeometryBatch
+// Opts the scene into drawing every bone's wireframe through a single sub-scene override.
+// Bones register themselves under their registry slot on construction so the override can gather them, along with their shapes, from a single registry scan.
+// Bones only hand their wireframe over while the owning batch node is visible, every bone is dirtied whenever that changes.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryRegistry.h"
+
+#include <maya/MPxLocatorNode.h>
+#include <maya/MObject.h>
+#include <maya/MDagPath.h>
+#include <maya/MString.h>
+#include <maya/MBoundingBox.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MTypeId.h>
+#include <maya/M3dView.h>
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+class BoneGeometry;
+
+
+class BoneGeometryBatch : public MPxLocatorNode
+{
+
+public:
+
+								BoneGeometryBatch();
+	virtual						~BoneGeometryBatch();
+
+	virtual	void				draw(M3dView& view, const MDagPath& dagPath, M3dView::DisplayStyle displayStyle, M3dView::DisplayStatus displayStatus) {};
+
+	virtual	bool				isBounded() const;
+
+	static  void*				creator();
+	static  MStatus				initialize();
+
+	static	void				registerBone(BoneGeometry* boneGeometry, const BoneGeometryRegistry::Handle& handle);
+	static	void				deregisterBone(BoneGeometry* boneGeometry, const BoneGeometryRegistry::Handle& handle);
+	static	void				getBones(std::vector<BoneGeometry*>& bones);
+	static	unsigned long long	revision();
+
+	static	bool				claimBatching(const void* owner, const MObject& node);
+	static	void				releaseBatching(const void* owner);
+	static	bool				isBatching();
+	static	void				updateVisibility();
+
+public:
+
+	static	MString				drawDbClassification;
+	static	MString				drawRegistrantId;
+	static	MTypeId				id;
+
+protected:
+
+	static	bool				isOwnerPathVisible();
+	static	void				dirtyBones();
+
+protected:
+
+	static	std::mutex										registryMutex;
+	static	std::vector<BoneGeometry*>						registry;
+	static	std::atomic<unsigned long long>					registryRevision;
+	static	std::atomic<const void*>						batchOwner;
+	static	std::atomic<bool>								isOwnerVisible;
+	static	std::mutex										ownerMutex;
+	static	MObjectHandle									ownerNode;
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,1246 @@
+//
+// File: BoneGeometryBatchOverride.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryBatchOverride.h"
+
+#include <maya/MEventMessage.h>
+#include <maya/MFnAttribute.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+
+	const char* APPEARANCE_EVENTS[] = { "SelectionChanged", "displayLayerChange", "displayLayerVisibilityChanged", "DisplayRGBColorChanged", "ColorIndexChanged" };
+	const char* DISPLAY_ATTRIBUTES[] = { "visibility", "lodVisibility", "template", "intermediateObject", "drawOverride", "overrideEnabled", "overrideDisplayType", "overrideLevelOfDetail", "overrideShading", "overrideVisibility", "overrideColor", "overrideRGBColors", "overrideColorRGB", "useObjectColor", "objectColor", "wireColorRGB" };
+
+	bool isDisplayPlug(const MPlug& plug)
+	/**
+	Evaluates if the supplied plug affects how a dag node is drawn, such as its visibility or drawing overrides.
+	Children of compound colours are matched through their parent.
+
+	@param plug: The plug to test.
+	@return: bool
+	*/
+	{
+
+		MPlug target = plug.isChild() ? plug.parent() : plug;
+		MString name = MFnAttribute(target.attribute()).name();
+
+		for (const char* displayAttribute : DISPLAY_ATTRIBUTES)
+		{
+
+			if (name == displayAttribute)
+			{
+
+				return true;
+
+			}
+
+		}
+
+		return false;
+
+	};
+
+};
+
+
+BoneGeometryBatchOverride::BoneGeometryBatchOverride(const MObject& node) : MPxSubSceneOverride(node), changes(kDagChanged), registryRevision(~0ull), batchRevision(~0ull), batchNode(node), bucketCount(0), enabled(true)
+/**
+Constructor.
+Scene-wide callbacks are added here, per-bone callbacks are added as bones are first visited, see watchSlot().
+
+@param node: The batch node this override draws.
+*/
+{
+
+	MStatus status;
+
+	for (const char* eventName : APPEARANCE_EVENTS)
+	{
+
+		MCallbackId callbackId = MEventMessage::addEventCallback(eventName, BoneGeometryBatchOverride::onAppearanceChanged, this, &status);
+
+		if (status)
+		{
+
+			this->eventCallbackIds.append(callbackId);
+
+		}
+
+	}
+
+	MCallbackId callbackId = MDagMessage::addAllDagChangesCallback(BoneGeometryBatchOverride::onDagChanged, this, &status);
+
+	if (status)
+	{
+
+		this->eventCallbackIds.append(callbackId);
+
+	}
+
+	BoneGeometryBatch::claimBatching(this, this->batchNode);
+
+};
+
+
+BoneGeometryBatchOverride::~BoneGeometryBatchOverride()
+/**
+Destructor.
+Every callback is removed and any shaders still held by the buckets are returned to the shader manager, the render items themselves are owned by the container.
+*/
+{
+
+	BoneGeometryBatch::releaseBatching(this);
+
+	MMessage::removeCallbacks(this->eventCallbackIds);
+
+	for (std::unique_ptr<Slot>& slot : this->slots)
+	{
+
+		this->unwatchSlot(*slot);
+		this->removeInstances(*slot);
+
+	}
+
+	MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+	const MHWRender::MShaderManager* shaderManager = (renderer != nullptr) ? renderer->getShaderManager() : nullptr;
+
+	for (std::pair<const BucketKey, Bucket>& bucket : this->buckets)
+	{
+
+		if (shaderManager != nullptr && bucket.second.shader != nullptr)
+		{
+
+			shaderManager->releaseShader(bucket.second.shader);
+
+		}
+
+	}
+
+};
+
+
+MHWRender::MPxSubSceneOverride* BoneGeometryBatchOverride::creator(const MObject& node)
+/**
+Static function used to create a new sub-scene override instance.
+This function is called via the MDrawRegistry::registerSubSceneOverrideCreator() method.
+
+@param node: The Maya object this override draws.
+@return: MPxSubSceneOverride*
+*/
+{
+
+	return new BoneGeometryBatchOverride(node);
+
+};
+
+
+MHWRender::DrawAPI BoneGeometryBatchOverride::supportedDrawAPIs() const
+/**
+Returns the draw API supported by this override.
+
+@return: MHWRender::DrawAPI
+*/
+{
+
+	return (MHWRender::kOpenGL | MHWRender::kDirectX11 | MHWRender::kOpenGLCoreProfile);
+
+};
+
+
+bool BoneGeometryBatchOverride::isWireframe(const MHWRender::MFrameContext& frameContext)
+/**
+Evaluates if the supplied frame is drawn in wireframe only.
+Wireframe on shaded is left to the individual bones since they draw their shaded faces anyway.
+
+@param frameContext: Frame level context information.
+@return: bool
+*/
+{
+
+	unsigned int displayStyle = frameContext.getDisplayStyle();
+	return (displayStyle & MHWRender::MFrameContext::kWireFrame) && !(displayStyle & MHWRender::MFrameContext::kGouraudShaded);
+
+};
+
+
+bool BoneGeometryBatchOverride::requiresUpdate(const MHWRender::MSubSceneContainer& container, const MHWRender::MFrameContext& frameContext) const
+/**
+Returns true if update() needs to be called.
+The owning override only updates when wireframe is toggled or, while drawing, when the registry, the registered bones or a watched callback reports a change.
+Overrides that do not own the batch only update to release anything they drew.
+
+@param container: The container of render items owned by this override.
+@param frameContext: Frame level context information.
+@return: bool
+*/
+{
+
+	if (!BoneGeometryBatch::claimBatching(this, this->batchNode))
+	{
+
+		return !this->buckets.empty();
+
+	}
+
+	bool enabled = BoneGeometryBatchOverride::isWireframe(frameContext);
+
+	if (enabled != this->enabled)
+	{
+
+		return true;
+
+	}
+
+	if (!enabled)
+	{
+
+		return false;
+
+	}
+
+	return this->changes.load() != kNoChanges || this->registryRevision != BoneGeometryRegistry::revision() || this->batchRevision != BoneGeometryBatch::revision();
+
+};
+
+
+void BoneGeometryBatchOverride::update(MHWRender::MSubSceneContainer& container, const MHWRender::MFrameContext& frameContext)
+/**
+Updates the render items for the current frame.
+Changed bones are regenerated in world space and only the buckets they entered or left are re-uploaded.
+
+@param container: The container of render items owned by this override.
+@param frameContext: Frame level context information.
+@return: void
+*/
+{
+
+	BONE_GEOMETRY_PROFILE("batchUpdate", kColorC_L1, MObject::kNullObj);
+	BoneGeometryTrace::Scope trace("BoneGeometryBatchOverride::update");
+
+	// Check if this override owns the batch
+	//
+	if (!BoneGeometryBatch::claimBatching(this, this->batchNode))
+	{
+
+		this->clear(container);
+		return;
+
+	}
+
+	// Hide the buckets outside of wireframe, the cached edges are kept for when wireframe returns
+	//
+	bool enabled = BoneGeometryBatchOverride::isWireframe(frameContext);
+
+	if (enabled != this->enabled)
+	{
+
+		this->enableBuckets(container, enabled);
+		this->enabled = enabled;
+
+	}
+
+	if (!enabled || !this->updateInstances())
+	{
+
+		return;
+
+	}
+
+	// Gather the edges for each dirty bucket into this thread's scratch arena, which is rewound once the buckets are uploaded
+	// The edges are counted first so each bucket is a single allocation
+	//
+	ScratchArena& arena = ScratchArena::local();
+	ScratchArena::Scope scratch(arena);
+
+	GatherMap::allocator_type allocator(arena);
+	GatherMap gathers(allocator);
+
+	for (std::pair<const BucketKey, Bucket>& bucket : this->buckets)
+	{
+
+		if (bucket.second.dirty)
+		{
+
+			gathers.emplace(bucket.first, Gather());
+
+		}
+
+	}
+
+	for (const std::unique_ptr<Slot>& slot : this->slots)
+	{
+
+		for (const std::pair<const unsigned int, Instance>& instance : slot->instances)
+		{
+
+			GatherMap::iterator iter = gathers.find(instance.second.bucket);
+
+			if (iter != gathers.end())
+			{
+
+				iter->second.size += instance.second.positions.size();
+
+			}
+
+		}
+
+	}
+
+	for (std::pair<const BucketKey, Gather>& gather : gathers)
+	{
+
+		gather.second.positions = (gather.second.size > 0) ? arena.allocate<float>(gather.second.size) : nullptr;
+		gather.second.size = 0;
+
+	}
+
+	for (const std::unique_ptr<Slot>& slot : this->slots)
+	{
+
+		for (const std::pair<const unsigned int, Instance>& instance : slot->instances)
+		{
+
+			GatherMap::iterator iter = gathers.find(instance.second.bucket);
+
+			if (iter != gathers.end() && !instance.second.positions.empty())
+			{
+
+				std::memcpy(iter->second.positions + iter->second.size, instance.second.positions.data(), instance.second.positions.size() * sizeof(float));
+				iter->second.size += instance.second.positions.size();
+
+			}
+
+		}
+
+	}
+
+	// Upload dirty buckets, removing any that were emptied
+	//
+	for (std::pair<const BucketKey, Gather>& gather : gathers)
+	{
+
+		std::map<BucketKey, Bucket>::iterator iter = this->buckets.find(gather.first);
+
+		if (gather.second.size == 0)
+		{
+
+			this->removeBucket(container, iter->second);
+			this->buckets.erase(iter);
+
+		}
+		else
+		{
+
+			this->updateBucket(container, iter->first, iter->second, gather.second.positions, gather.second.size);
+
+		}
+
+	}
+
+};
+
+
+bool BoneGeometryBatchOverride::updateInstances()
+/**
+Synchronizes the cached bone instances with the registry, only visiting the slots that changed since the last call.
+A slot changes when its bone is registered, replaced or republishes its shape, or when one of its callbacks reports a matrix or display change.
+Scene-wide events, such as selection or display layer changes, visit every slot once, changes to the dag hierarchy also rebuild every slot's callbacks.
+The registry is scanned through a single reader, which is released before calling back into Maya.
+
+@return: True if any bucket is dirty.
+*/
+{
+
+	BONE_GEOMETRY_PROFILE("batchUpdateInstances", kColorC_L2, MObject::kNullObj);
+
+	// Collect what changed since the last call, the revisions are read first so anything published afterwards is picked up next time
+	//
+	unsigned int changes = this->changes.exchange(kNoChanges);
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->markedMutex);
+		this->syncSlots.swap(this->markedSlots);
+
+	}
+
+	unsigned long long registryRevision = BoneGeometryRegistry::revision();
+	unsigned long long batchRevision = BoneGeometryBatch::revision();
+
+	if (batchRevision != this->batchRevision)
+	{
+
+		BoneGeometryBatch::getBones(this->bones);
+
+	}
+
+	size_t numSlots = std::max(this->bones.size(), this->slots.size());
+	this->bones.resize(numSlots, nullptr);
+
+	while (this->slots.size() < numSlots)
+	{
+
+		std::unique_ptr<Slot> slot(new Slot());
+		slot->owner = this;
+		slot->index = static_cast<unsigned int>(this->slots.size());
+
+		this->slots.push_back(std::move(slot));
+
+	}
+
+	unsigned char state = (changes & kDagChanged) ? (kSlotDirty | kSlotRewatch) : (changes & kAppearanceChanged) ? kSlotDirty : kSlotClean;
+	this->slotStates.assign(numSlots, state);
+
+	for (unsigned int index : this->syncSlots)
+	{
+
+		if (index < numSlots)
+		{
+
+			this->slotStates[index] |= kSlotDirty;
+
+		}
+
+	}
+
+	this->syncSlots.clear();
+
+	// Compare every slot against the registry, only changed shapes are copied
+	//
+	if (registryRevision != this->registryRevision || batchRevision != this->batchRevision)
+	{
+
+		BoneGeometryRegistry::Reader reader;
+		const BoneGeometryRegistry::Columns& columns = reader.columns();
+
+		for (size_t i = 0; i < numSlots; i++)
+		{
+
+			Slot& slot = *this->slots[i];
+
+			BoneGeometry* boneGeometry = this->bones[i];
+			BoneGeometryRegistry::Handle handle;
+
+			if (boneGeometry != nullptr && i < columns.numSlots && columns.isAlive[i])
+			{
+
+				handle.index = static_cast<unsigned int>(i);
+				handle.generation = columns.generation[i];
+
+			}
+			else
+			{
+
+				boneGeometry = nullptr;
+
+			}
+
+			if (slot.boneGeometry != boneGeometry || slot.handle != handle)
+			{
+
+				slot.boneGeometry = boneGeometry;
+				slot.handle = handle;
+
+				this->slotStates[i] |= kSlotDirty | kSlotReplaced;
+
+			}
+
+			if (boneGeometry != nullptr && ((this->slotStates[i] & kSlotReplaced) || slot.shape.revision != columns.revision[i]))
+			{
+
+				reader.get(i, slot.shape);
+				this->slotStates[i] |= kSlotDirty;
+
+			}
+
+		}
+
+	}
+
+	this->registryRevision = registryRevision;
+	this->batchRevision = batchRevision;
+
+	// Visit the changed slots
+	//
+	bool isDirty = false;
+
+	for (size_t i = 0; i < numSlots; i++)
+	{
+
+		unsigned char slotState = this->slotStates[i];
+
+		if (!(slotState & kSlotDirty))
+		{
+
+			continue;
+
+		}
+
+		Slot& slot = *this->slots[i];
+		bool rewatch = (slotState & (kSlotRewatch | kSlotReplaced)) != 0;
+
+		if (rewatch)
+		{
+
+			this->unwatchSlot(slot);
+
+		}
+
+		if (slotState & kSlotReplaced)
+		{
+
+			isDirty |= this->removeInstances(slot);
+
+		}
+
+		if (slot.boneGeometry != nullptr)
+		{
+
+			isDirty |= this->updateSlot(slot, rewatch);
+
+		}
+
+	}
+
+	return isDirty;
+
+};
+
+
+bool BoneGeometryBatchOverride::updateSlot(Slot& slot, const bool rewatch)
+/**
+Synchronizes the instances of the supplied slot's bone.
+Each visible dag path to the bone is an instance, its edges are regenerated only when the shape, world matrix or appearance changes.
+The buckets an instance leaves or enters are marked dirty.
+
+@param slot: The slot to synchronize.
+@param rewatch: If true, the slot's callbacks are added for its current dag paths.
+@return: True if any bucket is dirty.
+*/
+{
+
+	MStatus status;
+
+	MDagPathArray dagPaths;
+	status = MDagPath::getAllPathsTo(slot.boneGeometry->thisMObject(), dagPaths);
+
+	if (!status)
+	{
+
+		return this->removeInstances(slot);
+
+	}
+
+	if (rewatch)
+	{
+
+		this->watchSlot(slot, dagPaths);
+
+	}
+
+	for (std::pair<const unsigned int, Instance>& instance : slot.instances)
+	{
+
+		instance.second.visited = false;
+
+	}
+
+	bool isDirty = false;
+	BoneGenerator::Point4 points[BoneTopology::MAX_VERTICES];
+
+	for (unsigned int i = 0; i < dagPaths.length(); i++)
+	{
+
+		const MDagPath& dagPath = dagPaths[i];
+
+		if (!dagPath.isVisible())
+		{
+
+			continue;
+
+		}
+
+		// Compare against the cached instance
+		//
+		MMatrix matrix = dagPath.inclusiveMatrix();
+
+		MColor wireColor;
+		unsigned int depthPriority;
+
+		BoneGeometryDrawData::getAppearance(dagPath, wireColor, depthPriority);
+
+		BucketKey bucketKey(wireColor.r, wireColor.g, wireColor.b, wireColor.a, depthPriority);
+
+		std::pair<std::map<unsigned int, Instance>::iterator, bool> inserted = slot.instances.emplace(dagPath.instanceNumber(), Instance());
+
+		Instance& instance = inserted.first->second;
+		instance.visited = true;
+
+		bool isNew = inserted.second;
+		bool isShapeDirty = isNew || instance.revision != slot.shape.revision || instance.matrix != matrix;
+
+		if (!isShapeDirty && instance.bucket == bucketKey)
+		{
+
+			BoneGeometryStats::add(BoneGeometryStats::kBatchInstanceHits);
+			continue;
+
+		}
+
+		// Regenerate world-space edges, drawn shapes are at the identity so the dag path's matrix places them directly
+		// The topology tables list each edge as a pair of vertex indices
+		//
+		if (isShapeDirty)
+		{
+
+			BoneGeometryStats::ScopedTimer timer(&slot.boneGeometry->stats);
+			BoneGeometryStats::add(BoneGeometryStats::kBatchInstanceRebuilds);
+
+			size_t previousSize = instance.positions.size();
+
+			unsigned int finMask = slot.shape.finMask;
+			const BoneTopology::TopologyView& topology = BoneTopology::topology(finMask);
+
+			BoneGenerator::generate(finMask, slot.shape.parameters, matrix.matrix, points);
+
+			size_t previousCapacity = instance.positions.capacity();
+			instance.positions.resize(topology.numEdges * 6);
+
+			if (instance.positions.capacity() != previousCapacity)
+			{
+
+				BoneGeometryAllocations::record(BoneGeometryAllocations::kBatchInstances, instance.positions.capacity() * sizeof(float));
+
+			}
+
+			BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, (static_cast<int64_t>(instance.positions.size()) - static_cast<int64_t>(previousSize)) * static_cast<int64_t>(sizeof(float)));
+
+			float* position = instance.positions.data();
+
+			for (unsigned int j = 0; j < topology.numEdges * 2; j++)
+			{
+
+				const BoneGenerator::Point4& point = points[topology.edgeVertices[j]];
+
+				*position++ = static_cast<float>(point[0]);
+				*position++ = static_cast<float>(point[1]);
+				*position++ = static_cast<float>(point[2]);
+
+			}
+
+		}
+
+		// Dirty the buckets this instance is leaving and entering
+		//
+		if (!isNew)
+		{
+
+			this->buckets[instance.bucket].dirty = true;
+
+		}
+
+		this->buckets[bucketKey].dirty = true;
+
+		instance.revision = slot.shape.revision;
+		instance.matrix = matrix;
+		instance.bucket = bucketKey;
+
+		isDirty = true;
+
+	}
+
+	// Remove instances that were deleted or hidden
+	//
+	for (std::map<unsigned int, Instance>::iterator iter = slot.instances.begin(); iter != slot.instances.end();)
+	{
+
+		if (iter->second.visited)
+		{
+
+			iter++;
+
+		}
+		else
+		{
+
+			this->buckets[iter->second.bucket].dirty = true;
+			BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, -static_cast<int64_t>(iter->second.positions.size() * sizeof(float)));
+
+			iter = slot.instances.erase(iter);
+
+			isDirty = true;
+
+		}
+
+	}
+
+	return isDirty;
+
+};
+
+
+bool BoneGeometryBatchOverride::removeInstances(Slot& slot)
+/**
+Removes every instance of the supplied slot, marking the buckets they were drawn in dirty.
+
+@param slot: The slot to empty.
+@return: True if any bucket is dirty.
+*/
+{
+
+	for (const std::pair<const unsigned int, Instance>& instance : slot.instances)
+	{
+
+		this->buckets[instance.second.bucket].dirty = true;
+		BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, -static_cast<int64_t>(instance.second.positions.size() * sizeof(float)));
+
+	}
+
+	bool isDirty = !slot.instances.empty();
+	slot.instances.clear();
+
+	return isDirty;
+
+};
+
+
+void BoneGeometryBatchOverride::watchSlot(Slot& slot, const MDagPathArray& dagPaths)
+/**
+Adds the callbacks that mark the supplied slot whenever its bone is moved or its display changes.
+Each dag path gets a world matrix callback, the bone and every ancestor along the paths get an attribute changed callback.
+
+@param slot: The slot to watch.
+@param dagPaths: Every dag path to the slot's bone.
+@return: Void.
+*/
+{
+
+	MStatus status;
+
+	MObject node = slot.boneGeometry->thisMObject();
+	MCallbackId callbackId = MNodeMessage::addAttributeChangedCallback(node, BoneGeometryBatchOverride::onBoneAttributeChanged, &slot, &status);
+
+	if (status)
+	{
+
+		slot.callbackIds.append(callbackId);
+
+	}
+
+	for (unsigned int i = 0; i < dagPaths.length(); i++)
+	{
+
+		MDagPath dagPath(dagPaths[i]);
+		callbackId = MDagMessage::addWorldMatrixModifiedCallback(dagPath, BoneGeometryBatchOverride::onWorldMatrixModified, &slot, &status);
+
+		if (status)
+		{
+
+			slot.callbackIds.append(callbackId);
+
+		}
+
+		// Hiding or recolouring an ancestor changes how the bone is drawn without touching the bone itself
+		//
+		dagPath.pop();
+
+		while (dagPath.length() > 0)
+		{
+
+			this->watchAncestor(slot, dagPath.node());
+			dagPath.pop();
+
+		}
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::watchAncestor(Slot& slot, const MObject& node)
+/**
+Adds the supplied slot to the watchers of an ancestor node.
+Bones that share an ancestor share a single attribute changed callback, which is added for the first watcher.
+
+@param slot: The slot watching the ancestor.
+@param node: The ancestor node.
+@return: Void.
+*/
+{
+
+	MObjectHandle handle(node);
+	unsigned int hashCode = handle.hashCode();
+
+	Ancestor* ancestor = nullptr;
+	std::pair<std::multimap<unsigned int, Ancestor>::iterator, std::multimap<unsigned int, Ancestor>::iterator> range = this->ancestors.equal_range(hashCode);
+
+	for (std::multimap<unsigned int, Ancestor>::iterator iter = range.first; iter != range.second; iter++)
+	{
+
+		if (iter->second.node == handle)
+		{
+
+			ancestor = &iter->second;
+			break;
+
+		}
+
+	}
+
+	if (ancestor == nullptr)
+	{
+
+		MStatus status;
+
+		ancestor = &this->ancestors.emplace(hashCode, Ancestor())->second;
+		ancestor->owner = this;
+		ancestor->node = handle;
+		ancestor->hashCode = hashCode;
+
+		MObject ancestorNode(node);
+		MCallbackId callbackId = MNodeMessage::addAttributeChangedCallback(ancestorNode, BoneGeometryBatchOverride::onAncestorAttributeChanged, ancestor, &status);
+
+		ancestor->callbackId = status ? callbackId : 0;
+
+	}
+
+	if (std::find(slot.ancestors.begin(), slot.ancestors.end(), ancestor) == slot.ancestors.end())
+	{
+
+		ancestor->slots.push_back(slot.index);
+		slot.ancestors.push_back(ancestor);
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::unwatchSlot(Slot& slot)
+/**
+Removes the callbacks added by watchSlot(), ancestors without any remaining watchers are forgotten.
+
+@param slot: The slot to stop watching.
+@return: Void.
+*/
+{
+
+	if (slot.callbackIds.length() > 0)
+	{
+
+		MMessage::removeCallbacks(slot.callbackIds);
+		slot.callbackIds.clear();
+
+	}
+
+	for (Ancestor* ancestor : slot.ancestors)
+	{
+
+		ancestor->slots.erase(std::find(ancestor->slots.begin(), ancestor->slots.end(), slot.index));
+
+		if (!ancestor->slots.empty())
+		{
+
+			continue;
+
+		}
+
+		if (ancestor->callbackId != 0)
+		{
+
+			MMessage::removeCallback(ancestor->callbackId);
+
+		}
+
+		std::pair<std::multimap<unsigned int, Ancestor>::iterator, std::multimap<unsigned int, Ancestor>::iterator> range = this->ancestors.equal_range(ancestor->hashCode);
+
+		for (std::multimap<unsigned int, Ancestor>::iterator iter = range.first; iter != range.second; iter++)
+		{
+
+			if (&iter->second == ancestor)
+			{
+
+				this->ancestors.erase(iter);
+				break;
+
+			}
+
+		}
+
+	}
+
+	slot.ancestors.clear();
+
+};
+
+
+void BoneGeometryBatchOverride::markSlot(const unsigned int index)
+/**
+Marks the supplied slot to be visited by the next update, this is safe to call from any thread.
+
+@param index: The slot index.
+@return: Void.
+*/
+{
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->markedMutex);
+		this->markedSlots.push_back(index);
+
+	}
+
+	this->changes.fetch_or(kBonesChanged);
+
+};
+
+
+void BoneGeometryBatchOverride::markChanges(const unsigned int changes)
+/**
+Records a scene-wide change to be handled by the next update, this is safe to call from any thread.
+
+@param changes: The changes to record, see Change.
+@return: Void.
+*/
+{
+
+	this->changes.fetch_or(changes);
+
+};
+
+
+void BoneGeometryBatchOverride::onBoneAttributeChanged(MNodeMessage::AttributeMessage message, MPlug& plug, MPlug& otherPlug, void* clientData)
+/**
+Callback function used to mark a bone's slot whenever one of its display attributes is edited or connected, such as when it joins a display layer.
+Shape attributes are ignored since they reach the registry.
+
+@param message: The kind of attribute change.
+@param plug: The plug that changed.
+@param otherPlug: The other plug involved in a connection change.
+@param clientData: The slot watching the bone.
+@return: Void.
+*/
+{
+
+	if ((message & (MNodeMessage::kAttributeSet | MNodeMessage::kConnectionMade | MNodeMessage::kConnectionBroken)) && isDisplayPlug(plug))
+	{
+
+		Slot* slot = static_cast<Slot*>(clientData);
+		slot->owner->markSlot(slot->index);
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::onAncestorAttributeChanged(MNodeMessage::AttributeMessage message, MPlug& plug, MPlug& otherPlug, void* clientData)
+/**
+Callback function used to mark every slot below an ancestor whenever one of the ancestor's display attributes is edited or connected.
+
+@param message: The kind of attribute change.
+@param plug: The plug that changed.
+@param otherPlug: The other plug involved in a connection change.
+@param clientData: The watched ancestor.
+@return: Void.
+*/
+{
+
+	if ((message & (MNodeMessage::kAttributeSet | MNodeMessage::kConnectionMade | MNodeMessage::kConnectionBroken)) && isDisplayPlug(plug))
+	{
+
+		Ancestor* ancestor = static_cast<Ancestor*>(clientData);
+
+		for (unsigned int index : ancestor->slots)
+		{
+
+			ancestor->owner->markSlot(index);
+
+		}
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::onWorldMatrixModified(MObject& transformNode, MDagMessage::MatrixModifiedFlags& modified, void* clientData)
+/**
+Callback function used to mark a bone's slot whenever one of its dag paths is moved.
+
+@param transformNode: The transform that changed.
+@param modified: The matrix components that changed.
+@param clientData: The slot watching the dag path.
+@return: Void.
+*/
+{
+
+	Slot* slot = static_cast<Slot*>(clientData);
+	slot->owner->markSlot(slot->index);
+
+};
+
+
+void BoneGeometryBatchOverride::onDagChanged(MDagMessage::DagMessage message, MDagPath& child, MDagPath& parent, void* clientData)
+/**
+Callback function used to rebuild every slot's dag paths and callbacks whenever the hierarchy is edited or instanced.
+
+@param message: The kind of hierarchy change.
+@param child: The child path.
+@param parent: The parent path.
+@param clientData: The override.
+@return: Void.
+*/
+{
+
+	static_cast<BoneGeometryBatchOverride*>(clientData)->markChanges(kDagChanged);
+
+};
+
+
+void BoneGeometryBatchOverride::onAppearanceChanged(void* clientData)
+/**
+Callback function used to visit every slot after a scene-wide display change, such as a new selection or a display layer edit.
+
+@param clientData: The override.
+@return: Void.
+*/
+{
+
+	static_cast<BoneGeometryBatchOverride*>(clientData)->markChanges(kAppearanceChanged);
+
+};
+
+
+void BoneGeometryBatchOverride::updateBucket(MHWRender::MSubSceneContainer& container, const BucketKey& key, Bucket& bucket, const float* positions, const size_t size)
+/**
+Uploads the supplied edges to the bucket's render item, creating the item on first use.
+The index buffer is only rewritten when the vertex count changes.
+
+@param container: The container of render items owned by this override.
+@param key: The colour and depth priority of the bucket.
+@param bucket: The bucket to update.
+@param positions: The world-space line list for the bucket.
+@param size: The number of floats in the line list.
+@return: Void.
+*/
+{
+
+	BONE_GEOMETRY_PROFILE("batchUpdateBucket", kColorC_L2, MObject::kNullObj);
+
+	MHWRender::MRenderItem* renderItem = bucket.name.length() > 0 ? container.find(bucket.name) : nullptr;
+
+	if (renderItem == nullptr)
+	{
+
+		// Create render item with a solid shader coloured for this bucket
+		//
+		MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+		const MHWRender::MShaderManager* shaderManager = (renderer != nullptr) ? renderer->getShaderManager() : nullptr;
+
+		if (shaderManager == nullptr)
+		{
+
+			return;
+
+		}
+
+		bucket.name = "boneGeometryBatch";
+		bucket.name += this->bucketCount++;
+		bucket.shader = shaderManager->getStockShader(MHWRender::MShaderManager::k3dSolidShader);
+
+		if (bucket.shader == nullptr)
+		{
+
+			return;
+
+		}
+
+		const float solidColor[4] = { std::get<0>(key), std::get<1>(key), std::get<2>(key), std::get<3>(key) };
+		bucket.shader->setParameter("solidColor", solidColor);
+
+		renderItem = MHWRender::MRenderItem::Create(bucket.name, MHWRender::MRenderItem::DecorationItem, MHWRender::MGeometry::kLines);
+		renderItem->setDrawMode(MHWRender::MGeometry::kWireframe);
+		renderItem->depthPriority(std::get<4>(key));
+		renderItem->setShader(bucket.shader);
+		renderItem->enable(this->enabled);
+
+		container.add(renderItem);
+
+		MHWRender::MVertexBufferDescriptor descriptor("", MHWRender::MGeometry::kPosition, MHWRender::MGeometry::kFloat, 3);
+		bucket.positionBuffer.reset(new MHWRender::MVertexBuffer(descriptor));
+		bucket.indexBuffer.reset(new MHWRender::MIndexBuffer(MHWRender::MGeometry::kUnsignedInt32));
+		bucket.numVertices = 0;
+
+		BoneGeometryAllocations::record(BoneGeometryAllocations::kBatchBuffers, sizeof(MHWRender::MVertexBuffer) + sizeof(MHWRender::MIndexBuffer), 2);
+
+	}
+
+	// Upload positions and measure bounds
+	//
+	unsigned int numVertices = static_cast<unsigned int>(size / 3);
+	MBoundingBox boundingBox;
+
+	for (unsigned int i = 0; i < numVertices; i++)
+	{
+
+		boundingBox.expand(MPoint(positions[i * 3], positions[(i * 3) + 1], positions[(i * 3) + 2]));
+
+	}
+
+	void* positionData = bucket.positionBuffer->acquire(numVertices, true);
+
+	if (positionData == nullptr)
+	{
+
+		return;
+
+	}
+
+	BoneGeometryAllocations::record(BoneGeometryAllocations::kBatchBuffers, size * sizeof(float));
+
+	std::memcpy(positionData, positions, size * sizeof(float));
+	bucket.positionBuffer->commit(positionData);
+
+	// Lines are stored as independent pairs so the indices simply count upwards
+	//
+	if (numVertices != bucket.numVertices)
+	{
+
+		unsigned int* indexData = static_cast<unsigned int*>(bucket.indexBuffer->acquire(numVertices, true));
+
+		if (indexData == nullptr)
+		{
+
+			return;
+
+		}
+
+		BoneGeometryAllocations::record(BoneGeometryAllocations::kBatchBuffers, numVertices * sizeof(unsigned int));
+
+		for (unsigned int i = 0; i < numVertices; i++)
+		{
+
+			indexData[i] = i;
+
+		}
+
+		bucket.indexBuffer->commit(indexData);
+		bucket.numVertices = numVertices;
+
+	}
+
+	MHWRender::MVertexBufferArray vertexBuffers;
+	vertexBuffers.addBuffer("positions", bucket.positionBuffer.get());
+
+	this->setGeometryForRenderItem(*renderItem, vertexBuffers, *bucket.indexBuffer, &boundingBox);
+	bucket.dirty = false;
+
+	BoneGeometryStats::add(BoneGeometryStats::kBatchBucketUploads);
+
+};
+
+
+void BoneGeometryBatchOverride::removeBucket(MHWRender::MSubSceneContainer& container, Bucket& bucket)
+/**
+Removes the bucket's render item from the container and releases its shader.
+
+@param container: The container of render items owned by this override.
+@param bucket: The bucket to remove.
+@return: Void.
+*/
+{
+
+	if (bucket.name.length() > 0)
+	{
+
+		container.remove(bucket.name);
+
+	}
+
+	if (bucket.shader != nullptr)
+	{
+
+		MHWRender::MRenderer* renderer = MHWRender::MRenderer::theRenderer();
+		const MHWRender::MShaderManager* shaderManager = (renderer != nullptr) ? renderer->getShaderManager() : nullptr;
+
+		if (shaderManager != nullptr)
+		{
+
+			shaderManager->releaseShader(bucket.shader);
+
+		}
+
+		bucket.shader = nullptr;
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::enableBuckets(MHWRender::MSubSceneContainer& container, const bool enabled)
+/**
+Enables or disables every bucket's render item.
+
+@param container: The container of render items owned by this override.
+@param enabled: If true the render items are drawn.
+@return: Void.
+*/
+{
+
+	for (std::pair<const BucketKey, Bucket>& bucket : this->buckets)
+	{
+
+		MHWRender::MRenderItem* renderItem = bucket.second.name.length() > 0 ? container.find(bucket.second.name) : nullptr;
+
+		if (renderItem != nullptr)
+		{
+
+			renderItem->enable(enabled);
+
+		}
+
+	}
+
+};
+
+
+void BoneGeometryBatchOverride::clear(MHWRender::MSubSceneContainer& container)
+/**
+Removes every bucket, forgets all cached instances and removes every per-bone callback.
+The next update visits every bone again.
+
+@param container: The container of render items owned by this override.
+@return: Void.
+*/
+{
+
+	for (std::pair<const BucketKey, Bucket>& bucket : this->buckets)
+	{
+
+		this->removeBucket(container, bucket.second);
+
+	}
+
+	for (std::unique_ptr<Slot>& slot : this->slots)
+	{
+
+		this->unwatchSlot(*slot);
+		this->removeInstances(*slot);
+
+	}
+
+	this->buckets.clear();
+	this->slots.clear();
+	this->bones.clear();
+
+	this->registryRevision = ~0ull;
+	this->batchRevision = ~0ull;
+	this->markChanges(kDagChanged);
+
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef _BONE_GEOMETRY_BATCH_OVERRIDE
+#define _BONE_GEOMETRY_BATCH_OVERRIDE
+//
+// File: BoneGeometryBatchOverride.h
+//
+// Sub-scene override that draws the wireframe of every registered bone.
+// World-space edges are gathered into one line buffer per colour and depth priority, so the draw call count follows the number of buckets rather than bones.
+// Bones only regenerate their edges when their shape, world matrix or appearance changes, and only the affected buckets are re-uploaded.
+// Changes are tracked through the registry revisions and through matrix, attribute and scene callbacks, so an unchanged scene is never walked.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometry.h"
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryData.h"
+#include "BoneGeometryDrawData.h"
+#include "BoneTopology.h"
+#include "BoneGenerator.h"
+#include "Drawable.h"
+#include "BoneGeometryStats.h"
+#include "BoneGeometryTrace.h"
+#include "BoneGeometryAllocations.h"
+#include "ScratchArena.h"
+
+#include <maya/MPxSubSceneOverride.h>
+#include <maya/MObject.h>
+#include <maya/MDagPath.h>
+#include <maya/MDagPathArray.h>
+#include <maya/MMatrix.h>
+#include <maya/MPointArray.h>
+#include <maya/MBoundingBox.h>
+#include <maya/MColor.h>
+#include <maya/MString.h>
+#include <maya/MPlug.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MCallbackIdArray.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MDagMessage.h>
+
+#include <maya/MViewport2Renderer.h>
+#include <maya/MFrameContext.h>
+#include <maya/MHWGeometry.h>
+#include <maya/MShaderManager.h>
+
+#include <map>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <atomic>
+#include <mutex>
+
+
+class BoneGeometryBatchOverride : public MHWRender::MPxSubSceneOverride
+{
+
+public:
+
+								BoneGeometryBatchOverride(const MObject& node);
+	virtual						~BoneGeometryBatchOverride();
+
+	static	MPxSubSceneOverride*	creator(const MObject& node);
+
+	virtual	MHWRender::DrawAPI	supportedDrawAPIs() const;
+
+	virtual	bool				requiresUpdate(const MHWRender::MSubSceneContainer& container, const MHWRender::MFrameContext& frameContext) const;
+	virtual	void				update(MHWRender::MSubSceneContainer& container, const MHWRender::MFrameContext& frameContext);
+
+	static	bool				isWireframe(const MHWRender::MFrameContext& frameContext);
+
+protected:
+
+	typedef	std::tuple<float, float, float, float, unsigned int>		BucketKey;
+
+	enum Change : unsigned int
+	{
+
+		kNoChanges = 0,
+		kBonesChanged = 1 << 0,
+		kAppearanceChanged = 1 << 1,
+		kDagChanged = 1 << 2
+
+	};
+
+	enum SlotState : unsigned char
+	{
+
+		kSlotClean = 0,
+		kSlotDirty = 1 << 0,
+		kSlotRewatch = 1 << 1,
+		kSlotReplaced = 1 << 2
+
+	};
+
+	struct Instance
+	{
+
+		unsigned long long		revision = 0;
+		MMatrix					matrix;
+		BucketKey				bucket;
+		std::vector<float>		positions;
+		bool					visited = false;
+
+	};
+
+	struct Ancestor;
+
+	struct Slot
+	{
+
+		BoneGeometryBatchOverride*			owner = nullptr;
+		unsigned int						index = 0;
+		BoneGeometry*						boneGeometry = nullptr;
+		BoneGeometryRegistry::Handle		handle;
+		BoneGeometryRegistry::Bone			shape;
+		std::map<unsigned int, Instance>	instances;
+		MCallbackIdArray					callbackIds;
+		std::vector<Ancestor*>				ancestors;
+
+	};
+
+	struct Ancestor
+	{
+
+		BoneGeometryBatchOverride*			owner = nullptr;
+		MObjectHandle						node;
+		unsigned int						hashCode = 0;
+		MCallbackId							callbackId = 0;
+		std::vector<unsigned int>			slots;
+
+	};
+
+	struct Bucket
+	{
+
+		MString										name;
+		bool										dirty = true;
+		unsigned int								numVertices = 0;
+		MHWRender::MShaderInstance*					shader = nullptr;
+		std::unique_ptr<MHWRender::MVertexBuffer>	positionBuffer;
+		std::unique_ptr<MHWRender::MIndexBuffer>	indexBuffer;
+
+	};
+
+	struct Gather
+	{
+
+		float*					positions = nullptr;
+		size_t					size = 0;
+
+	};
+
+	typedef	std::map<BucketKey, Gather, std::less<BucketKey>, ScratchArena::Allocator<std::pair<const BucketKey, Gather>>>	GatherMap;
+
+			bool				updateInstances();
+			bool				updateSlot(Slot& slot, const bool rewatch);
+			bool				removeInstances(Slot& slot);
+			void				watchSlot(Slot& slot, const MDagPathArray& dagPaths);
+			void				watchAncestor(Slot& slot, const MObject& node);
+			void				unwatchSlot(Slot& slot);
+			void				markSlot(const unsigned int index);
+			void				markChanges(const unsigned int changes);
+			void				updateBucket(MHWRender::MSubSceneContainer& container, const BucketKey& key, Bucket& bucket, const float* positions, const size_t size);
+			void				removeBucket(MHWRender::MSubSceneContainer& container, Bucket& bucket);
+			void				enableBuckets(MHWRender::MSubSceneContainer& container, const bool enabled);
+			void				clear(MHWRender::MSubSceneContainer& container);
+
+	static	void				onBoneAttributeChanged(MNodeMessage::AttributeMessage message, MPlug& plug, MPlug& otherPlug, void* clientData);
+	static	void				onAncestorAttributeChanged(MNodeMessage::AttributeMessage message, MPlug& plug, MPlug& otherPlug, void* clientData);
+	static	void				onWorldMatrixModified(MObject& transformNode, MDagMessage::MatrixModifiedFlags& modified, void* clientData);
+	static	void				onDagChanged(MDagMessage::DagMessage message, MDagPath& child, MDagPath& parent, void* clientData);
+	static	void				onAppearanceChanged(void* clientData);
+
+			std::vector<BoneGeometry*>				bones;
+			std::vector<std::unique_ptr<Slot>>		slots;
+			std::vector<unsigned char>				slotStates;
+			std::multimap<unsigned int, Ancestor>	ancestors;
+			std::map<BucketKey, Bucket>				buckets;
+			MCallbackIdArray						eventCallbackIds;
+			std::mutex								markedMutex;
+			std::vector<unsigned int>				markedSlots;
+			std::vector<unsigned int>				syncSlots;
+			std::atomic<unsigned int>				changes;
+			unsigned long long						registryRevision;
+			unsigned long long						batchRevision;
+			MObject									batchNode;
+			unsigned int							bucketCount;
+			bool									enabled;
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,332 @@
+//
+// File: BoneGeometryCameraWatch.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryCameraWatch.h"
+#include "BoneGeometry.h"
+#include "BoneGeometryDirtyQueue.h"
+#include "BoneGeometryStats.h"
+
+#include <maya/M3dView.h>
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagPath.h>
+#include <maya/MEventMessage.h>
+#include <maya/MGlobal.h>
+#include <maya/MMatrix.h>
+#include <maya/MStringArray.h>
+#include <maya/MUiMessage.h>
+#include <maya/MViewport2Renderer.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+
+namespace
+{
+
+	struct Panel
+	{
+
+		MCallbackId		callbackId = 0;
+		bool			isSeen = false;
+		double			viewProjection[4][4] = {};
+		int				width = 0;
+		int				height = 0;
+
+	};
+
+	const char* PANEL_EVENTS[] = { "modelEditorChanged", "ModelPanelSetFocus", "SceneOpened", "NewSceneOpened" };
+
+	std::mutex mutex;
+	std::set<BoneGeometry*> bones;
+
+	std::map<std::string, Panel> panels;
+	MCallbackIdArray eventCallbackIds;
+
+	size_t dirtyBones()
+	/**
+	Dirties the draw of every watched bone so each one picks its level of detail again.
+	This must be called from the main thread.
+
+	@return: The number of bones dirtied.
+	*/
+	{
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (BoneGeometry* boneGeometry : bones)
+		{
+
+			MHWRender::MRenderer::setGeometryDrawDirty(boneGeometry->thisMObject(), false);
+
+		}
+
+		BoneGeometryStats::add(BoneGeometryStats::kGeometryDrawDirty, bones.size());
+		BoneGeometryStats::add(BoneGeometryStats::kCameraChanges);
+
+		return bones.size();
+
+	};
+
+	void onPreRender(const MString& panelName, void* clientData)
+	/**
+	Callback function used to compare a model panel's camera against the last time it rendered.
+	The bones are dirtied before the panel draws, so the new level of detail is picked up by this same refresh.
+	The batch node's visibility is checked here as well, see BoneGeometryBatch::updateVisibility().
+	Any bone still in the dirty queue is flushed first, this covers edits that were not driven by a time change.
+
+	@param panelName: The name of the panel about to render.
+	@param clientData: Unused.
+	@return: Void.
+	*/
+	{
+
+		MStatus status;
+
+		BoneGeometryDirtyQueue::flush();
+		BoneGeometryBatch::updateVisibility();
+
+		M3dView view;
+		status = M3dView::getM3dViewFromModelPanel(panelName, view);
+
+		if (!status)
+		{
+
+			return;
+
+		}
+
+		// Gather the view state
+		//
+		MDagPath camera;
+		status = view.getCamera(camera);
+
+		if (!status)
+		{
+
+			return;
+
+		}
+
+		MMatrix projection;
+		view.projectionMatrix(projection);
+
+		double viewProjection[4][4];
+		(camera.inclusiveMatrixInverse() * projection).get(viewProjection);
+
+		int width = view.portWidth();
+		int height = view.portHeight();
+
+		// Compare against the previous render
+		//
+		auto found = panels.find(panelName.asChar());
+
+		if (found == panels.end())
+		{
+
+			return;
+
+		}
+
+		Panel& panel = found->second;
+
+		if (panel.isSeen && panel.width == width && panel.height == height && std::memcmp(panel.viewProjection, viewProjection, sizeof(viewProjection)) == 0)
+		{
+
+			return;
+
+		}
+
+		std::memcpy(panel.viewProjection, viewProjection, sizeof(viewProjection));
+		panel.width = width;
+		panel.height = height;
+		panel.isSeen = true;
+
+		dirtyBones();
+
+	};
+
+	void updatePanels(void* clientData)
+	/**
+	Callback function used to follow model panels as they are created and deleted.
+	Each model panel gets a pre-render callback, panels that no longer exist have theirs removed.
+
+	@param clientData: Unused.
+	@return: Void.
+	*/
+	{
+
+		MStatus status;
+
+		MStringArray panelNames;
+		status = MGlobal::executeCommand("getPanel -type \"modelPanel\";", panelNames);
+
+		if (!status)
+		{
+
+			return;
+
+		}
+
+		// Add callbacks to new panels
+		//
+		std::set<std::string> names;
+
+		for (unsigned int i = 0; i < panelNames.length(); i++)
+		{
+
+			std::string name = panelNames[i].asChar();
+			names.insert(name);
+
+			if (panels.count(name) != 0)
+			{
+
+				continue;
+
+			}
+
+			MCallbackId callbackId = MUiMessage::add3dViewPreRenderMsgCallback(panelNames[i], onPreRender, nullptr, &status);
+
+			if (status)
+			{
+
+				panels[name].callbackId = callbackId;
+
+			}
+
+		}
+
+		// Remove callbacks from deleted panels
+		//
+		for (auto iter = panels.begin(); iter != panels.end();)
+		{
+
+			if (names.count(iter->first) == 0)
+			{
+
+				MMessage::removeCallback(iter->second.callbackId);
+				iter = panels.erase(iter);
+
+			}
+			else
+			{
+
+				iter++;
+
+			}
+
+		}
+
+	};
+
+};
+
+
+void BoneGeometryCameraWatch::watch(BoneGeometry* boneGeometry, const bool isWatched)
+/**
+Adds or removes the supplied bone from the bones dirtied on a camera change.
+Bones must stop being watched before they are deleted.
+
+@param boneGeometry: The bone to update.
+@param isWatched: If true, the bone is dirtied whenever a camera changes.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (isWatched)
+	{
+
+		bones.insert(boneGeometry);
+
+	}
+	else
+	{
+
+		bones.erase(boneGeometry);
+
+	}
+
+};
+
+
+size_t BoneGeometryCameraWatch::size()
+/**
+Returns the number of watched bones.
+
+@return: size_t
+*/
+{
+
+	std::lock_guard<std::mutex> lock(mutex);
+	return bones.size();
+
+};
+
+
+MStatus BoneGeometryCameraWatch::addCallbacks()
+/**
+Adds a pre-render callback to every model panel, the panels are scanned again whenever the panel layout may have changed.
+Does nothing in batch mode where there are no panels.
+
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	if (!MGlobal::isInteractive())
+	{
+
+		return MS::kSuccess;
+
+	}
+
+	for (const char* eventName : PANEL_EVENTS)
+	{
+
+		MCallbackId callbackId = MEventMessage::addEventCallback(eventName, updatePanels, nullptr, &status);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		eventCallbackIds.append(callbackId);
+
+	}
+
+	updatePanels(nullptr);
+
+	return MS::kSuccess;
+
+};
+
+
+MStatus BoneGeometryCameraWatch::removeCallbacks()
+/**
+Removes the callbacks added by addCallbacks().
+
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	for (auto& panel : panels)
+	{
+
+		MMessage::removeCallback(panel.second.callbackId);
+
+	}
+
+	panels.clear();
+
+	status = MMessage::removeCallbacks(eventCallbackIds);
+	eventCallbackIds.clear();
+
+	return status;
+
+};
\ No newline at end of file
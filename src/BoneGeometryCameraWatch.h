@@ -0,0 +1,32 @@
+#ifndef _BONE_GEOMETRY_CAMERA_WATCH
+#define _BONE_GEOMETRY_CAMERA_WATCH
+//
+// File: BoneGeometryCameraWatch.h
+//
+// Dirties the draw of level of detail enabled bones whenever a model panel's camera, projection or size changes.
+// The draw override is not always dirty, so without this a bone would keep the level it picked until the node itself changed.
+// Every model panel is checked just before it renders, bones that do not use level of detail are never touched.
+// The same check also notices when the batch node is shown or hidden and flushes any bones left in the dirty queue.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <maya/MStatus.h>
+
+#include <cstddef>
+
+
+class BoneGeometry;
+
+
+namespace BoneGeometryCameraWatch
+{
+
+	void		watch(BoneGeometry* boneGeometry, const bool isWatched);
+	size_t		size();
+
+	MStatus		addCallbacks();
+	MStatus		removeCallbacks();
+
+};
+#endif
\ No newline at end of file
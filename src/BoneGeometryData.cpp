@@ -6,8 +6,10 @@
 
 #include "BoneGeometryData.h"
 
+#include <algorithm>
 
-BoneGeometryData::BoneGeometryData() : MUserData(false)
+
+BoneGeometryData::BoneGeometryData()
 /**
 Constructor.
 */
@@ -38,146 +40,217 @@ Constructor.
 	this->backFinStartTaper = 0.1;
 	this->backFinEndTaper = 0.1;
 
-	this->wireColor = MColor();
-	this->depthPriority = 0;
+	this->levelOfDetail = false;
+	this->wireThreshold = 16.0;
+	this->lineThreshold = 4.0;
+	this->hideThreshold = 1.0;
+
+	this->revision = 0;
+	this->handle = BoneGeometryRegistry::acquire();
+	this->dirtyBoundingBox();
 
 };
 
 
-BoneGeometryData::~BoneGeometryData() {};
+BoneGeometryData::~BoneGeometryData()
+/**
+Destructor.
+*/
+{
+
+	BoneGeometryRegistry::release(this->handle);
+
+};
 
 
-BoneGeometryData& BoneGeometryData::operator=(const BoneGeometryData* src)
+BoneGeometryData& BoneGeometryData::operator=(const BoneGeometryData& other)
 /**
 Assignment operator.
+Every value is copied except the registry handle, this bone keeps its own slot and republishes the copied shape to it.
+The revision is bumped so anything drawing this bone rebuilds.
 
-@param src: Point helper data to be copied.
-@return: Self.
+@param other: The bone geometry data to copy.
+@return: BoneGeometryData
 */
 {
 
-	this->localPosition = src->localPosition;
-	this->localRotate = src->localRotate;
-	this->localScale = src->localScale;
+	if (this == &other)
+	{
+
+		return *this;
+
+	}
+
+	this->localPosition = other.localPosition;
+	this->localRotate = other.localRotate;
+	this->localScale = other.localScale;
+	this->objectMatrix = other.objectMatrix;
+	this->boundingBox = other.boundingBox;
+
+	this->width = other.width;
+	this->height = other.height;
+	this->length = other.length;
+	this->taper = other.taper;
 
-	this->width = src->width;
-	this->height = src->height;
-	this->length = src->length;
-	this->taper = src->taper;
+	this->sideFins = other.sideFins;
+	this->sideFinsSize = other.sideFinsSize;
+	this->sideFinsStartTaper = other.sideFinsStartTaper;
+	this->sideFinsEndTaper = other.sideFinsEndTaper;
 
-	this->sideFins = src->sideFins;
-	this->sideFinsSize = src->sideFinsSize;
-	this->sideFinsStartTaper = src->sideFinsStartTaper;
-	this->sideFinsEndTaper = src->sideFinsEndTaper;
+	this->frontFin = other.frontFin;
+	this->frontFinSize = other.frontFinSize;
+	this->frontFinStartTaper = other.frontFinStartTaper;
+	this->frontFinEndTaper = other.frontFinEndTaper;
 
-	this->frontFin = src->frontFin;
-	this->frontFinSize = src->frontFinSize;
-	this->frontFinStartTaper = src->frontFinStartTaper;
-	this->frontFinEndTaper = src->frontFinEndTaper;
+	this->backFin = other.backFin;
+	this->backFinSize = other.backFinSize;
+	this->backFinStartTaper = other.backFinStartTaper;
+	this->backFinEndTaper = other.backFinEndTaper;
 
-	this->backFin = src->backFin;
-	this->backFinSize = src->backFinSize;
-	this->backFinStartTaper = src->backFinStartTaper;
-	this->backFinEndTaper = src->backFinEndTaper;
+	this->levelOfDetail = other.levelOfDetail;
+	this->wireThreshold = other.wireThreshold;
+	this->lineThreshold = other.lineThreshold;
+	this->hideThreshold = other.hideThreshold;
 
-	this->wireColor = src->wireColor;
-	this->depthPriority = src->depthPriority;
+	this->shapeKey = other.shapeKey;
+	this->revision = std::max(this->revision, other.revision) + 1;
+
+	this->publish();
 
 	return *this;
 
 };
 
 
-MStatus BoneGeometryData::copyWireColor(const MDagPath& dagPath)
+void BoneGeometryData::dirtyObjectMatrix()
 /**
-Caches the wire-colour from the supplied dag path.
+Updates the internal object-matrix.
 
-@param dagPath: A path to the point helper.
-@return: Return status.
+@return: Null.
 */
 {
 
-	MStatus status;
+	MMatrix positionMatrix = Drawable::createPositionMatrix(this->localPosition);
+	MMatrix rotateMatrix = Drawable::createRotationMatrix(this->localRotate);
+	MMatrix scaleMatrix = Drawable::createScaleMatrix(this->localScale);
+
+	this->objectMatrix = scaleMatrix * rotateMatrix * positionMatrix;
+	this->dirtyBoundingBox();
+
+};
 
-	// Check if path is valid
-	//
-	bool isValid = dagPath.isValid(&status);
-	CHECK_MSTATUS_AND_RETURN_IT(status);
 
-	if (!isValid)
+void BoneGeometryData::dirtyBoundingBox()
+/**
+Updates the internal bounding box from the drawn points, see drawnShape().
+This should be called whenever the shape or object-matrix changes, the revision is bumped so draw overrides know to rebuild their buffers.
+The new shape is also published to this bone's registry slot.
+Nothing is bumped when the shape key is unchanged, so restoring the same values, as cached playback does every frame, never dirties the draw buffers.
+
+@return: Null.
+*/
+{
+
+	PreparedGeometryCache::Key shapeKey = this->drawnShape();
+
+	if (shapeKey == this->shapeKey)
 	{
 
-		return MS::kFailure;
+		return;
 
 	}
 
-	// Evaluate wire color
-	//
-	this->wireColor = MHWRender::MGeometryUtilities::wireframeColor(dagPath);
-	return MS::kSuccess;
+	this->shapeKey = shapeKey;
+
+	double min[3], max[3];
+	BoneGenerator::bounds(shapeKey.finMask, shapeKey.parameters, shapeKey.matrix, min, max);
+
+	this->boundingBox = MBoundingBox(MPoint(min[0], min[1], min[2]), MPoint(max[0], max[1], max[2]));
+	this->revision++;
+
+	this->publish();
 
 };
 
 
-MStatus BoneGeometryData::copyDepthPriority(const MDagPath& dagPath)
+unsigned int BoneGeometryData::finMask() const
 /**
-Caches the depth priority from the supplied dag path.
+Returns the fin configuration as a combination of BoneTopology::FinMask flags.
 
-@param dagPath: A path to the point helper.
-@return: Return status.
+@return: unsigned int
 */
 {
 
-	MStatus status;
+	return (this->sideFins ? static_cast<unsigned int>(BoneTopology::kSideFins) : 0u) | (this->frontFin ? static_cast<unsigned int>(BoneTopology::kFrontFin) : 0u) | (this->backFin ? static_cast<unsigned int>(BoneTopology::kBackFin) : 0u);
 
-	// Check if path is valid
-	//
-	bool isValid = dagPath.isValid(&status);
-	CHECK_MSTATUS_AND_RETURN_IT(status);
+};
 
-	if (!isValid)
-	{
 
-		return MS::kFailure;
+PreparedGeometryCache::Key BoneGeometryData::drawnShape() const
+/**
+Returns the shape that is actually drawn.
+Only the body is drawn and it is drawn in bone space, the fin attributes and the object-matrix are stored but do not change what is drawn.
+The fin values are zeroed so editing a fin never makes an identical body look like a new shape.
 
-	}
+@return: PreparedGeometryCache::Key
+*/
+{
 
-	// Evaluate display status
-	//
-	MHWRender::DisplayStatus displayStatus = MHWRender::MGeometryUtilities::displayStatus(dagPath);
+	BoneGenerator::BoneParameters parameters = this->parameters();
+	parameters.sideFins = { 0.0, 0.0, 0.0 };
+	parameters.frontFin = { 0.0, 0.0, 0.0 };
+	parameters.backFin = { 0.0, 0.0, 0.0 };
 
-	switch (displayStatus)
-	{
+	return PreparedGeometryCache::Key(BoneTopology::kNoFins, parameters, MMatrix::identity.matrix);
 
-	case MHWRender::DisplayStatus::kActiveComponent:
+};
 
-		this->depthPriority = MHWRender::MRenderItem::sActiveWireDepthPriority;
-		break;
 
-	default:
+BoneGenerator::BoneParameters BoneGeometryData::parameters() const
+/**
+Returns the shape parameters consumed by the bone generators.
 
-		this->depthPriority = MHWRender::MRenderItem::sDormantFilledDepthPriority;
-		break;
+@return: BoneGenerator::BoneParameters
+*/
+{
 
-	}
+	BoneGenerator::BoneParameters parameters;
+	parameters.width = this->width;
+	parameters.height = this->height;
+	parameters.length = this->length;
+	parameters.taper = this->taper;
+	parameters.sideFins = { this->sideFinsSize, this->sideFinsStartTaper, this->sideFinsEndTaper };
+	parameters.frontFin = { this->frontFinSize, this->frontFinStartTaper, this->frontFinEndTaper };
+	parameters.backFin = { this->backFinSize, this->backFinStartTaper, this->backFinEndTaper };
 
-	return MS::kSuccess;
+	return parameters;
 
 };
 
 
-void BoneGeometryData::dirtyObjectMatrix()
+void BoneGeometryData::publish()
 /**
-Updates the internal object-matrix.
+Copies the drawn shape, bounds and revision into this bone's registry slot.
 
 @return: Null.
 */
 {
 
-	MMatrix positionMatrix = Drawable::createPositionMatrix(this->localPosition);
-	MMatrix rotateMatrix = Drawable::createRotationMatrix(this->localRotate);
-	MMatrix scaleMatrix = Drawable::createScaleMatrix(this->localScale);
+	BoneGeometryRegistry::Bone bone;
+	bone.finMask = this->shapeKey.finMask;
+	bone.parameters = this->shapeKey.parameters;
+	bone.revision = this->revision;
 
-	this->objectMatrix = scaleMatrix * rotateMatrix * positionMatrix;
+	MPoint min = this->boundingBox.min();
+	MPoint max = this->boundingBox.max();
+
+	bone.min[0] = min.x;
+	bone.min[1] = min.y;
+	bone.min[2] = min.z;
+	bone.max[0] = max.x;
+	bone.max[1] = max.y;
+	bone.max[2] = max.z;
+
+	BoneGeometryRegistry::update(this->handle, bone);
 
 };
\ No newline at end of file
@@ -3,12 +3,19 @@
 //
 // File: BoneGeometryData.h
 //
+// Shape and level of detail state owned by each bone geometry node.
+// Per-draw state lives in BoneGeometryDrawData so prepareForDraw() never needs to copy this.
+//
 // Author: Ben Singleton
 //
 
 #include "Drawable.h"
+#include "BoneTopology.h"
+#include "BoneGenerator.h"
+#include "LevelOfDetail.h"
+#include "PreparedGeometryCache.h"
+#include "BoneGeometryRegistry.h"
 
-#include <maya/MUserData.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
 #include <maya/MPointArray.h>
@@ -16,6 +23,7 @@
 #include <maya/MVectorArray.h>
 #include <maya/MEulerRotation.h>
 #include <maya/MMatrix.h>
+#include <maya/MBoundingBox.h>
 #include <maya/MFnMatrixData.h>
 #include <maya/MColor.h>
 #include <maya/MString.h>
@@ -35,20 +43,26 @@
 #include <map>
 
 
-class BoneGeometryData : public MUserData
+class BoneGeometryData
 {
 
 public:
 
 								BoneGeometryData();
+								BoneGeometryData(const BoneGeometryData&) = delete;
 	virtual						~BoneGeometryData();
 
-	virtual	BoneGeometryData&	operator=(const BoneGeometryData* src);
-
-	virtual	MStatus				copyWireColor(const MDagPath& dagPath);
-	virtual	MStatus				copyDepthPriority(const MDagPath& dagPath);
+			BoneGeometryData&	operator=(const BoneGeometryData& other);
 
 	virtual	void				dirtyObjectMatrix();
+	virtual	void				dirtyBoundingBox();
+	virtual	unsigned int		finMask() const;
+	virtual	BoneGenerator::BoneParameters	parameters() const;
+	virtual	PreparedGeometryCache::Key	drawnShape() const;
+
+protected:
+
+			void				publish();
 
 public:
 			
@@ -56,6 +70,7 @@ public:
 			MVector				localRotate;
 			MVector				localScale;
 			MMatrix				objectMatrix;
+			MBoundingBox		boundingBox;
 
 			double				width;
 			double				height;
@@ -77,8 +92,15 @@ public:
 			double				backFinStartTaper;
 			double				backFinEndTaper;
 
-			MColor				wireColor;
-			unsigned int		depthPriority;
+			bool				levelOfDetail;
+			double				wireThreshold;
+			double				lineThreshold;
+			double				hideThreshold;
+
+			PreparedGeometryCache::Key	shapeKey;
+			unsigned long long	revision;
+
+			BoneGeometryRegistry::Handle	handle;
 
 };
 
@@ -0,0 +1,233 @@
+//
+// File: BoneGeometryDirtyQueue.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryDirtyQueue.h"
+#include "BoneGeometry.h"
+#include "BoneGeometryStats.h"
+
+#include <maya/MDGMessage.h>
+#include <maya/MViewport2Renderer.h>
+
+
+namespace
+{
+
+	std::atomic<BoneGeometry*> head{ nullptr };
+
+	MCallbackId forceUpdateCallbackId = 0;
+
+	void pushChain(BoneGeometry* first, BoneGeometry* last)
+	/**
+	Prepends a chain of already linked bones to the queue.
+
+	@param first: The first bone in the chain.
+	@param last: The last bone in the chain, its link is overwritten.
+	@return: Void.
+	*/
+	{
+
+		BoneGeometry* expected = head.load(std::memory_order_relaxed);
+
+		do
+		{
+
+			last->dirtyLink.next = expected;
+
+		} while (!head.compare_exchange_weak(expected, first, std::memory_order_release, std::memory_order_relaxed));
+
+	};
+
+	void onForceUpdate(MTime& time, void* clientData)
+	/**
+	Callback function used to flush the queue once every node has been evaluated for a new time.
+
+	@param time: The new time.
+	@param clientData: Unused.
+	@return: Void.
+	*/
+	{
+
+		BoneGeometryDirtyQueue::flush();
+
+	};
+
+};
+
+
+void BoneGeometryDirtyQueue::push(BoneGeometry* boneGeometry)
+/**
+Queues the supplied bone to be dirtied on the next flush, this is safe to call from any evaluation thread.
+A bone that is already queued is left as is.
+
+@param boneGeometry: The bone to dirty.
+@return: Void.
+*/
+{
+
+	unsigned int previous = boneGeometry->dirtyLink.state.fetch_or(kQueued, std::memory_order_acq_rel);
+
+	if (previous & kQueued)
+	{
+
+		return;
+
+	}
+
+	pushChain(boneGeometry, boneGeometry);
+
+};
+
+
+size_t BoneGeometryDirtyQueue::flush()
+/**
+Dirties the draw of every queued bone and empties the queue.
+This must be called from the main thread.
+
+@return: The number of bones dirtied.
+*/
+{
+
+	BoneGeometry* boneGeometry = head.exchange(nullptr, std::memory_order_acquire);
+
+	if (boneGeometry == nullptr)
+	{
+
+		return 0;
+
+	}
+
+	size_t count = 0;
+
+	while (boneGeometry != nullptr)
+	{
+
+		// Read the link before releasing the bone, it may be queued again as soon as its state is cleared
+		//
+		BoneGeometry* next = boneGeometry->dirtyLink.next;
+		boneGeometry->dirtyLink.state.store(kNone, std::memory_order_release);
+
+		MHWRender::MRenderer::setGeometryDrawDirty(boneGeometry->thisMObject(), false);
+
+		boneGeometry = next;
+		count++;
+
+	}
+
+	BoneGeometryStats::add(BoneGeometryStats::kGeometryDrawDirty, count);
+	BoneGeometryStats::add(BoneGeometryStats::kDirtyQueueFlushes);
+
+	return count;
+
+};
+
+
+void BoneGeometryDirtyQueue::remove(BoneGeometry* boneGeometry)
+/**
+Removes the supplied bone from the queue so it can be safely deleted.
+This must be called from the main thread while nothing is being evaluated.
+
+@param boneGeometry: The bone to remove.
+@return: Void.
+*/
+{
+
+	if (!(boneGeometry->dirtyLink.state.load(std::memory_order_acquire) & kQueued))
+	{
+
+		return;
+
+	}
+
+	// Take the whole queue and relink everything except the supplied bone
+	//
+	BoneGeometry* current = head.exchange(nullptr, std::memory_order_acquire);
+	BoneGeometry* first = nullptr;
+	BoneGeometry* last = nullptr;
+
+	while (current != nullptr)
+	{
+
+		BoneGeometry* next = current->dirtyLink.next;
+
+		if (current != boneGeometry)
+		{
+
+			if (last == nullptr)
+			{
+
+				first = current;
+
+			}
+			else
+			{
+
+				last->dirtyLink.next = current;
+
+			}
+
+			last = current;
+
+		}
+
+		current = next;
+
+	}
+
+	boneGeometry->dirtyLink.state.store(kNone, std::memory_order_release);
+	boneGeometry->dirtyLink.next = nullptr;
+
+	if (first != nullptr)
+	{
+
+		pushChain(first, last);
+
+	}
+
+};
+
+
+MStatus BoneGeometryDirtyQueue::addCallbacks()
+/**
+Flushes the queue after every time change.
+Anything dirtied outside of a time change, such as interactive edits under the Evaluation Manager, is flushed before the next model panel renders, see BoneGeometryCameraWatch.h.
+
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	forceUpdateCallbackId = MDGMessage::addForceUpdateCallback(onForceUpdate, nullptr, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	return status;
+
+};
+
+
+MStatus BoneGeometryDirtyQueue::removeCallbacks()
+/**
+Removes the callbacks added by addCallbacks() after a final flush.
+
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	BoneGeometryDirtyQueue::flush();
+
+	if (forceUpdateCallbackId != 0)
+	{
+
+		status = MMessage::removeCallback(forceUpdateCallbackId);
+		forceUpdateCallbackId = 0;
+
+	}
+
+	return status;
+
+};
\ No newline at end of file
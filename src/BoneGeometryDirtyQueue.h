@@ -0,0 +1,51 @@
+#ifndef _BONE_GEOMETRY_DIRTY_QUEUE
+#define _BONE_GEOMETRY_DIRTY_QUEUE
+//
+// File: BoneGeometryDirtyQueue.h
+//
+// Lock-free queue of bones whose draw was dirtied during evaluation.
+// Evaluation threads push bones through a link embedded in each node so queueing never allocates or blocks, a bone is only queued once per flush.
+// The queue is flushed on the main thread once evaluation completes, making every setGeometryDrawDirty() call in a single pass.
+// Flushes only ever run from callbacks that are removed when the plugin unloads, nothing is left scheduled that could outlive it.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <maya/MStatus.h>
+#include <maya/MTime.h>
+
+#include <atomic>
+#include <cstddef>
+
+
+class BoneGeometry;
+
+
+namespace BoneGeometryDirtyQueue
+{
+
+	enum State : unsigned int
+	{
+
+		kNone = 0,
+		kQueued = 1 << 0
+
+	};
+
+	struct Link
+	{
+
+		std::atomic<unsigned int>	state{ kNone };
+		BoneGeometry*				next = nullptr;
+
+	};
+
+	void		push(BoneGeometry* boneGeometry);
+	size_t		flush();
+	void		remove(BoneGeometry* boneGeometry);
+
+	MStatus		addCallbacks();
+	MStatus		removeCallbacks();
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+//
+// File: BoneGeometryDrawData.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryDrawData.h"
+#include "BoneGeometryStats.h"
+
+#include <new>
+
+
+namespace
+{
+
+	unsigned int getDepthPriority(const MHWRender::DisplayStatus displayStatus)
+	/**
+	Returns the depth priority for the supplied display status.
+
+	@param displayStatus: The display status of the bone.
+	@return: unsigned int
+	*/
+	{
+
+		switch (displayStatus)
+		{
+
+		case MHWRender::DisplayStatus::kActiveComponent:
+
+			return MHWRender::MRenderItem::sActiveWireDepthPriority;
+
+		default:
+
+			return MHWRender::MRenderItem::sDormantFilledDepthPriority;
+
+		}
+
+	};
+
+};
+
+
+BoneGeometryDrawData::BoneGeometryDrawData() : MUserData(false), wireColor(), depthPriority(0), level(LevelOfDetail::kFull)
+/**
+Constructor.
+*/
+{
+};
+
+
+BoneGeometryDrawData::~BoneGeometryDrawData() {};
+
+
+void* BoneGeometryDrawData::operator new(size_t size)
+/**
+Allocates an instance from the shared slab pool.
+Maya deletes user data through MUserData's virtual destructor so the matching operator delete is always used.
+
+@param size: The size of the instance.
+@return: void*
+*/
+{
+
+	if (size > BoneGeometryDrawData::pool().slotSize())
+	{
+
+		throw std::bad_alloc();
+
+	}
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kUserDataBytes, static_cast<int64_t>(BoneGeometryDrawData::pool().slotSize()));
+	return BoneGeometryDrawData::pool().allocate();
+
+};
+
+
+void BoneGeometryDrawData::operator delete(void* pointer)
+/**
+Returns an instance to the shared slab pool.
+
+@param pointer: The instance to release.
+@return: Void.
+*/
+{
+
+	if (pointer == nullptr)
+	{
+
+		return;
+
+	}
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kUserDataBytes, -static_cast<int64_t>(BoneGeometryDrawData::pool().slotSize()));
+	BoneGeometryDrawData::pool().deallocate(pointer);
+
+};
+
+
+SlabPool& BoneGeometryDrawData::pool()
+/**
+Returns the pool shared by every instance.
+
+@return: SlabPool
+*/
+{
+
+	static SlabPool pool(sizeof(BoneGeometryDrawData), 1024);
+	return pool;
+
+};
+
+
+void BoneGeometryDrawData::copyAppearance(const MDagPath& dagPath)
+/**
+Caches the wire-colour and depth priority from the supplied dag path with a single validity check.
+
+@param dagPath: A path to the bone.
+@return: Void.
+*/
+{
+
+	MStatus status;
+
+	// Check if path is valid
+	//
+	bool isValid = dagPath.isValid(&status);
+
+	if (!status || !isValid)
+	{
+
+		return;
+
+	}
+
+	// Evaluate appearance
+	//
+	BoneGeometryDrawData::getAppearance(dagPath, this->wireColor, this->depthPriority);
+
+};
+
+
+void BoneGeometryDrawData::getAppearance(const MDagPath& dagPath, MColor& wireColor, unsigned int& depthPriority)
+/**
+Evaluates the wire-colour and depth priority for the supplied dag path without caching them.
+The path is expected to be valid.
+
+@param dagPath: A path to the bone.
+@param wireColor: The passed colour to populate.
+@param depthPriority: The passed depth priority to populate.
+@return: Void.
+*/
+{
+
+	wireColor = MHWRender::MGeometryUtilities::wireframeColor(dagPath);
+	depthPriority = getDepthPriority(MHWRender::MGeometryUtilities::displayStatus(dagPath));
+
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef _BONE_GEOMETRY_DRAW_DATA
+#define _BONE_GEOMETRY_DRAW_DATA
+//
+// File: BoneGeometryDrawData.h
+//
+// Compact per-draw state handed between prepareForDraw() and addUIDrawables().
+// Shape data is read straight from the node's BoneGeometryData, only the appearance and the selected level of detail are cached here.
+// Instances are carved out of a shared slab pool so prepare never reaches the general heap for them.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "LevelOfDetail.h"
+#include "SlabPool.h"
+
+#include <maya/MUserData.h>
+#include <maya/MDagPath.h>
+#include <maya/MColor.h>
+#include <maya/MStatus.h>
+
+#include <maya/MViewport2Renderer.h>
+#include <maya/MHWGeometryUtilities.h>
+
+#include <cstddef>
+
+
+class BoneGeometryDrawData : public MUserData
+{
+
+public:
+
+								BoneGeometryDrawData();
+	virtual						~BoneGeometryDrawData();
+
+	static	void*				operator new(size_t size);
+	static	void				operator delete(void* pointer);
+
+	virtual	void				copyAppearance(const MDagPath& dagPath);
+	static	void				getAppearance(const MDagPath& dagPath, MColor& wireColor, unsigned int& depthPriority);
+
+	static	SlabPool&			pool();
+
+public:
+
+			MColor				wireColor;
+			unsigned int		depthPriority;
+			LevelOfDetail::Level	level;
+
+};
+#endif
\ No newline at end of file
@@ -6,13 +6,11 @@
 
 #include "BoneGeometryDrawOverride.h"
 
-int BoneGeometryDrawOverride::POLYGON_CONNECTS[32] = { 0, 1, 2, 0, 2, 3, 0, 4, 1, 0, 3, 4, 2, 1, 5, 6, 3, 2, 6, 7, 1, 4, 8, 5, 4, 3, 7, 8, 6, 5, 8, 7 };
-int BoneGeometryDrawOverride::POLYGON_COUNTS[9] = { 3, 3, 3, 3, 4, 4, 4, 4, 4 };
 
-
-BoneGeometryDrawOverride::BoneGeometryDrawOverride(const MObject& node) : MPxDrawOverride(node, NULL, false)
+BoneGeometryDrawOverride::BoneGeometryDrawOverride(const MObject& node) : MPxDrawOverride(node, NULL, false), prepared()
 /**
 Constructor.
+Bones that use level of detail are dirtied by BoneGeometryCameraWatch whenever a camera changes, the draw buffers are only looked up again when the geometry revision changes.
 
 @param node: The Maya object this override draws.
 @param callback: The callback function to be invoked at draw time.
@@ -111,6 +109,9 @@ To explicitly mark an object as being dirty the MRenderer::setGeometryDrawDirty(
 	//
 	MHWRender::MRenderer::setGeometryDrawDirty(drawOverride->boneGeometry->thisMObject());
 
+	BoneGeometryStats::add(BoneGeometryStats::kModelEditorCallbacks);
+	BoneGeometryStats::add(BoneGeometryStats::kGeometryDrawDirty);
+
 };
 
 
@@ -179,6 +180,132 @@ This method should not be overridden if addUIDrawables() has not also been overr
 };
 
 
+void BoneGeometryDrawOverride::getPoints(const BoneGeometryData* boneGeometryData, MPointArray& points)
+/**
+Computes the drawn points for the supplied bone geometry data, see BoneGeometryData::drawnShape().
+The points are ordered as described by BoneTopology.h for the drawn fin configuration.
+
+@param boneGeometryData: The bone geometry data to build from.
+@param points: The passed array to populate.
+@return: Void.
+*/
+{
+
+	const PreparedGeometryCache::Key& shapeKey = boneGeometryData->shapeKey;
+	BoneGeometryDrawOverride::getPoints(shapeKey.finMask, shapeKey.parameters, shapeKey.matrix, points);
+
+};
+
+
+void BoneGeometryDrawOverride::getPoints(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double objectMatrix[4][4], MPointArray& points)
+/**
+Computes the points for the supplied fin configuration and shape parameters in object space.
+
+@param finMask: The fin configuration.
+@param parameters: The shape parameters.
+@param objectMatrix: The object-matrix to generate the points in.
+@param points: The passed array to populate.
+@return: Void.
+*/
+{
+
+	// Resize point array
+	//
+	unsigned int numVertices = BoneTopology::topology(finMask).numVertices;
+
+	if (points.length() != numVertices)
+	{
+
+		points.setLength(numVertices);
+		BoneGeometryAllocations::record(BoneGeometryAllocations::kPoints, numVertices * sizeof(MPoint));
+
+	}
+
+	// Generate points using the generator specialised for this fin configuration
+	//
+	BoneGenerator::generate(finMask, parameters, objectMatrix, Drawable::pointData(points));
+
+};
+
+
+void BoneGeometryDrawOverride::getGeometry(const MPointArray& points, const unsigned int finMask, MPointArray& triangles, MVectorArray& normals, MPointArray& lines)
+/**
+Populates the triangle, normal and line arrays straight from the compile-time topology tables.
+Each triangle vertex receives the flat normal of the face it belongs to.
+The passed arrays are only resized when the topology changes.
+
+@param points: The bone points from getPoints().
+@param finMask: The fin configuration the points were built with.
+@param triangles: The passed array to populate with triangle points.
+@param normals: The passed array to populate with triangle normals.
+@param lines: The passed array to populate with line segments.
+@return: Void.
+*/
+{
+
+	// Resize arrays
+	//
+	const BoneTopology::TopologyView& topology = BoneTopology::topology(finMask);
+
+	unsigned int numTriangleVertices = topology.numTriangles * 3;
+	unsigned int numLineVertices = topology.numEdges * 2;
+
+	if (triangles.length() != numTriangleVertices)
+	{
+
+		triangles.setLength(numTriangleVertices);
+		normals.setLength(numTriangleVertices);
+
+		BoneGeometryAllocations::record(BoneGeometryAllocations::kGeometry, numTriangleVertices * (sizeof(MPoint) + sizeof(MVector)), 2);
+
+	}
+
+	if (lines.length() != numLineVertices)
+	{
+
+		lines.setLength(numLineVertices);
+		BoneGeometryAllocations::record(BoneGeometryAllocations::kGeometry, numLineVertices * sizeof(MPoint));
+
+	}
+
+	// Fill arrays using the builder specialised for this fin configuration
+	//
+	BoneGenerator::buildGeometry(finMask, Drawable::pointData(points), Drawable::pointData(triangles), Drawable::vectorData(normals), Drawable::pointData(lines));
+
+};
+
+
+MObject BoneGeometryDrawOverride::createMeshData(const BoneGeometryData* boneGeometryData, MStatus* status)
+/**
+Creates a mesh data object from the supplied bone geometry data.
+Only the front faces of any fins are included so the resulting mesh remains manifold.
+
+@param boneGeometryData: The bone geometry data to build from.
+@param status: Return status.
+@return: MObject
+*/
+{
+
+	BONE_GEOMETRY_PROFILE("createMeshData", kColorD_L2, MObject::kNullObj);
+
+	MPointArray points;
+	BoneGeometryDrawOverride::getPoints(boneGeometryData, points);
+
+	const BoneTopology::TopologyView& topology = BoneTopology::topology(boneGeometryData->shapeKey.finMask);
+
+	MIntArray polygonCounts = MIntArray(topology.polygonCounts, topology.numMeshPolygons);
+	MIntArray polygonConnects = MIntArray(topology.polygonConnects, topology.numMeshFaceVertices);
+	MIntArray edgeSmoothings = MIntArray(topology.numEdges, 0);
+
+	// The three index arrays and the mesh data object itself, the points were recorded by getPoints()
+	//
+	BoneGeometryAllocations::record(BoneGeometryAllocations::kMeshData, (topology.numMeshPolygons + topology.numMeshFaceVertices + topology.numEdges) * sizeof(int), 4);
+
+	return Drawable::createMeshData(points, polygonCounts, polygonConnects, edgeSmoothings, status);
+
+};
+
+
 MUserData* BoneGeometryDrawOverride::prepareForDraw(const MDagPath& objPath, const MDagPath& cameraPath, const MHWRender::MFrameContext& frameContext, MUserData* userData)
 /**
 Called by Maya whenever the object is dirty and needs to update for draw.
@@ -193,65 +320,127 @@ It is invalid to pull data from the Maya dependency graph in the draw callback m
 */
 {
 
-	MStatus status;
+	BONE_GEOMETRY_PROFILE("prepareForDraw", kColorD_L1, objPath.node());
+	BoneGeometryTrace::Scope trace("BoneGeometryDrawOverride::prepareForDraw");
+
+	BoneGeometryStats::add(BoneGeometryStats::kPrepareForDraw);
+	this->boneGeometry->stats.prepareForDraw.fetch_add(1, std::memory_order_relaxed);
 
-	// Check if an instance of PointHelperData exists
+	// Check if an instance of BoneGeometryDrawData exists, new instances come from a slab pool
 	//
-	BoneGeometryData* boneGeometryData = dynamic_cast<BoneGeometryData*>(userData);
+	BoneGeometryDrawData* drawData = dynamic_cast<BoneGeometryDrawData*>(userData);
 
-	if (boneGeometryData == nullptr)
+	if (drawData == nullptr)
 	{
 
-		boneGeometryData = new BoneGeometryData();
+		drawData = new BoneGeometryDrawData();
 
 	}
 
-	// Cache internal values
+	// Shape data is read straight from the node, only the appearance is cached
+	// The appearance is cached separately so selection changes alone never rebuild the draw buffers below
 	//
-	*boneGeometryData = this->boneGeometry->getUserData();
-	boneGeometryData->copyWireColor(objPath);
-	boneGeometryData->copyDepthPriority(objPath);
+	const BoneGeometryData* boneGeometryData = this->boneGeometry->getUserData();
+	drawData->copyAppearance(objPath);
 
-	// Compute mesh points
+	// Select level of detail from the projected size
 	//
-	double width = boneGeometryData->width;
-	double height = boneGeometryData->height;
-	double taper = boneGeometryData->taper;
-
-	double minLength = (width > height) ? width : height;
-	double length = boneGeometryData->length > minLength ? boneGeometryData->length : minLength;
-
-	MMatrix baseMatrix = Drawable::createScaleMatrix(width, height, width);
-	MMatrix taperMatrix = Drawable::createScaleMatrix((length * 2.0), (1.0 - taper), (1.0 - taper));
-	MMatrix objectMatrix = boneGeometryData->objectMatrix;
-
-	MPointArray points = MPointArray(9, MPoint::origin);
-	points[0] = MPoint(0.0, 0.0, 0.0);
-	points[1] = MPoint(0.5, -0.5, 0.5) * baseMatrix * objectMatrix;
-	points[2] = MPoint(0.5, 0.5, 0.5) * baseMatrix * objectMatrix;
-	points[3] = MPoint(0.5, 0.5, -0.5) * baseMatrix * objectMatrix;
-	points[4] = MPoint(0.5, -0.5, -0.5) * baseMatrix * objectMatrix;
-	points[5] = MPoint(0.5, -0.5, 0.5) * taperMatrix * objectMatrix;
-	points[6] = MPoint(0.5, 0.5, 0.5) * taperMatrix * objectMatrix;
-	points[7] = MPoint(0.5, 0.5, -0.5) * taperMatrix * objectMatrix;
-	points[8] = MPoint(0.5, -0.5, -0.5) * taperMatrix * objectMatrix;
-
-	// Create mesh data
+	{
+
+		BONE_GEOMETRY_PROFILE("getLevelOfDetail", kColorD_L2, objPath.node());
+		drawData->level = BoneGeometryDrawOverride::getLevelOfDetail(boneGeometryData, objPath, frameContext);
+
+	}
+
+	// Wireframe-only frames are drawn by the batch sub-scene override when one exists
 	//
-	MIntArray polygonCounts = MIntArray(BoneGeometryDrawOverride::POLYGON_COUNTS, 9);
-	MIntArray polygonConnects = MIntArray(BoneGeometryDrawOverride::POLYGON_CONNECTS, 32);
-	MIntArray edgeSmoothings = MIntArray(16, 0);
+	if (BoneGeometryBatch::isBatching() && BoneGeometryBatchOverride::isWireframe(frameContext))
+	{
+
+		drawData->level = LevelOfDetail::kHidden;
+
+	}
+
+	if (drawData->level == LevelOfDetail::kHidden)
+	{
 
-	this->meshData = Drawable::createMeshData(points, polygonCounts, polygonConnects, edgeSmoothings, &status);
-	CHECK_MSTATUS_AND_RETURN(status, boneGeometryData);
+		return drawData;
 
-	status = Drawable::getTriangles(this->meshData, this->triangles, this->normals);
-	CHECK_MSTATUS_AND_RETURN(status, boneGeometryData);
+	}
 
-	status = Drawable::getLines(this->meshData, this->lines);
-	CHECK_MSTATUS_AND_RETURN(status, boneGeometryData);
+	// Prepare geometry if the shape or object-matrix has changed
+	// Entries are shared between nodes and revisions so a shape that has been drawn before, such as a restored cached playback frame, is never regenerated
+	// Animated shapes go through the cache as well, so frames restored by cached playback are found too
+	//
+	{
 
-	return boneGeometryData;
+		BONE_GEOMETRY_PROFILE("getPreparedGeometry", kColorD_L2, objPath.node());
+		this->prepared.prepare(boneGeometryData->shapeKey, boneGeometryData->revision, PreparedGeometryCache::store(), &this->boneGeometry->stats);
+
+	}
+
+	return drawData;
+
+};
+
+
+LevelOfDetail::Level BoneGeometryDrawOverride::getLevelOfDetail(const BoneGeometryData* boneGeometryData, const MDagPath& objPath, const MHWRender::MFrameContext& frameContext)
+/**
+Returns the level of detail for the supplied data based on the projected size of its bounding box from the current camera.
+
+@param boneGeometryData: The bone geometry data.
+@param objPath: The path to the object being drawn.
+@param frameContext: Frame level context information.
+@return: LevelOfDetail::Level
+*/
+{
+
+	if (!boneGeometryData->levelOfDetail)
+	{
+
+		return LevelOfDetail::kFull;
+
+	}
+
+	// Get viewport dimensions
+	//
+	MStatus status;
+	int originX, originY, width, height;
+
+	status = frameContext.getViewportDimensions(originX, originY, width, height);
+
+	if (!status)
+	{
+
+		return LevelOfDetail::kFull;
+
+	}
+
+	// Project bounding box into the viewport
+	//
+	MMatrix viewProjectionMatrix = frameContext.getMatrix(MHWRender::MFrameContext::kViewProjMtx, &status);
+
+	if (!status)
+	{
+
+		return LevelOfDetail::kFull;
+
+	}
+
+	MMatrix matrix = objPath.inclusiveMatrix() * viewProjectionMatrix;
+
+	MPoint min = boneGeometryData->boundingBox.min();
+	MPoint max = boneGeometryData->boundingBox.max();
+
+	const double boxMin[3] = { min.x, min.y, min.z };
+	const double boxMax[3] = { max.x, max.y, max.z };
+
+	double size = LevelOfDetail::projectedSize(boxMin, boxMax, matrix.matrix, static_cast<double>(width), static_cast<double>(height));
+
+	// Compare against thresholds
+	//
+	LevelOfDetail::Thresholds thresholds = { boneGeometryData->wireThreshold, boneGeometryData->lineThreshold, boneGeometryData->hideThreshold };
+	return LevelOfDetail::select(size, thresholds);
 
 };
 
@@ -271,11 +460,15 @@ This method is called after prepareForDraw() and carries the same restrictions o
 */
 {
 
+	BONE_GEOMETRY_PROFILE("addUIDrawables", kColorD_L3, objPath.node());
+	BoneGeometryTrace::Scope trace("BoneGeometryDrawOverride::addUIDrawables");
+
 	// Retrieve the cached data from the prepareForDraw() method
 	//
-	BoneGeometryData* boneGeometryData = (BoneGeometryData*)userData;
+	const BoneGeometryDrawData* drawData = dynamic_cast<const BoneGeometryDrawData*>(userData);
+	const PreparedGeometryCache::PreparedGeometry* prepared = this->prepared.geometry();
 
-	if (!boneGeometryData)
+	if (drawData == nullptr || prepared == nullptr)
 	{
 
 		return;
@@ -288,16 +481,55 @@ This method is called after prepareForDraw() and carries the same restrictions o
 
 	// Edit draw properties
 	//
-	drawManager.setColor(boneGeometryData->wireColor);
-	drawManager.setDepthPriority(boneGeometryData->depthPriority);
+	drawManager.setColor(drawData->wireColor);
+	drawManager.setDepthPriority(drawData->depthPriority);
 	drawManager.setLineWidth(1.0);
 	drawManager.setLineStyle(MHWRender::MUIDrawManager::kSolid);
 	
-	// Draw bone geometry
+	// Draw bone geometry for the selected level of detail
 	//
-	drawManager.setPaintStyle(MHWRender::MUIDrawManager::kShaded);
-	drawManager.mesh(MHWRender::MUIDrawManager::kTriangles, this->triangles, &this->normals);
-	drawManager.mesh(MHWRender::MUIDrawManager::kLines, this->lines);
+	switch (drawData->level)
+	{
+
+		case LevelOfDetail::kFull:
+		{
+
+			drawManager.setPaintStyle(MHWRender::MUIDrawManager::kShaded);
+			drawManager.mesh(MHWRender::MUIDrawManager::kTriangles, prepared->triangles, &prepared->normals);
+			drawManager.mesh(MHWRender::MUIDrawManager::kLines, prepared->lines);
+			break;
+
+		}
+
+		case LevelOfDetail::kWire:
+		{
+
+			drawManager.mesh(MHWRender::MUIDrawManager::kLines, prepared->lines);
+			break;
+
+		}
+
+		case LevelOfDetail::kLine:
+		{
+
+			// Draw a single line from the origin to the center of the tip, the tip corners 5 and 7 are diagonally opposite
+			//
+			const MPointArray& points = prepared->points;
+
+			MPoint tip = points[5] + ((points[7] - points[5]) * 0.5);
+			drawManager.line(points[0], tip);
+			break;
+
+		}
+
+		default:
+		{
+
+			break;
+
+		}
+
+	}
 
 	// End drawable
 	//
@@ -309,13 +541,13 @@ This method is called after prepareForDraw() and carries the same restrictions o
 bool BoneGeometryDrawOverride::traceCallSequence() const
 /**
 This method allows a way for a plug-in to examine the basic call sequence for a draw override.
-The default implementation returns false meaning no tracing will occur.
+Tracing follows the boneGeometryTrace command so it can be toggled without rebuilding.
 
 @return: bool
 */
 {
 
-	return false; // Toggle for debugging!!!
+	return BoneGeometryTrace::isEnabled();
 
 };
 
@@ -323,13 +555,13 @@ The default implementation returns false meaning no tracing will occur.
 void BoneGeometryDrawOverride::handleTraceMessage(const MString& message) const
 /**
 When debug tracing is enabled via MPxDrawOverride::traceCallSequence(), this method will be called for each trace message.
-The default implementation will print the message to stderr.
+Messages are recorded into the trace log rather than printed, see the boneGeometryTrace command.
 
 @param message: A string which will provide feedback on either an internal or plug-in call location.
 @return: void
 */
 {
 
-	MGlobal::displayInfo("BoneGeometryDrawOverride::handleTraceMessage() : " + message);
+	BoneGeometryTrace::record(BoneGeometryTrace::kInstant, message.asChar());
 
 }
\ No newline at end of file
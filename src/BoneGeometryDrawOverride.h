@@ -7,8 +7,17 @@
 //
 
 #include "BoneGeometry.h"
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryBatchOverride.h"
 #include "BoneGeometryData.h"
+#include "BoneGeometryDrawData.h"
 #include "Drawable.h"
+#include "BoneTopology.h"
+#include "BoneGenerator.h"
+#include "LevelOfDetail.h"
+#include "BoneGeometryStats.h"
+#include "BoneGeometryAllocations.h"
+#include "PreparedGeometryCache.h"
 
 #include <maya/MPxDrawOverride.h>
 #include <maya/MObject.h>
@@ -24,6 +33,7 @@
 #include <maya/MHWGeometryUtilities.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 
@@ -50,19 +60,17 @@ public:
 	virtual	bool				traceCallSequence() const;
 	virtual	void				handleTraceMessage(const MString& message) const;
 
-protected:
-
-	static	int					POLYGON_CONNECTS[32];
-	static	int					POLYGON_COUNTS[9];
+	static	void				getPoints(const BoneGeometryData* boneGeometryData, MPointArray& points);
+	static	void				getPoints(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double objectMatrix[4][4], MPointArray& points);
+	static	void				getGeometry(const MPointArray& points, const unsigned int finMask, MPointArray& triangles, MVectorArray& normals, MPointArray& lines);
+	static	MObject				createMeshData(const BoneGeometryData* boneGeometryData, MStatus* status);
+	static	LevelOfDetail::Level	getLevelOfDetail(const BoneGeometryData* boneGeometryData, const MDagPath& objPath, const MHWRender::MFrameContext& frameContext);
 
 protected:
 
 			BoneGeometry*		boneGeometry;
 
-			MObject				meshData;
-			MPointArray			triangles;
-			MVectorArray		normals;
-			MPointArray			lines;
+			PreparedGeometryCache::Slot	prepared;
 
 			MCallbackId			modelEditorChangedCallbackId;
 			static	void		onModelEditorChanged(void* clientData);
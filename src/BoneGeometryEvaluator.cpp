@@ -0,0 +1,353 @@
+//
+// File: BoneGeometryEvaluator.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryEvaluator.h"
+
+MString	BoneGeometryEvaluator::evaluatorName("boneGeometryEvaluator");
+unsigned int BoneGeometryEvaluator::evaluatorPriority(40000);
+
+
+namespace
+{
+
+	double (*asMatrices(std::vector<double>& buffer))[4][4]
+	/**
+	Returns the supplied buffer as an array of matrices, the buffer holds sixteen doubles per matrix.
+
+	@param buffer: The buffer to reinterpret.
+	@return: double (*)[4][4]
+	*/
+	{
+
+		return reinterpret_cast<double(*)[4][4]>(buffer.data());
+
+	};
+
+};
+
+
+BoneGeometryEvaluator::BoneGeometryEvaluator() : MPxCustomEvaluator()
+/**
+Constructor.
+*/
+{
+};
+
+
+BoneGeometryEvaluator::~BoneGeometryEvaluator()
+/**
+Destructor.
+*/
+{
+};
+
+
+void* BoneGeometryEvaluator::creator()
+/**
+Static function used to create a new evaluator instance.
+This function is called via the MFnPlugin::registerEvaluator() method.
+
+@return: void*
+*/
+{
+
+	return new BoneGeometryEvaluator();
+
+};
+
+
+bool BoneGeometryEvaluator::markIfSupported(const MEvaluationNode* node)
+/**
+Called by the Evaluation Manager for every node in the graph, only boneGeometry nodes are claimed.
+Whether a bone can actually be batched is decided per cluster and per frame, see clusterInitialize() and clusterEvaluate().
+
+@param node: The evaluation node to test.
+@return: True if the node is claimed by this evaluator.
+*/
+{
+
+	MStatus status;
+
+	MObject dependencyNode = node->dependencyNode(&status);
+
+	if (!status)
+	{
+
+		return false;
+
+	}
+
+	MFnDependencyNode fnNode(dependencyNode, &status);
+	return status && fnNode.typeId() == BoneGeometry::id;
+
+};
+
+
+void BoneGeometryEvaluator::clusterInitialize(const MCustomEvaluatorClusterNode* cluster)
+/**
+Collects the bones in the supplied cluster and sizes the batch buffers for them.
+Instanced bones have a world matrix per path so they are left to the regular compute.
+
+@param cluster: The cluster being initialized.
+@return: Void.
+*/
+{
+
+	MStatus status;
+
+	std::unique_ptr<Cluster> state(new Cluster());
+
+	for (MEvaluationNodeIterator iter = cluster->iterator(); !iter.isDone(); iter.next())
+	{
+
+		Bone bone = { iter.currentEvaluationNode(), nullptr, MDagPath(), false };
+
+		// Resolve node
+		//
+		MObject node = bone.evaluationNode.dependencyNode(&status);
+		MFnDependencyNode fnNode(node, &status);
+
+		bone.boneGeometry = status ? dynamic_cast<BoneGeometry*>(fnNode.userNode()) : nullptr;
+
+		// Check for a single path
+		//
+		if (bone.boneGeometry != nullptr)
+		{
+
+			MDagPathArray dagPaths;
+			status = MDagPath::getAllPathsTo(node, dagPaths);
+
+			if (status && dagPaths.length() == 1)
+			{
+
+				bone.dagPath = dagPaths[0];
+				bone.isBatched = true;
+
+			}
+
+		}
+
+		state->bones.push_back(bone);
+
+	}
+
+	state->resize(state->bones.size());
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->clusters[cluster] = std::move(state);
+
+};
+
+
+void BoneGeometryEvaluator::clusterTerminate(const MCustomEvaluatorClusterNode* cluster)
+/**
+Releases the buffers for the supplied cluster.
+
+@param cluster: The cluster being terminated.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->clusters.erase(cluster);
+
+};
+
+
+void BoneGeometryEvaluator::clusterEvaluate(const MCustomEvaluatorClusterNode* cluster)
+/**
+Evaluates every bone in the supplied cluster as a single task.
+Local transforms are gathered into structure-of-arrays buffers, the object and world matrices are computed in one batch and committed straight to each data block.
+Bones that cannot be batched this frame are evaluated individually afterwards.
+
+@param cluster: The cluster to evaluate.
+@return: Void.
+*/
+{
+
+	BONE_GEOMETRY_PROFILE("clusterEvaluate", kColorE_L1, MObject::kNullObj);
+	BoneGeometryTrace::Scope trace("BoneGeometryEvaluator::clusterEvaluate");
+
+	BoneGeometryStats::add(BoneGeometryStats::kEvaluatorClusters);
+
+	// Data blocks can only be written directly for the normal context
+	//
+	Cluster* state = this->findCluster(cluster);
+	const MDGContext& context = MDGContext::current();
+
+	if (state == nullptr || !context.isNormal())
+	{
+
+		cluster->evaluate();
+		BoneGeometryStats::add(BoneGeometryStats::kEvaluatorFallbacks, (state != nullptr) ? state->bones.size() : 0);
+
+		return;
+
+	}
+
+	// Gather local transforms
+	//
+	MStatus status;
+
+	state->batched.clear();
+	state->fallbacks.clear();
+
+	double (*inclusiveMatrices)[4][4] = asMatrices(state->inclusiveMatrices);
+	double (*inclusiveInverseMatrices)[4][4] = asMatrices(state->inclusiveInverseMatrices);
+
+	for (size_t i = 0; i < state->bones.size(); i++)
+	{
+
+		Bone& bone = state->bones[i];
+
+		if (!bone.isBatched)
+		{
+
+			state->fallbacks.push_back(i);
+			continue;
+
+		}
+
+		MDataBlock data = bone.boneGeometry->forceCache();
+
+		MVector position = data.inputValue(BoneGeometry::localPosition, &status).asVector();
+		MVector rotation = data.inputValue(BoneGeometry::localRotate, &status).asVector();
+		MVector scale = data.inputValue(BoneGeometry::localScale, &status).asVector();
+
+		// A zero scale has no analytic inverse, leave it to the regular compute
+		//
+		if (!status || scale.x == 0.0 || scale.y == 0.0 || scale.z == 0.0)
+		{
+
+			state->fallbacks.push_back(i);
+			continue;
+
+		}
+
+		size_t index = state->batched.size();
+
+		state->translate[0][index] = position.x;
+		state->translate[1][index] = position.y;
+		state->translate[2][index] = position.z;
+		state->rotate[0][index] = rotation.x;
+		state->rotate[1][index] = rotation.y;
+		state->rotate[2][index] = rotation.z;
+		state->scale[0][index] = scale.x;
+		state->scale[1][index] = scale.y;
+		state->scale[2][index] = scale.z;
+
+		bone.dagPath.inclusiveMatrix().get(inclusiveMatrices[index]);
+		bone.dagPath.inclusiveMatrixInverse().get(inclusiveInverseMatrices[index]);
+
+		bone.boneGeometry->preEvaluation(context, bone.evaluationNode);
+		state->batched.push_back(i);
+
+	}
+
+	// Compute every matrix in one batch, the world inverse is built as inverse(inclusive) * inverse(object) rather than inverting each world matrix
+	//
+	size_t numBatched = state->batched.size();
+
+	double (*objectMatrices)[4][4] = asMatrices(state->objectMatrices);
+	double (*objectInverseMatrices)[4][4] = asMatrices(state->objectInverseMatrices);
+	double (*objectWorldMatrices)[4][4] = asMatrices(state->objectWorldMatrices);
+	double (*objectWorldInverseMatrices)[4][4] = asMatrices(state->objectWorldInverseMatrices);
+
+	{
+
+		BONE_GEOMETRY_PROFILE("composeBatch", kColorE_L2, MObject::kNullObj);
+
+		TransformKernel::TransformArrays transforms =
+		{
+			{ state->translate[0].data(), state->translate[1].data(), state->translate[2].data() },
+			{ state->rotate[0].data(), state->rotate[1].data(), state->rotate[2].data() },
+			{ state->scale[0].data(), state->scale[1].data(), state->scale[2].data() }
+		};
+
+		TransformKernel::composeBatch(transforms, numBatched, objectMatrices, objectInverseMatrices);
+		TransformKernel::multiplyBatch(objectMatrices, inclusiveMatrices, numBatched, objectWorldMatrices);
+		TransformKernel::multiplyBatch(inclusiveInverseMatrices, objectInverseMatrices, numBatched, objectWorldInverseMatrices);
+
+	}
+
+	// Commit matrices to each data block
+	//
+	for (size_t index = 0; index < numBatched; index++)
+	{
+
+		BoneGeometry* boneGeometry = state->bones[state->batched[index]].boneGeometry;
+		MDataBlock data = boneGeometry->forceCache();
+
+		MMatrix objectWorldMatrix(objectWorldMatrices[index]);
+		MMatrix objectWorldInverseMatrix(objectWorldInverseMatrices[index]);
+
+		CHECK_MSTATUS(BoneGeometry::setObjectMatrices(data, MMatrix(objectMatrices[index]), MMatrix(objectInverseMatrices[index])));
+		CHECK_MSTATUS(BoneGeometry::setObjectWorldMatrices(data, &objectWorldMatrix, &objectWorldInverseMatrix, 1));
+
+	}
+
+	// Evaluate remaining bones individually
+	//
+	for (size_t i : state->fallbacks)
+	{
+
+		cluster->evaluateNode(state->bones[i].evaluationNode, &status);
+		CHECK_MSTATUS(status);
+
+	}
+
+	BoneGeometryStats::add(BoneGeometryStats::kEvaluatorBatched, numBatched);
+	BoneGeometryStats::add(BoneGeometryStats::kEvaluatorFallbacks, state->fallbacks.size());
+
+};
+
+
+BoneGeometryEvaluator::Cluster* BoneGeometryEvaluator::findCluster(const MCustomEvaluatorClusterNode* cluster)
+/**
+Returns the state for the supplied cluster, clusters may be evaluated concurrently so the lookup is guarded.
+
+@param cluster: The cluster to look up.
+@return: Cluster
+*/
+{
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	auto found = this->clusters.find(cluster);
+	return (found != this->clusters.end()) ? found->second.get() : nullptr;
+
+};
+
+
+void BoneGeometryEvaluator::Cluster::resize(const size_t size)
+/**
+Sizes every batch buffer to hold the supplied number of bones.
+
+@param size: The number of bones.
+@return: Void.
+*/
+{
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+
+		this->translate[axis].resize(size);
+		this->rotate[axis].resize(size);
+		this->scale[axis].resize(size);
+
+	}
+
+	this->objectMatrices.resize(size * 16);
+	this->objectInverseMatrices.resize(size * 16);
+	this->inclusiveMatrices.resize(size * 16);
+	this->inclusiveInverseMatrices.resize(size * 16);
+	this->objectWorldMatrices.resize(size * 16);
+	this->objectWorldInverseMatrices.resize(size * 16);
+
+	this->batched.reserve(size);
+	this->fallbacks.reserve(size);
+
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef _BONE_GEOMETRY_EVALUATOR
+#define _BONE_GEOMETRY_EVALUATOR
+//
+// File: BoneGeometryEvaluator.h
+//
+// Custom evaluator: boneGeometryEvaluator
+// Claims boneGeometry nodes under the Evaluation Manager and evaluates each cluster as a single task.
+// Local transforms are gathered into structure-of-arrays buffers and every matrix output is computed in one batch, see TransformKernel.h.
+// Instanced bones, bones with a zero scale and non-normal contexts fall back to the regular per-node compute.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometry.h"
+#include "TransformKernel.h"
+
+#include <maya/MPxCustomEvaluator.h>
+#include <maya/MCustomEvaluatorClusterNode.h>
+#include <maya/MEvaluationNode.h>
+#include <maya/MEvaluationNodeIterator.h>
+#include <maya/MDGContext.h>
+#include <maya/MDagPath.h>
+#include <maya/MString.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+class BoneGeometryEvaluator : public MPxCustomEvaluator
+{
+
+public:
+
+								BoneGeometryEvaluator();
+	virtual						~BoneGeometryEvaluator();
+
+	static	void*				creator();
+
+	virtual	bool				markIfSupported(const MEvaluationNode* node);
+
+	virtual	void				clusterInitialize(const MCustomEvaluatorClusterNode* cluster);
+	virtual	void				clusterTerminate(const MCustomEvaluatorClusterNode* cluster);
+	virtual	void				clusterEvaluate(const MCustomEvaluatorClusterNode* cluster);
+
+	static	MString				evaluatorName;
+	static	unsigned int		evaluatorPriority;
+
+protected:
+
+	struct Bone
+	{
+
+		MEvaluationNode			evaluationNode;
+		BoneGeometry*			boneGeometry;
+		MDagPath				dagPath;
+		bool					isBatched;
+
+	};
+
+	struct Cluster
+	{
+
+				void			resize(const size_t size);
+
+		std::vector<Bone>		bones;
+		std::vector<size_t>		batched;
+		std::vector<size_t>		fallbacks;
+
+		std::vector<double>		translate[3];
+		std::vector<double>		rotate[3];
+		std::vector<double>		scale[3];
+
+		std::vector<double>		objectMatrices;
+		std::vector<double>		objectInverseMatrices;
+		std::vector<double>		inclusiveMatrices;
+		std::vector<double>		inclusiveInverseMatrices;
+		std::vector<double>		objectWorldMatrices;
+		std::vector<double>		objectWorldInverseMatrices;
+
+	};
+
+			Cluster*			findCluster(const MCustomEvaluatorClusterNode* cluster);
+
+			std::mutex									mutex;
+			std::map<const MCustomEvaluatorClusterNode*, std::unique_ptr<Cluster>>	clusters;
+
+};
+#endif
\ No newline at end of file
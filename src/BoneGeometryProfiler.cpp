@@ -0,0 +1,35 @@
+//
+// File: BoneGeometryProfiler.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryProfiler.h"
+
+
+int BoneGeometryProfiler::category()
+/**
+Returns the index of the "BoneGeometry" profiler category, adding it on first use.
+
+@return: int
+*/
+{
+
+	static const int categoryIndex = MProfiler::addCategory("BoneGeometry", "Bone geometry compute and draw");
+	return categoryIndex;
+
+};
+
+
+void BoneGeometryProfiler::removeCategory()
+/**
+Removes the "BoneGeometry" profiler category.
+This should be called when the plugin is unloaded.
+
+@return: Void.
+*/
+{
+
+	MProfiler::removeCategory("BoneGeometry");
+
+};
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef _BONE_GEOMETRY_PROFILER
+#define _BONE_GEOMETRY_PROFILER
+//
+// File: BoneGeometryProfiler.h
+//
+// Scoped MProfiler events under a dedicated "BoneGeometry" category.
+// Events are compiled out when NDEBUG is defined unless BONE_GEOMETRY_PROFILING is also defined.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <maya/MProfiler.h>
+#include <maya/MObject.h>
+
+
+namespace BoneGeometryProfiler
+{
+
+	int		category();
+	void	removeCategory();
+
+};
+
+#if !defined(NDEBUG) || defined(BONE_GEOMETRY_PROFILING)
+#define BONE_GEOMETRY_PROFILE_CONCAT_(a, b) a##b
+#define BONE_GEOMETRY_PROFILE_CONCAT(a, b) BONE_GEOMETRY_PROFILE_CONCAT_(a, b)
+#define BONE_GEOMETRY_PROFILE(eventName, color, node) MProfilingScope BONE_GEOMETRY_PROFILE_CONCAT(profilingScope, __LINE__)(BoneGeometryProfiler::category(), MProfiler::color, eventName, nullptr, node)
+#else
+#define BONE_GEOMETRY_PROFILE(eventName, color, node)
+#endif
+
+#endif
\ No newline at end of file
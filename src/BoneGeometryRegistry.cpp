@@ -0,0 +1,410 @@
+//
+// File: BoneGeometryRegistry.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryRegistry.h"
+#include "BoneGeometryStats.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace
+{
+
+	struct Storage
+	{
+
+		std::vector<unsigned char>		isAlive;
+		std::vector<unsigned int>		generation;
+		std::vector<unsigned int>		finMask;
+		std::vector<unsigned long long>	revision;
+
+		std::vector<double>				width;
+		std::vector<double>				height;
+		std::vector<double>				length;
+		std::vector<double>				taper;
+
+		std::vector<double>				finSize[BoneGenerator::kNumFinTypes];
+		std::vector<double>				finStartTaper[BoneGenerator::kNumFinTypes];
+		std::vector<double>				finEndTaper[BoneGenerator::kNumFinTypes];
+
+		std::vector<double>				min[3];
+		std::vector<double>				max[3];
+
+		std::vector<unsigned int>		freeSlots;
+		size_t							numAlive = 0;
+
+	};
+
+	std::shared_mutex mutex;
+	Storage storage;
+
+	std::atomic<unsigned long long> changes{ 0 };
+
+	void grow()
+	/**
+	Appends an empty slot to every column, the caller must hold the exclusive lock.
+
+	@return: Void.
+	*/
+	{
+
+		storage.isAlive.push_back(0);
+		storage.generation.push_back(0);
+		storage.finMask.push_back(0);
+		storage.revision.push_back(0);
+
+		storage.width.push_back(0.0);
+		storage.height.push_back(0.0);
+		storage.length.push_back(0.0);
+		storage.taper.push_back(0.0);
+
+		for (unsigned int type = 0; type < BoneGenerator::kNumFinTypes; type++)
+		{
+
+			storage.finSize[type].push_back(0.0);
+			storage.finStartTaper[type].push_back(0.0);
+			storage.finEndTaper[type].push_back(0.0);
+
+		}
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+
+			storage.min[axis].push_back(0.0);
+			storage.max[axis].push_back(0.0);
+
+		}
+
+	};
+
+	bool isValid(const BoneGeometryRegistry::Handle& handle)
+	/**
+	Evaluates if the supplied handle still refers to a live slot, the caller must hold either lock.
+
+	@param handle: The handle to test.
+	@return: bool
+	*/
+	{
+
+		return handle.index < storage.isAlive.size() && storage.isAlive[handle.index] && storage.generation[handle.index] == handle.generation;
+
+	};
+
+};
+
+
+bool BoneGeometryRegistry::Handle::operator==(const Handle& other) const
+/**
+Equality operator.
+
+@param other: The handle to compare against.
+@return: bool
+*/
+{
+
+	return this->index == other.index && this->generation == other.generation;
+
+};
+
+
+bool BoneGeometryRegistry::Handle::operator!=(const Handle& other) const
+/**
+Inequality operator.
+
+@param other: The handle to compare against.
+@return: bool
+*/
+{
+
+	return !(*this == other);
+
+};
+
+
+BoneGeometryRegistry::Reader::Reader() : lock(mutex)
+/**
+Constructor.
+Holds the registry open for reading until destroyed, update() and slot allocation wait until every reader is gone.
+A thread holding a reader must not publish changes itself.
+*/
+{
+
+	this->slots.numSlots = storage.isAlive.size();
+	this->slots.isAlive = storage.isAlive.data();
+	this->slots.generation = storage.generation.data();
+	this->slots.finMask = storage.finMask.data();
+	this->slots.revision = storage.revision.data();
+
+	this->slots.width = storage.width.data();
+	this->slots.height = storage.height.data();
+	this->slots.length = storage.length.data();
+	this->slots.taper = storage.taper.data();
+
+	for (unsigned int type = 0; type < BoneGenerator::kNumFinTypes; type++)
+	{
+
+		this->slots.finSize[type] = storage.finSize[type].data();
+		this->slots.finStartTaper[type] = storage.finStartTaper[type].data();
+		this->slots.finEndTaper[type] = storage.finEndTaper[type].data();
+
+	}
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+
+		this->slots.min[axis] = storage.min[axis].data();
+		this->slots.max[axis] = storage.max[axis].data();
+
+	}
+
+};
+
+
+const BoneGeometryRegistry::Columns& BoneGeometryRegistry::Reader::columns() const
+/**
+Returns the registry columns, every column holds one element per slot.
+Slots that are not alive hold stale values and should be skipped.
+
+@return: Columns
+*/
+{
+
+	return this->slots;
+
+};
+
+
+bool BoneGeometryRegistry::Reader::isValid(const Handle& handle) const
+/**
+Evaluates if the supplied handle still refers to a live slot.
+
+@param handle: The handle to test.
+@return: bool
+*/
+{
+
+	return ::isValid(handle);
+
+};
+
+
+void BoneGeometryRegistry::Reader::get(const size_t index, Bone& bone) const
+/**
+Gathers the supplied slot back into a single bone.
+
+@param index: The slot index.
+@param bone: The passed bone to populate.
+@return: Void.
+*/
+{
+
+	const Columns& bones = this->slots;
+
+	bone.finMask = this->slots.finMask[index];
+	bone.revision = this->slots.revision[index];
+
+	bone.parameters.width = bones.width[index];
+	bone.parameters.height = bones.height[index];
+	bone.parameters.length = bones.length[index];
+	bone.parameters.taper = bones.taper[index];
+	bone.parameters.sideFins = { bones.finSize[BoneGenerator::kSideFinIndex][index], bones.finStartTaper[BoneGenerator::kSideFinIndex][index], bones.finEndTaper[BoneGenerator::kSideFinIndex][index] };
+	bone.parameters.frontFin = { bones.finSize[BoneGenerator::kFrontFinIndex][index], bones.finStartTaper[BoneGenerator::kFrontFinIndex][index], bones.finEndTaper[BoneGenerator::kFrontFinIndex][index] };
+	bone.parameters.backFin = { bones.finSize[BoneGenerator::kBackFinIndex][index], bones.finStartTaper[BoneGenerator::kBackFinIndex][index], bones.finEndTaper[BoneGenerator::kBackFinIndex][index] };
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+
+		bone.min[axis] = this->slots.min[axis][index];
+		bone.max[axis] = this->slots.max[axis][index];
+
+	}
+
+};
+
+
+BoneGeometryRegistry::Handle BoneGeometryRegistry::acquire()
+/**
+Allocates a slot for a new bone, recycling a released slot whenever possible.
+The slot is zero initialized until the bone publishes itself through update().
+
+@return: Handle
+*/
+{
+
+	std::unique_lock<std::shared_mutex> lock(mutex);
+
+	Handle handle;
+
+	if (!storage.freeSlots.empty())
+	{
+
+		handle.index = storage.freeSlots.back();
+		storage.freeSlots.pop_back();
+
+	}
+	else
+	{
+
+		handle.index = static_cast<unsigned int>(storage.isAlive.size());
+		grow();
+
+	}
+
+	handle.generation = ++storage.generation[handle.index];
+
+	storage.isAlive[handle.index] = 1;
+	storage.numAlive++;
+
+	changes.fetch_add(1, std::memory_order_release);
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kRegisteredBones, 1);
+
+	return handle;
+
+};
+
+
+void BoneGeometryRegistry::release(Handle& handle)
+/**
+Returns the supplied handle's slot to the registry and resets the handle.
+Copies of the handle held elsewhere become invalid, even once the slot is reused.
+
+@param handle: The handle to release.
+@return: Void.
+*/
+{
+
+	std::unique_lock<std::shared_mutex> lock(mutex);
+
+	if (!::isValid(handle))
+	{
+
+		return;
+
+	}
+
+	storage.isAlive[handle.index] = 0;
+	storage.revision[handle.index] = 0;
+	storage.freeSlots.push_back(handle.index);
+	storage.numAlive--;
+
+	changes.fetch_add(1, std::memory_order_release);
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kRegisteredBones, -1);
+
+	handle = Handle();
+
+};
+
+
+void BoneGeometryRegistry::update(const Handle& handle, const Bone& bone)
+/**
+Scatters the supplied bone into its slot.
+Waits for any readers to finish, so this must never be called while the calling thread holds a reader.
+
+@param handle: The slot to update.
+@param bone: The bone values to publish.
+@return: Void.
+*/
+{
+
+	std::unique_lock<std::shared_mutex> lock(mutex);
+
+	if (!::isValid(handle))
+	{
+
+		return;
+
+	}
+
+	size_t index = handle.index;
+
+	storage.finMask[index] = bone.finMask;
+	storage.revision[index] = bone.revision;
+
+	storage.width[index] = bone.parameters.width;
+	storage.height[index] = bone.parameters.height;
+	storage.length[index] = bone.parameters.length;
+	storage.taper[index] = bone.parameters.taper;
+
+	const BoneGenerator::FinParameters* fins[BoneGenerator::kNumFinTypes] = { &bone.parameters.sideFins, &bone.parameters.frontFin, &bone.parameters.backFin };
+
+	for (unsigned int type = 0; type < BoneGenerator::kNumFinTypes; type++)
+	{
+
+		storage.finSize[type][index] = fins[type]->size;
+		storage.finStartTaper[type][index] = fins[type]->startTaper;
+		storage.finEndTaper[type][index] = fins[type]->endTaper;
+
+	}
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+
+		storage.min[axis][index] = bone.min[axis];
+		storage.max[axis][index] = bone.max[axis];
+
+	}
+
+	changes.fetch_add(1, std::memory_order_release);
+
+};
+
+
+bool BoneGeometryRegistry::get(const Handle& handle, Bone& bone)
+/**
+Copies a single bone out of the registry.
+Prefer a Reader when visiting many bones, this takes the read lock on every call.
+
+@param handle: The slot to read.
+@param bone: The passed bone to populate.
+@return: False if the handle is no longer valid.
+*/
+{
+
+	Reader reader;
+
+	if (!reader.isValid(handle))
+	{
+
+		return false;
+
+	}
+
+	reader.get(handle.index, bone);
+	return true;
+
+};
+
+
+size_t BoneGeometryRegistry::size()
+/**
+Returns the number of live bones.
+
+@return: size_t
+*/
+{
+
+	std::shared_lock<std::shared_mutex> lock(mutex);
+	return storage.numAlive;
+
+};
+
+
+unsigned long long BoneGeometryRegistry::revision()
+/**
+Returns a counter that is bumped whenever a slot is acquired, released or updated.
+Readers can compare it against the value from their last scan to skip scanning when nothing changed.
+
+@return: unsigned long long
+*/
+{
+
+	return changes.load(std::memory_order_acquire);
+
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef _BONE_GEOMETRY_REGISTRY
+#define _BONE_GEOMETRY_REGISTRY
+//
+// File: BoneGeometryRegistry.h
+//
+// Plugin-wide registry holding the drawn shape and bounds of every bone in contiguous structure-of-arrays columns.
+// Each bone owns a stable handle to its slot, slots are recycled on deletion and a generation counter invalidates stale handles.
+// Any number of readers may scan the columns concurrently, bones publish changes through update() which waits for readers to finish.
+// Drawn shapes are always generated at the identity, so no object-matrix is stored.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGenerator.h"
+
+#include <cstddef>
+#include <shared_mutex>
+
+
+namespace BoneGeometryRegistry
+{
+
+	struct Handle
+	{
+
+					bool				operator==(const Handle& other) const;
+					bool				operator!=(const Handle& other) const;
+
+					unsigned int		index = ~0u;
+					unsigned int		generation = 0;
+
+	};
+
+	struct Bone
+	{
+
+					unsigned int		finMask = 0;
+					BoneGenerator::BoneParameters	parameters = {};
+					double				min[3] = {};
+					double				max[3] = {};
+					unsigned long long	revision = 0;
+
+	};
+
+	struct Columns
+	{
+
+					size_t				numSlots = 0;
+					const unsigned char*	isAlive = nullptr;
+					const unsigned int*	generation = nullptr;
+					const unsigned int*	finMask = nullptr;
+					const unsigned long long*	revision = nullptr;
+					const double*		width = nullptr;
+					const double*		height = nullptr;
+					const double*		length = nullptr;
+					const double*		taper = nullptr;
+					const double*		finSize[BoneGenerator::kNumFinTypes] = {};
+					const double*		finStartTaper[BoneGenerator::kNumFinTypes] = {};
+					const double*		finEndTaper[BoneGenerator::kNumFinTypes] = {};
+					const double*		min[3] = {};
+					const double*		max[3] = {};
+
+	};
+
+	class Reader
+	{
+
+	public:
+
+										Reader();
+
+										Reader(const Reader&) = delete;
+					Reader&				operator=(const Reader&) = delete;
+
+					const Columns&		columns() const;
+					bool				isValid(const Handle& handle) const;
+					void				get(const size_t index, Bone& bone) const;
+
+	protected:
+
+					std::shared_lock<std::shared_mutex>	lock;
+					Columns				slots;
+
+	};
+
+	Handle			acquire();
+	void			release(Handle& handle);
+	void			update(const Handle& handle, const Bone& bone);
+	bool			get(const Handle& handle, Bone& bone);
+
+	size_t			size();
+	unsigned long long	revision();
+
+};
+#endif
\ No newline at end of file
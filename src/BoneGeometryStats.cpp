@@ -0,0 +1,287 @@
+//
+// File: BoneGeometryStats.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryStats.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace
+{
+
+	struct ThreadCounters
+	{
+
+		std::atomic<uint64_t>	counters[BoneGeometryStats::kNumCounters] = {};
+		std::atomic<int64_t>	gauges[BoneGeometryStats::kNumGauges] = {};
+
+	};
+
+	std::mutex										threadsMutex;
+	std::vector<std::unique_ptr<ThreadCounters>>	threads;
+	uint64_t										baseline[BoneGeometryStats::kNumCounters] = {};
+
+	const char* counterNames[BoneGeometryStats::kNumCounters] =
+	{
+
+		"computeObjectMatrix",
+		"computeObjectInverseMatrix",
+		"computeObjectWorldMatrix",
+		"computeObjectWorldInverseMatrix",
+		"computeOther",
+		"prepareForDraw",
+		"geometryRebuilds",
+		"geometryNanoseconds",
+		"primitiveCacheHits",
+		"primitiveCacheMisses",
+		"preparedCacheHits",
+		"preparedCacheMisses",
+		"preparedCacheRecycles",
+		"batchInstanceHits",
+		"batchInstanceRebuilds",
+		"batchBucketUploads",
+		"modelEditorCallbacks",
+		"geometryDrawDirty",
+		"dirtyQueueFlushes",
+		"shapeDirty",
+		"levelOfDetailDirty",
+		"evaluatorClusters",
+		"evaluatorBatched",
+		"evaluatorFallbacks",
+		"cameraChanges"
+
+	};
+
+	const char* gaugeNames[BoneGeometryStats::kNumGauges] =
+	{
+
+		"residentBytes",
+		"userDataBytes",
+		"registeredBones"
+
+	};
+
+	ThreadCounters& localCounters()
+	/**
+	Returns the counter block owned by the calling thread, registering it on first use.
+	Blocks outlive their threads so counts from finished worker threads are still reported.
+
+	@return: ThreadCounters
+	*/
+	{
+
+		thread_local ThreadCounters* counters = nullptr;
+
+		if (counters == nullptr)
+		{
+
+			std::lock_guard<std::mutex> lock(threadsMutex);
+
+			threads.emplace_back(new ThreadCounters());
+			counters = threads.back().get();
+
+		}
+
+		return *counters;
+
+	};
+
+};
+
+
+void BoneGeometryStats::NodeCounters::reset()
+/**
+Clears the per-node counters.
+
+@return: Void.
+*/
+{
+
+	this->computes = 0;
+	this->prepareForDraw = 0;
+	this->rebuilds = 0;
+	this->geometryNanoseconds = 0;
+
+};
+
+
+void BoneGeometryStats::add(const Counter counter, const uint64_t amount)
+/**
+Adds to the supplied counter.
+Each block has a single writer so a relaxed load and store is enough, readers may observe a slightly stale value.
+
+@param counter: The counter to increment.
+@param amount: The amount to add.
+@return: Void.
+*/
+{
+
+	std::atomic<uint64_t>& value = localCounters().counters[counter];
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+
+};
+
+
+void BoneGeometryStats::addGauge(const Gauge gauge, const int64_t delta)
+/**
+Adds the supplied delta to a gauge.
+Gauges track live quantities, such as resident bytes, so they are never affected by reset().
+
+@param gauge: The gauge to modify.
+@param delta: The signed amount to add.
+@return: Void.
+*/
+{
+
+	std::atomic<int64_t>& value = localCounters().gauges[gauge];
+	value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+
+};
+
+
+void BoneGeometryStats::snapshot(uint64_t counters[kNumCounters], int64_t gauges[kNumGauges])
+/**
+Sums every thread's counters into the passed arrays.
+Counters are reported relative to the last reset.
+
+@param counters: The passed array to populate with counter values.
+@param gauges: The passed array to populate with gauge values.
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	for (unsigned int i = 0; i < kNumCounters; i++)
+	{
+
+		counters[i] = 0;
+
+	}
+
+	for (unsigned int i = 0; i < kNumGauges; i++)
+	{
+
+		gauges[i] = 0;
+
+	}
+
+	for (const std::unique_ptr<ThreadCounters>& thread : threads)
+	{
+
+		for (unsigned int i = 0; i < kNumCounters; i++)
+		{
+
+			counters[i] += thread->counters[i].load(std::memory_order_relaxed);
+
+		}
+
+		for (unsigned int i = 0; i < kNumGauges; i++)
+		{
+
+			gauges[i] += thread->gauges[i].load(std::memory_order_relaxed);
+
+		}
+
+	}
+
+	for (unsigned int i = 0; i < kNumCounters; i++)
+	{
+
+		counters[i] -= baseline[i];
+
+	}
+
+};
+
+
+void BoneGeometryStats::reset()
+/**
+Resets the counters by recording the current totals as the new baseline.
+
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(threadsMutex);
+
+	for (unsigned int i = 0; i < kNumCounters; i++)
+	{
+
+		uint64_t total = 0;
+
+		for (const std::unique_ptr<ThreadCounters>& thread : threads)
+		{
+
+			total += thread->counters[i].load(std::memory_order_relaxed);
+
+		}
+
+		baseline[i] = total;
+
+	}
+
+};
+
+
+const char* BoneGeometryStats::counterName(const Counter counter)
+/**
+Returns the name of the supplied counter.
+
+@param counter: The counter.
+@return: const char*
+*/
+{
+
+	return (counter < kNumCounters) ? counterNames[counter] : "";
+
+};
+
+
+const char* BoneGeometryStats::gaugeName(const Gauge gauge)
+/**
+Returns the name of the supplied gauge.
+
+@param gauge: The gauge.
+@return: const char*
+*/
+{
+
+	return (gauge < kNumGauges) ? gaugeNames[gauge] : "";
+
+};
+
+
+BoneGeometryStats::ScopedTimer::ScopedTimer(NodeCounters* nodeCounters) : nodeCounters(nodeCounters), start(std::chrono::steady_clock::now())
+/**
+Constructor.
+
+@param nodeCounters: Optional per-node counters to also receive the elapsed time.
+*/
+{
+};
+
+
+BoneGeometryStats::ScopedTimer::~ScopedTimer()
+/**
+Destructor.
+Adds the elapsed time to the geometry generation counter.
+*/
+{
+
+	uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count());
+	BoneGeometryStats::add(kGeometryNanoseconds, elapsed);
+
+	if (this->nodeCounters != nullptr)
+	{
+
+		this->nodeCounters->geometryNanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+
+	}
+
+};
\ No newline at end of file
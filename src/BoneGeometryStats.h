@@ -0,0 +1,100 @@
+#ifndef _BONE_GEOMETRY_STATS
+#define _BONE_GEOMETRY_STATS
+//
+// File: BoneGeometryStats.h
+//
+// Maya-free performance counters for the boneGeometryStats command.
+// Aggregate counters live in per-thread blocks that are only ever written by their owning thread, a query sums every block.
+// Resetting records a baseline instead of clearing the blocks so writers never need to synchronize.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+namespace BoneGeometryStats
+{
+
+	enum Counter : unsigned int
+	{
+
+		kComputeObjectMatrix = 0,
+		kComputeObjectInverseMatrix,
+		kComputeObjectWorldMatrix,
+		kComputeObjectWorldInverseMatrix,
+		kComputeOther,
+		kPrepareForDraw,
+		kGeometryRebuilds,
+		kGeometryNanoseconds,
+		kPrimitiveCacheHits,
+		kPrimitiveCacheMisses,
+		kPreparedCacheHits,
+		kPreparedCacheMisses,
+		kPreparedCacheRecycles,
+		kBatchInstanceHits,
+		kBatchInstanceRebuilds,
+		kBatchBucketUploads,
+		kModelEditorCallbacks,
+		kGeometryDrawDirty,
+		kDirtyQueueFlushes,
+		kShapeDirty,
+		kLevelOfDetailDirty,
+		kEvaluatorClusters,
+		kEvaluatorBatched,
+		kEvaluatorFallbacks,
+		kCameraChanges,
+		kNumCounters
+
+	};
+
+	enum Gauge : unsigned int
+	{
+
+		kResidentBytes = 0,
+		kUserDataBytes,
+		kRegisteredBones,
+		kNumGauges
+
+	};
+
+	struct NodeCounters
+	{
+
+		std::atomic<uint64_t>	computes{ 0 };
+		std::atomic<uint64_t>	prepareForDraw{ 0 };
+		std::atomic<uint64_t>	rebuilds{ 0 };
+		std::atomic<uint64_t>	geometryNanoseconds{ 0 };
+
+		void					reset();
+
+	};
+
+	void		add(const Counter counter, const uint64_t amount = 1);
+	void		addGauge(const Gauge gauge, const int64_t delta);
+
+	void		snapshot(uint64_t counters[kNumCounters], int64_t gauges[kNumGauges]);
+	void		reset();
+
+	const char*	counterName(const Counter counter);
+	const char*	gaugeName(const Gauge gauge);
+
+	class ScopedTimer
+	{
+
+	public:
+
+							ScopedTimer(NodeCounters* nodeCounters = nullptr);
+							~ScopedTimer();
+
+	protected:
+
+		NodeCounters*							nodeCounters;
+		std::chrono::steady_clock::time_point	start;
+
+	};
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,372 @@
+//
+// File: BoneGeometryStatsCommand.cpp
+//
+// Command: boneGeometryStats
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryStatsCommand.h"
+
+#include <sstream>
+
+MString	BoneGeometryStatsCommand::commandName("boneGeometryStats");
+
+static const char* jsonFlag = "-js";
+static const char* jsonLongFlag = "-json";
+static const char* resetFlag = "-r";
+static const char* resetLongFlag = "-reset";
+static const char* allNodesFlag = "-all";
+static const char* allNodesLongFlag = "-allNodes";
+
+
+namespace
+{
+
+	double getRate(const uint64_t hits, const uint64_t total)
+	/**
+	Returns the ratio of hits to total, or zero when nothing was recorded.
+
+	@param hits: The number of hits.
+	@param total: The total number of lookups.
+	@return: double
+	*/
+	{
+
+		return (total > 0) ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+
+	};
+
+	std::string escapeJson(const MString& string)
+	/**
+	Returns the supplied string with any JSON control characters escaped.
+
+	@param string: The string to escape.
+	@return: std::string
+	*/
+	{
+
+		std::string escaped;
+
+		for (const char* character = string.asChar(); *character != '\0'; character++)
+		{
+
+			if (*character == '"' || *character == '\\')
+			{
+
+				escaped += '\\';
+
+			}
+
+			escaped += *character;
+
+		}
+
+		return escaped;
+
+	};
+
+};
+
+
+BoneGeometryStatsCommand::BoneGeometryStatsCommand() {};
+BoneGeometryStatsCommand::~BoneGeometryStatsCommand() {};
+
+
+MStatus BoneGeometryStatsCommand::doIt(const MArgList& args)
+/**
+Reports the current counters.
+Any bone geometry nodes passed to the command, or every registered bone with -allNodes, are reported individually as well.
+With -reset the counters are cleared once they have been reported.
+
+@param args: The command arguments.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	MArgDatabase argDatabase(this->syntax(), args, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Collect nodes to report individually
+	//
+	std::vector<std::pair<MString, BoneGeometry*>> nodes;
+
+	if (argDatabase.isFlagSet(allNodesFlag))
+	{
+
+		std::vector<BoneGeometry*> bones;
+		BoneGeometryBatch::getBones(bones);
+
+		for (BoneGeometry* boneGeometry : bones)
+		{
+
+			if (boneGeometry != nullptr)
+			{
+
+				nodes.emplace_back(MFnDependencyNode(boneGeometry->thisMObject()).name(), boneGeometry);
+
+			}
+
+		}
+
+	}
+	else
+	{
+
+		MSelectionList selection;
+
+		status = argDatabase.getObjects(selection);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		for (unsigned int i = 0; i < selection.length(); i++)
+		{
+
+			MObject node;
+
+			status = selection.getDependNode(i, node);
+			CHECK_MSTATUS_AND_RETURN_IT(status);
+
+			MFnDependencyNode fnNode(node, &status);
+			CHECK_MSTATUS_AND_RETURN_IT(status);
+
+			BoneGeometry* boneGeometry = dynamic_cast<BoneGeometry*>(fnNode.userNode());
+
+			if (boneGeometry == nullptr)
+			{
+
+				this->displayError(fnNode.name() + " is not a boneGeometry node!");
+				return MS::kInvalidParameter;
+
+			}
+
+			nodes.emplace_back(fnNode.name(), boneGeometry);
+
+		}
+
+	}
+
+	// Report counters
+	//
+	if (argDatabase.isFlagSet(jsonFlag))
+	{
+
+		MPxCommand::setResult(MString(BoneGeometryStatsCommand::toJson(nodes).c_str()));
+
+	}
+	else
+	{
+
+		MPxCommand::setResult(BoneGeometryStatsCommand::toStringArray(nodes));
+
+	}
+
+	// Reset counters if requested
+	//
+	if (argDatabase.isFlagSet(resetFlag))
+	{
+
+		BoneGeometryStats::reset();
+
+		std::vector<BoneGeometry*> bones;
+		BoneGeometryBatch::getBones(bones);
+
+		for (BoneGeometry* boneGeometry : bones)
+		{
+
+			if (boneGeometry != nullptr)
+			{
+
+				boneGeometry->stats.reset();
+
+			}
+
+		}
+
+	}
+
+	return MS::kSuccess;
+
+};
+
+
+std::string BoneGeometryStatsCommand::toJson(const std::vector<std::pair<MString, BoneGeometry*>>& nodes)
+/**
+Formats the aggregate counters, derived rates and any per-node counters as a JSON object.
+
+@param nodes: The named nodes to report individually.
+@return: std::string
+*/
+{
+
+	uint64_t counters[BoneGeometryStats::kNumCounters];
+	int64_t gauges[BoneGeometryStats::kNumGauges];
+
+	BoneGeometryStats::snapshot(counters, gauges);
+
+	std::ostringstream stream;
+	stream << "{\"counters\": {";
+
+	for (unsigned int i = 0; i < BoneGeometryStats::kNumCounters; i++)
+	{
+
+		stream << (i > 0 ? ", " : "") << "\"" << BoneGeometryStats::counterName(BoneGeometryStats::Counter(i)) << "\": " << counters[i];
+
+	}
+
+	stream << "}, \"gauges\": {";
+
+	for (unsigned int i = 0; i < BoneGeometryStats::kNumGauges; i++)
+	{
+
+		stream << (i > 0 ? ", " : "") << "\"" << BoneGeometryStats::gaugeName(BoneGeometryStats::Gauge(i)) << "\": " << gauges[i];
+
+	}
+
+	// Hit rates, a prepareForDraw that rebuilds nothing counts as a hit
+	//
+	uint64_t prepareForDraw = counters[BoneGeometryStats::kPrepareForDraw];
+	uint64_t geometryRebuilds = counters[BoneGeometryStats::kGeometryRebuilds];
+	uint64_t primitiveHits = counters[BoneGeometryStats::kPrimitiveCacheHits];
+	uint64_t primitiveLookups = primitiveHits + counters[BoneGeometryStats::kPrimitiveCacheMisses];
+	uint64_t preparedHits = counters[BoneGeometryStats::kPreparedCacheHits];
+	uint64_t preparedLookups = preparedHits + counters[BoneGeometryStats::kPreparedCacheMisses];
+	uint64_t batchHits = counters[BoneGeometryStats::kBatchInstanceHits];
+	uint64_t batchLookups = batchHits + counters[BoneGeometryStats::kBatchInstanceRebuilds];
+
+	stream << "}, \"rates\": {";
+	stream << "\"drawBufferHitRate\": " << getRate(prepareForDraw > geometryRebuilds ? prepareForDraw - geometryRebuilds : 0, prepareForDraw) << ", ";
+	stream << "\"primitiveCacheHitRate\": " << getRate(primitiveHits, primitiveLookups) << ", ";
+	stream << "\"preparedCacheHitRate\": " << getRate(preparedHits, preparedLookups) << ", ";
+	stream << "\"batchInstanceHitRate\": " << getRate(batchHits, batchLookups);
+	stream << "}, \"nodes\": {";
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+
+		const BoneGeometryStats::NodeCounters& stats = nodes[i].second->stats;
+
+		stream << (i > 0 ? ", " : "") << "\"" << escapeJson(nodes[i].first) << "\": {";
+		stream << "\"computes\": " << stats.computes << ", ";
+		stream << "\"prepareForDraw\": " << stats.prepareForDraw << ", ";
+		stream << "\"rebuilds\": " << stats.rebuilds << ", ";
+		stream << "\"geometryNanoseconds\": " << stats.geometryNanoseconds << "}";
+
+	}
+
+	stream << "}}";
+
+	return stream.str();
+
+};
+
+
+MStringArray BoneGeometryStatsCommand::toStringArray(const std::vector<std::pair<MString, BoneGeometry*>>& nodes)
+/**
+Formats the aggregate and per-node counters as "name=value" strings.
+Per-node counters are prefixed with the node name.
+
+@param nodes: The named nodes to report individually.
+@return: MStringArray
+*/
+{
+
+	uint64_t counters[BoneGeometryStats::kNumCounters];
+	int64_t gauges[BoneGeometryStats::kNumGauges];
+
+	BoneGeometryStats::snapshot(counters, gauges);
+
+	MStringArray results;
+
+	for (unsigned int i = 0; i < BoneGeometryStats::kNumCounters; i++)
+	{
+
+		results.append(MString(BoneGeometryStats::counterName(BoneGeometryStats::Counter(i))) + "=" + std::to_string(counters[i]).c_str());
+
+	}
+
+	for (unsigned int i = 0; i < BoneGeometryStats::kNumGauges; i++)
+	{
+
+		results.append(MString(BoneGeometryStats::gaugeName(BoneGeometryStats::Gauge(i))) + "=" + std::to_string(gauges[i]).c_str());
+
+	}
+
+	for (const std::pair<MString, BoneGeometry*>& node : nodes)
+	{
+
+		const BoneGeometryStats::NodeCounters& stats = node.second->stats;
+
+		results.append(node.first + ".computes=" + std::to_string(stats.computes).c_str());
+		results.append(node.first + ".prepareForDraw=" + std::to_string(stats.prepareForDraw).c_str());
+		results.append(node.first + ".rebuilds=" + std::to_string(stats.rebuilds).c_str());
+		results.append(node.first + ".geometryNanoseconds=" + std::to_string(stats.geometryNanoseconds).c_str());
+
+	}
+
+	return results;
+
+};
+
+
+bool BoneGeometryStatsCommand::isUndoable() const
+/**
+This command only reports, resetting the counters is not worth undoing.
+
+@return: bool
+*/
+{
+
+	return false;
+
+};
+
+
+bool BoneGeometryStatsCommand::hasSyntax() const
+/**
+This method should return true if the command has a syntax object.
+
+@return: bool
+*/
+{
+
+	return true;
+
+};
+
+
+void* BoneGeometryStatsCommand::creator()
+/**
+This function is called by Maya when a new instance is requested.
+See pluginMain.cpp for details.
+
+@return: BoneGeometryStatsCommand
+*/
+{
+
+	return new BoneGeometryStatsCommand();
+
+};
+
+
+MSyntax BoneGeometryStatsCommand::newSyntax()
+/**
+Returns the syntax for this command.
+
+@return: MSyntax
+*/
+{
+
+	MSyntax syntax;
+
+	syntax.addFlag(jsonFlag, jsonLongFlag);
+	syntax.addFlag(resetFlag, resetLongFlag);
+	syntax.addFlag(allNodesFlag, allNodesLongFlag);
+
+	syntax.setObjectType(MSyntax::kSelectionList, 0);
+	syntax.useSelectionAsDefault(false);
+
+	return syntax;
+
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef _BONE_GEOMETRY_STATS_COMMAND
+#define _BONE_GEOMETRY_STATS_COMMAND
+//
+// File: BoneGeometryStatsCommand.h
+//
+// Command: boneGeometryStats
+// Reports the plugin's performance counters, optionally for individual nodes and as JSON.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometry.h"
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryStats.h"
+
+#include <maya/MPxCommand.h>
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSyntax.h>
+#include <maya/MSelectionList.h>
+#include <maya/MObject.h>
+#include <maya/MString.h>
+#include <maya/MStringArray.h>
+#include <maya/MFnDependencyNode.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+
+class BoneGeometryStatsCommand : public MPxCommand
+{
+
+public:
+
+								BoneGeometryStatsCommand();
+	virtual						~BoneGeometryStatsCommand();
+
+	virtual	MStatus				doIt(const MArgList& args);
+	virtual	bool				isUndoable() const;
+	virtual	bool				hasSyntax() const;
+
+	static	void*				creator();
+	static	MSyntax				newSyntax();
+
+	static	MString				commandName;
+
+protected:
+
+	static	std::string			toJson(const std::vector<std::pair<MString, BoneGeometry*>>& nodes);
+	static	MStringArray		toStringArray(const std::vector<std::pair<MString, BoneGeometry*>>& nodes);
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,371 @@
+//
+// File: BoneGeometryTrace.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryTrace.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+namespace
+{
+
+	const size_t	CAPACITY = 1 << 16;
+	const size_t	NAME_LENGTH = 64;
+
+	struct Event
+	{
+
+		std::atomic<uint64_t>	sequence{ 0 };
+		int64_t					timestamp;
+		uint32_t				threadId;
+		int64_t					value;
+		char					phase;
+		char					name[NAME_LENGTH];
+
+	};
+
+	Event							events[CAPACITY];
+	std::atomic<uint64_t>			head(0);
+	std::atomic<uint64_t>			tail(0);
+	std::atomic<bool>				enabled(false);
+	std::atomic<uint32_t>			threadCount(0);
+
+	const std::chrono::steady_clock::time_point	epoch = std::chrono::steady_clock::now();
+
+	uint32_t threadId()
+	/**
+	Returns a small id unique to the calling thread, assigned on first use.
+
+	@return: uint32_t
+	*/
+	{
+
+		thread_local uint32_t id = ++threadCount;
+		return id;
+
+	};
+
+	void writeEvent(const BoneGeometryTrace::Phase phase, const char* name, const int64_t value)
+	/**
+	Writes an event into the next slot of the ring buffer.
+	Each writer claims a slot with a single atomic increment, the slot's sequence is published last so readers can skip slots that are mid-write.
+	Names longer than the slot are truncated.
+
+	@param phase: The Chrome trace-event phase.
+	@param name: The event name.
+	@param value: The counter value, ignored by other phases.
+	@return: Void.
+	*/
+	{
+
+		uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+		Event& event = events[index & (CAPACITY - 1)];
+
+		event.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+		event.threadId = threadId();
+		event.value = value;
+		event.phase = phase;
+
+		std::strncpy(event.name, name, NAME_LENGTH - 1);
+		event.name[NAME_LENGTH - 1] = '\0';
+
+		event.sequence.store(index + 1, std::memory_order_release);
+
+	};
+
+	void writeEscaped(std::ostringstream& stream, const char* string)
+	/**
+	Writes the supplied string to the stream with any JSON control characters escaped.
+
+	@param stream: The stream to write to.
+	@param string: The string to escape.
+	@return: Void.
+	*/
+	{
+
+		for (const char* character = string; *character != '\0'; character++)
+		{
+
+			if (*character == '"' || *character == '\\')
+			{
+
+				stream << '\\' << *character;
+
+			}
+			else if (static_cast<unsigned char>(*character) < 0x20)
+			{
+
+				stream << ' ';
+
+			}
+			else
+			{
+
+				stream << *character;
+
+			}
+
+		}
+
+	};
+
+};
+
+
+void BoneGeometryTrace::setEnabled(const bool enable)
+/**
+Enables or disables recording.
+
+@param enable: If true events are recorded.
+@return: Void.
+*/
+{
+
+	enabled.store(enable, std::memory_order_relaxed);
+
+};
+
+
+bool BoneGeometryTrace::isEnabled()
+/**
+Evaluates if events are being recorded.
+
+@return: bool
+*/
+{
+
+	return enabled.load(std::memory_order_relaxed);
+
+};
+
+
+void BoneGeometryTrace::record(const Phase phase, const char* name)
+/**
+Records an event if tracing is enabled.
+
+@param phase: The Chrome trace-event phase.
+@param name: The event name.
+@return: Void.
+*/
+{
+
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+
+		return;
+
+	}
+
+	writeEvent(phase, name, 0);
+
+};
+
+
+void BoneGeometryTrace::recordCounter(const char* name, const int64_t value)
+/**
+Records the value of a counter if tracing is enabled.
+Each name is shown as its own counter track on the timeline.
+
+@param name: The counter name.
+@param value: The counter value.
+@return: Void.
+*/
+{
+
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+
+		return;
+
+	}
+
+	writeEvent(kCounter, name, value);
+
+};
+
+
+void BoneGeometryTrace::clear()
+/**
+Discards every recorded event.
+
+@return: Void.
+*/
+{
+
+	tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+
+};
+
+
+size_t BoneGeometryTrace::capacity()
+/**
+Returns the maximum number of events kept by the ring buffer.
+
+@return: size_t
+*/
+{
+
+	return CAPACITY;
+
+};
+
+
+size_t BoneGeometryTrace::size()
+/**
+Returns the number of events currently held by the ring buffer.
+
+@return: size_t
+*/
+{
+
+	uint64_t count = head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+	return (count < CAPACITY) ? static_cast<size_t>(count) : CAPACITY;
+
+};
+
+
+std::string BoneGeometryTrace::toJson()
+/**
+Returns the recorded events, oldest first, as a Chrome trace-event JSON object.
+Slots that are overwritten while being read are skipped.
+
+@return: std::string
+*/
+{
+
+	uint64_t last = head.load(std::memory_order_acquire);
+	uint64_t first = tail.load(std::memory_order_acquire);
+
+	if (last - first > CAPACITY)
+	{
+
+		first = last - CAPACITY;
+
+	}
+
+	std::ostringstream stream;
+	stream.precision(3);
+	stream << std::fixed << "{\"traceEvents\": [";
+
+	bool isFirst = true;
+
+	for (uint64_t index = first; index < last; index++)
+	{
+
+		const Event& event = events[index & (CAPACITY - 1)];
+
+		// Copy the slot and check it was not rewritten while copying
+		//
+		if (event.sequence.load(std::memory_order_acquire) != index + 1)
+		{
+
+			continue;
+
+		}
+
+		int64_t timestamp = event.timestamp;
+		int64_t value = event.value;
+		uint32_t id = event.threadId;
+		char phase = event.phase;
+		char name[NAME_LENGTH];
+
+		std::memcpy(name, event.name, NAME_LENGTH);
+		name[NAME_LENGTH - 1] = '\0';
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (event.sequence.load(std::memory_order_relaxed) != index + 1)
+		{
+
+			continue;
+
+		}
+
+		// Chrome expects timestamps in microseconds
+		//
+		stream << (isFirst ? "" : ", ") << "{\"name\": \"";
+		writeEscaped(stream, name);
+		stream << "\", \"cat\": \"BoneGeometry\", \"ph\": \"" << phase << "\", \"ts\": " << (static_cast<double>(timestamp) / 1000.0) << ", \"pid\": 1, \"tid\": " << id;
+
+		if (phase == kInstant)
+		{
+
+			stream << ", \"s\": \"t\"";
+
+		}
+		else if (phase == kCounter)
+		{
+
+			stream << ", \"args\": {\"value\": " << value << "}";
+
+		}
+
+		stream << "}";
+		isFirst = false;
+
+	}
+
+	stream << "], \"displayTimeUnit\": \"ns\"}";
+
+	return stream.str();
+
+};
+
+
+bool BoneGeometryTrace::dump(const std::string& filePath)
+/**
+Writes the recorded events to the supplied file as Chrome trace-event JSON.
+
+@param filePath: The file to write.
+@return: True if the file was written.
+*/
+{
+
+	std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+
+		return false;
+
+	}
+
+	file << BoneGeometryTrace::toJson();
+	return file.good();
+
+};
+
+
+BoneGeometryTrace::Scope::Scope(const char* name) : name(name)
+/**
+Constructor.
+Records the beginning of a duration event.
+
+@param name: The event name, this must outlive the scope.
+*/
+{
+
+	BoneGeometryTrace::record(kBegin, this->name);
+
+};
+
+
+BoneGeometryTrace::Scope::~Scope()
+/**
+Destructor.
+Records the end of the duration event.
+*/
+{
+
+	BoneGeometryTrace::record(kEnd, this->name);
+
+};
\ No newline at end of file
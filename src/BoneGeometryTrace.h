@@ -0,0 +1,61 @@
+#ifndef _BONE_GEOMETRY_TRACE
+#define _BONE_GEOMETRY_TRACE
+//
+// File: BoneGeometryTrace.h
+//
+// Maya-free trace log toggled at runtime.
+// Events are timestamped, tagged with a thread id and written into a fixed-size ring buffer without locking, the oldest events are overwritten once it is full.
+// Besides durations and instants, counter events record a value per name such as the allocations made each frame.
+// The buffer can be dumped as Chrome trace-event JSON for viewing on a timeline.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace BoneGeometryTrace
+{
+
+	enum Phase : char
+	{
+
+		kBegin = 'B',
+		kEnd = 'E',
+		kInstant = 'i',
+		kCounter = 'C'
+
+	};
+
+	void		setEnabled(const bool enable);
+	bool		isEnabled();
+
+	void		record(const Phase phase, const char* name);
+	void		recordCounter(const char* name, const int64_t value);
+	void		clear();
+
+	size_t		capacity();
+	size_t		size();
+
+	bool		dump(const std::string& filePath);
+	std::string	toJson();
+
+	class Scope
+	{
+
+	public:
+
+							Scope(const char* name);
+							~Scope();
+
+	protected:
+
+		const char*			name;
+
+	};
+
+};
+#endif
\ No newline at end of file
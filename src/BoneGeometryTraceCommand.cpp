@@ -0,0 +1,191 @@
+//
+// File: BoneGeometryTraceCommand.cpp
+//
+// Command: boneGeometryTrace
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryTraceCommand.h"
+
+MString	BoneGeometryTraceCommand::commandName("boneGeometryTrace");
+MString	BoneGeometryTraceCommand::optionVarName("boneGeometryTrace");
+
+static const char* enableFlag = "-e";
+static const char* enableLongFlag = "-enable";
+static const char* clearFlag = "-c";
+static const char* clearLongFlag = "-clear";
+static const char* dumpFlag = "-d";
+static const char* dumpLongFlag = "-dump";
+static const char* sizeFlag = "-s";
+static const char* sizeLongFlag = "-size";
+
+
+BoneGeometryTraceCommand::BoneGeometryTraceCommand() {};
+BoneGeometryTraceCommand::~BoneGeometryTraceCommand() {};
+
+
+MStatus BoneGeometryTraceCommand::doIt(const MArgList& args)
+/**
+Edits or queries the trace log.
+In query mode -enable returns whether tracing is on and -size returns the number of buffered events.
+Otherwise -enable toggles tracing, -dump writes the buffered events to the supplied file and -clear discards them, in that order.
+
+@param args: The command arguments.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	MArgDatabase argDatabase(this->syntax(), args, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Check if this is a query
+	//
+	if (argDatabase.isQuery())
+	{
+
+		if (argDatabase.isFlagSet(sizeFlag))
+		{
+
+			MPxCommand::setResult(static_cast<int>(BoneGeometryTrace::size()));
+
+		}
+		else
+		{
+
+			MPxCommand::setResult(BoneGeometryTrace::isEnabled());
+
+		}
+
+		return MS::kSuccess;
+
+	}
+
+	// Toggle tracing
+	//
+	if (argDatabase.isFlagSet(enableFlag))
+	{
+
+		bool enable = false;
+
+		status = argDatabase.getFlagArgument(enableFlag, 0, enable);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		BoneGeometryTrace::setEnabled(enable);
+
+	}
+
+	// Dump buffered events
+	//
+	if (argDatabase.isFlagSet(dumpFlag))
+	{
+
+		MString filePath;
+
+		status = argDatabase.getFlagArgument(dumpFlag, 0, filePath);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		if (!BoneGeometryTrace::dump(filePath.asChar()))
+		{
+
+			this->displayError("Unable to write trace to " + filePath + "!");
+			return MS::kFailure;
+
+		}
+
+		MPxCommand::setResult(static_cast<int>(BoneGeometryTrace::size()));
+
+	}
+
+	// Discard buffered events
+	//
+	if (argDatabase.isFlagSet(clearFlag))
+	{
+
+		BoneGeometryTrace::clear();
+
+	}
+
+	return MS::kSuccess;
+
+};
+
+
+void BoneGeometryTraceCommand::initializeFromOptionVar()
+/**
+Enables tracing when the "boneGeometryTrace" option variable is set, so a trace can cover a scene from the moment the plugin loads.
+
+@return: Void.
+*/
+{
+
+	bool exists = false;
+	int value = MGlobal::optionVarIntValue(BoneGeometryTraceCommand::optionVarName, &exists);
+
+	BoneGeometryTrace::setEnabled(exists && value != 0);
+
+};
+
+
+bool BoneGeometryTraceCommand::isUndoable() const
+/**
+Tracing is a diagnostic so changes are not undoable.
+
+@return: bool
+*/
+{
+
+	return false;
+
+};
+
+
+bool BoneGeometryTraceCommand::hasSyntax() const
+/**
+This method should return true if the command has a syntax object.
+
+@return: bool
+*/
+{
+
+	return true;
+
+};
+
+
+void* BoneGeometryTraceCommand::creator()
+/**
+This function is called by Maya when a new instance is requested.
+See pluginMain.cpp for details.
+
+@return: BoneGeometryTraceCommand
+*/
+{
+
+	return new BoneGeometryTraceCommand();
+
+};
+
+
+MSyntax BoneGeometryTraceCommand::newSyntax()
+/**
+Returns the syntax for this command.
+
+@return: MSyntax
+*/
+{
+
+	MSyntax syntax;
+
+	syntax.addFlag(enableFlag, enableLongFlag, MSyntax::kBoolean);
+	syntax.addFlag(clearFlag, clearLongFlag);
+	syntax.addFlag(dumpFlag, dumpLongFlag, MSyntax::kString);
+	syntax.addFlag(sizeFlag, sizeLongFlag);
+
+	syntax.enableQuery(true);
+
+	return syntax;
+
+};
\ No newline at end of file
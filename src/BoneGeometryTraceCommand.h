@@ -0,0 +1,43 @@
+#ifndef _BONE_GEOMETRY_TRACE_COMMAND
+#define _BONE_GEOMETRY_TRACE_COMMAND
+//
+// File: BoneGeometryTraceCommand.h
+//
+// Command: boneGeometryTrace
+// Toggles the trace log and dumps it as Chrome trace-event JSON.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGeometryTrace.h"
+
+#include <maya/MPxCommand.h>
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MSyntax.h>
+#include <maya/MString.h>
+#include <maya/MGlobal.h>
+
+
+class BoneGeometryTraceCommand : public MPxCommand
+{
+
+public:
+
+								BoneGeometryTraceCommand();
+	virtual						~BoneGeometryTraceCommand();
+
+	virtual	MStatus				doIt(const MArgList& args);
+	virtual	bool				isUndoable() const;
+	virtual	bool				hasSyntax() const;
+
+	static	void*				creator();
+	static	MSyntax				newSyntax();
+
+	static	void				initializeFromOptionVar();
+
+	static	MString				commandName;
+	static	MString				optionVarName;
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+#ifndef _BONE_TOPOLOGY
+#define _BONE_TOPOLOGY
+//
+// File: BoneTopology.h
+//
+// Compile-time topology tables for the bone body and each fin configuration.
+// Vertices are ordered as the body, the side fins, the front fin and then the back fin.
+// Polygons are ordered as the body, the fin front faces and then the fin back faces, so the first numMeshPolygons form a valid single-sided mesh.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <array>
+#include <cstddef>
+
+
+namespace BoneTopology
+{
+
+	enum FinMask : unsigned int
+	{
+
+		kNoFins = 0,
+		kSideFins = 1,
+		kFrontFin = 2,
+		kBackFin = 4,
+		kAllFins = 7
+
+	};
+
+	constexpr unsigned int	NUM_CONFIGURATIONS = 8;
+
+	constexpr unsigned int	BODY_NUM_VERTICES = 9;
+	constexpr unsigned int	BODY_NUM_POLYGONS = 9;
+	constexpr unsigned int	BODY_NUM_FACE_VERTICES = 32;
+	constexpr unsigned int	BODY_NUM_EDGES = 16;
+
+	constexpr int			BODY_POLYGON_COUNTS[BODY_NUM_POLYGONS] = { 3, 3, 3, 3, 4, 4, 4, 4, 4 };
+	constexpr int			BODY_POLYGON_CONNECTS[BODY_NUM_FACE_VERTICES] = { 0, 1, 2, 0, 2, 3, 0, 4, 1, 0, 3, 4, 2, 1, 5, 6, 3, 2, 6, 7, 1, 4, 8, 5, 4, 3, 7, 8, 6, 5, 8, 7 };
+
+	constexpr unsigned int	FIN_NUM_VERTICES = 4;
+	constexpr unsigned int	FIN_NUM_EDGES = 4;
+	constexpr int			FIN_FRONT_CONNECTS[FIN_NUM_VERTICES] = { 0, 1, 2, 3 };
+	constexpr int			FIN_BACK_CONNECTS[FIN_NUM_VERTICES] = { 3, 2, 1, 0 };
+
+	constexpr unsigned int	numFins(const unsigned int mask) { return ((mask & kSideFins) ? 2 : 0) + ((mask & kFrontFin) ? 1 : 0) + ((mask & kBackFin) ? 1 : 0); }
+	constexpr unsigned int	numVertices(const unsigned int mask) { return BODY_NUM_VERTICES + (numFins(mask) * FIN_NUM_VERTICES); }
+	constexpr unsigned int	numPolygons(const unsigned int mask) { return BODY_NUM_POLYGONS + (numFins(mask) * 2); }
+	constexpr unsigned int	numMeshPolygons(const unsigned int mask) { return BODY_NUM_POLYGONS + numFins(mask); }
+	constexpr unsigned int	numFaceVertices(const unsigned int mask) { return BODY_NUM_FACE_VERTICES + (numFins(mask) * FIN_NUM_VERTICES * 2); }
+	constexpr unsigned int	numMeshFaceVertices(const unsigned int mask) { return BODY_NUM_FACE_VERTICES + (numFins(mask) * FIN_NUM_VERTICES); }
+	constexpr unsigned int	numTriangles(const unsigned int mask) { return (BODY_NUM_FACE_VERTICES - (2 * BODY_NUM_POLYGONS)) + (numFins(mask) * 4); }
+	constexpr unsigned int	numEdges(const unsigned int mask) { return BODY_NUM_EDGES + (numFins(mask) * FIN_NUM_EDGES); }
+
+	constexpr unsigned int	MAX_VERTICES = numVertices(kAllFins);
+	constexpr unsigned int	MAX_POLYGONS = numPolygons(kAllFins);
+	constexpr unsigned int	MAX_TRIANGLES = numTriangles(kAllFins);
+	constexpr unsigned int	MAX_EDGES = numEdges(kAllFins);
+
+	template<unsigned int Mask>
+	struct Topology
+	{
+
+		static constexpr unsigned int	NUM_VERTICES = numVertices(Mask);
+		static constexpr unsigned int	NUM_POLYGONS = numPolygons(Mask);
+		static constexpr unsigned int	NUM_MESH_POLYGONS = numMeshPolygons(Mask);
+		static constexpr unsigned int	NUM_FACE_VERTICES = numFaceVertices(Mask);
+		static constexpr unsigned int	NUM_MESH_FACE_VERTICES = numMeshFaceVertices(Mask);
+		static constexpr unsigned int	NUM_TRIANGLES = numTriangles(Mask);
+		static constexpr unsigned int	NUM_EDGES = numEdges(Mask);
+
+		std::array<int, NUM_POLYGONS>				polygonCounts{};
+		std::array<int, NUM_FACE_VERTICES>			polygonConnects{};
+		std::array<int, NUM_POLYGONS>				polygonOffsets{};
+		std::array<int, NUM_TRIANGLES * 3>			triangleVertices{};
+		std::array<int, NUM_TRIANGLES>				triangleFaces{};
+		std::array<int, NUM_EDGES * 2>				edgeVertices{};
+		std::array<int, NUM_EDGES>					edgeFaceCounts{};
+		unsigned int								edgesFound = 0;
+
+	};
+
+	template<unsigned int Mask>
+	constexpr Topology<Mask> createTopology()
+	/**
+	Builds the topology tables for the supplied fin configuration at compile time.
+	Triangles are fanned from the first vertex of each polygon and each triangle records the face it belongs to for flat normals.
+
+	@return: Topology
+	*/
+	{
+
+		Topology<Mask> topology;
+
+		// Append body polygons
+		//
+		unsigned int polygonIndex = 0, connectIndex = 0;
+
+		for (unsigned int i = 0; i < BODY_NUM_POLYGONS; i++)
+		{
+
+			topology.polygonCounts[polygonIndex++] = BODY_POLYGON_COUNTS[i];
+
+		}
+
+		for (unsigned int i = 0; i < BODY_NUM_FACE_VERTICES; i++)
+		{
+
+			topology.polygonConnects[connectIndex++] = BODY_POLYGON_CONNECTS[i];
+
+		}
+
+		// Append fin front faces followed by fin back faces
+		//
+		for (unsigned int side = 0; side < 2; side++)
+		{
+
+			const int* connects = (side == 0) ? FIN_FRONT_CONNECTS : FIN_BACK_CONNECTS;
+
+			for (unsigned int fin = 0; fin < numFins(Mask); fin++)
+			{
+
+				int offset = static_cast<int>(BODY_NUM_VERTICES + (fin * FIN_NUM_VERTICES));
+				topology.polygonCounts[polygonIndex++] = FIN_NUM_VERTICES;
+
+				for (unsigned int i = 0; i < FIN_NUM_VERTICES; i++)
+				{
+
+					topology.polygonConnects[connectIndex++] = offset + connects[i];
+
+				}
+
+			}
+
+		}
+
+		// Triangulate polygons
+		//
+		unsigned int offset = 0, triangleIndex = 0;
+
+		for (unsigned int i = 0; i < topology.NUM_POLYGONS; i++)
+		{
+
+			int count = topology.polygonCounts[i];
+			topology.polygonOffsets[i] = static_cast<int>(offset);
+
+			for (int j = 1; j < (count - 1); j++)
+			{
+
+				topology.triangleVertices[(triangleIndex * 3)] = topology.polygonConnects[offset];
+				topology.triangleVertices[(triangleIndex * 3) + 1] = topology.polygonConnects[offset + j];
+				topology.triangleVertices[(triangleIndex * 3) + 2] = topology.polygonConnects[offset + j + 1];
+				topology.triangleFaces[triangleIndex] = static_cast<int>(i);
+
+				triangleIndex++;
+
+			}
+
+			offset += count;
+
+		}
+
+		// Collect unique edges along with the number of faces that use them
+		//
+		offset = 0;
+
+		for (unsigned int i = 0; i < topology.NUM_POLYGONS; i++)
+		{
+
+			int count = topology.polygonCounts[i];
+
+			for (int j = 0; j < count; j++)
+			{
+
+				int start = topology.polygonConnects[offset + j];
+				int end = topology.polygonConnects[offset + ((j + 1) % count)];
+
+				int low = (start < end) ? start : end;
+				int high = (start < end) ? end : start;
+
+				bool found = false;
+
+				for (unsigned int k = 0; k < topology.edgesFound; k++)
+				{
+
+					if (topology.edgeVertices[k * 2] == low && topology.edgeVertices[(k * 2) + 1] == high)
+					{
+
+						topology.edgeFaceCounts[k]++;
+						found = true;
+						break;
+
+					}
+
+				}
+
+				if (!found && topology.edgesFound < topology.NUM_EDGES)
+				{
+
+					topology.edgeVertices[topology.edgesFound * 2] = low;
+					topology.edgeVertices[(topology.edgesFound * 2) + 1] = high;
+					topology.edgeFaceCounts[topology.edgesFound] = 1;
+
+					topology.edgesFound++;
+
+				}
+				else if (!found)
+				{
+
+					topology.edgesFound++;
+
+				}
+
+			}
+
+			offset += count;
+
+		}
+
+		return topology;
+
+	};
+
+	template<unsigned int Mask>
+	constexpr bool isConsistent(const Topology<Mask>& topology)
+	/**
+	Validates the supplied topology tables.
+	Every connect must address a valid vertex, the counts must add up, and every edge must be shared by exactly two faces.
+
+	@return: bool
+	*/
+	{
+
+		unsigned int faceVertices = 0, meshFaceVertices = 0, triangles = 0;
+
+		for (unsigned int i = 0; i < topology.NUM_POLYGONS; i++)
+		{
+
+			faceVertices += topology.polygonCounts[i];
+			meshFaceVertices += (i < topology.NUM_MESH_POLYGONS) ? topology.polygonCounts[i] : 0;
+			triangles += topology.polygonCounts[i] - 2;
+
+		}
+
+		if (faceVertices != topology.NUM_FACE_VERTICES || meshFaceVertices != topology.NUM_MESH_FACE_VERTICES || triangles != topology.NUM_TRIANGLES)
+		{
+
+			return false;
+
+		}
+
+		for (unsigned int i = 0; i < topology.NUM_FACE_VERTICES; i++)
+		{
+
+			if (topology.polygonConnects[i] < 0 || topology.polygonConnects[i] >= static_cast<int>(topology.NUM_VERTICES))
+			{
+
+				return false;
+
+			}
+
+		}
+
+		if (topology.edgesFound != topology.NUM_EDGES)
+		{
+
+			return false;
+
+		}
+
+		for (unsigned int i = 0; i < topology.NUM_EDGES; i++)
+		{
+
+			if (topology.edgeFaceCounts[i] != 2)
+			{
+
+				return false;
+
+			}
+
+		}
+
+		return true;
+
+	};
+
+	template<unsigned int Mask>
+	inline constexpr Topology<Mask> TOPOLOGY = createTopology<Mask>();
+
+	static_assert((BODY_NUM_VERTICES + BODY_NUM_POLYGONS) - BODY_NUM_EDGES == 2, "The bone body must be a closed genus zero mesh!");
+	static_assert(isConsistent(TOPOLOGY<0>), "Inconsistent bone topology without fins!");
+	static_assert(isConsistent(TOPOLOGY<1>), "Inconsistent bone topology with side fins!");
+	static_assert(isConsistent(TOPOLOGY<2>), "Inconsistent bone topology with a front fin!");
+	static_assert(isConsistent(TOPOLOGY<3>), "Inconsistent bone topology with side and front fins!");
+	static_assert(isConsistent(TOPOLOGY<4>), "Inconsistent bone topology with a back fin!");
+	static_assert(isConsistent(TOPOLOGY<5>), "Inconsistent bone topology with side and back fins!");
+	static_assert(isConsistent(TOPOLOGY<6>), "Inconsistent bone topology with front and back fins!");
+	static_assert(isConsistent(TOPOLOGY<7>), "Inconsistent bone topology with all fins!");
+
+	struct TopologyView
+	{
+
+		unsigned int	numVertices;
+		unsigned int	numPolygons;
+		unsigned int	numMeshPolygons;
+		unsigned int	numMeshFaceVertices;
+		unsigned int	numTriangles;
+		unsigned int	numEdges;
+
+		const int*		polygonCounts;
+		const int*		polygonConnects;
+		const int*		polygonOffsets;
+		const int*		triangleVertices;
+		const int*		triangleFaces;
+		const int*		edgeVertices;
+
+	};
+
+	template<unsigned int Mask>
+	constexpr TopologyView createView()
+	/**
+	Returns a runtime view onto the compile-time tables for the supplied fin configuration.
+
+	@return: TopologyView
+	*/
+	{
+
+		return TopologyView
+		{
+			TOPOLOGY<Mask>.NUM_VERTICES,
+			TOPOLOGY<Mask>.NUM_POLYGONS,
+			TOPOLOGY<Mask>.NUM_MESH_POLYGONS,
+			TOPOLOGY<Mask>.NUM_MESH_FACE_VERTICES,
+			TOPOLOGY<Mask>.NUM_TRIANGLES,
+			TOPOLOGY<Mask>.NUM_EDGES,
+			TOPOLOGY<Mask>.polygonCounts.data(),
+			TOPOLOGY<Mask>.polygonConnects.data(),
+			TOPOLOGY<Mask>.polygonOffsets.data(),
+			TOPOLOGY<Mask>.triangleVertices.data(),
+			TOPOLOGY<Mask>.triangleFaces.data(),
+			TOPOLOGY<Mask>.edgeVertices.data()
+		};
+
+	};
+
+	inline constexpr TopologyView VIEWS[NUM_CONFIGURATIONS] =
+	{
+		createView<0>(), createView<1>(), createView<2>(), createView<3>(),
+		createView<4>(), createView<5>(), createView<6>(), createView<7>()
+	};
+
+	constexpr const TopologyView& topology(const unsigned int mask) { return VIEWS[mask & kAllFins]; }
+
+};
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 //
 
 #include "Drawable.h"
+#include "PrimitiveCache.h"
 
 
 unsigned int Drawable::sum(const MIntArray& values)
@@ -62,6 +63,93 @@ This is not a 1:1 copy, there is no error checking, so please check your argumen
 };
 
 
+unsigned int Drawable::chainLength(const std::vector<MPointArray>& points)
+/**
+Returns the number of points produced by chaining the supplied arrays.
+
+@param points: A 2D array of points.
+@return: The flattened length.
+*/
+{
+
+	unsigned int length = 0;
+
+	for (const MPointArray& array : points)
+	{
+
+		length += array.length();
+
+	}
+
+	return length;
+
+};
+
+
+unsigned int Drawable::chain(const std::vector<MPointArray>& points, MPoint* output)
+/**
+Collapses a 2-dimensional array of points into a caller-provided buffer.
+The buffer must be able to hold at least chainLength(points) points, nothing is allocated.
+
+@param points: A 2D array of points.
+@param output: The buffer to write to.
+@return: The number of points written.
+*/
+{
+
+	unsigned int counter = 0;
+
+	for (const MPointArray& array : points)
+	{
+
+		unsigned int length = array.length();
+
+		for (unsigned int j = 0; j < length; j++)
+		{
+
+			output[counter + j] = array[j];
+
+		}
+
+		counter += length;
+
+	}
+
+	return counter;
+
+};
+
+
+void Drawable::chain(const std::vector<MPointArray>& points, MPointArray& output)
+/**
+Collapses a 2-dimensional array of points into a reusable passed array.
+The passed array is only resized when its length differs, so repeated calls with the same topology do not allocate.
+
+@param points: A 2D array of points.
+@param output: The passed array to write to.
+@return: void
+*/
+{
+
+	unsigned int length = Drawable::chainLength(points);
+
+	if (output.length() != length)
+	{
+
+		output.setLength(length);
+
+	}
+
+	if (length > 0)
+	{
+
+		Drawable::chain(points, &output[0]);
+
+	}
+
+};
+
+
 MPointArray Drawable::chain(const std::vector<MPointArray>& points)
 /**
 Function used to take a 2-dimensional array of points and collapse it into a single array.
@@ -72,39 +160,130 @@ If you're planning on merging seperate line lists make sure to stagger them befo
 */
 {
 
-	// Get sum of arrays
-	//
-	int length = 0;
+	MPointArray newPoints;
+	Drawable::chain(points, newPoints);
+
+	return newPoints;
+
+};
+
+
+unsigned int Drawable::staggerLength(const MPointArray& points)
+/**
+Returns the number of points produced by staggering the supplied points into a line list.
+
+@param points: A series of sequential points.
+@return: The line list length.
+*/
+{
+
+	unsigned int length = points.length();
+	return (length > 1) ? ((length - 1) * 2) : 0;
+
+};
+
+
+unsigned int Drawable::staggerLength(const std::vector<MPointArray>& points)
+/**
+Returns the number of points produced by staggering each of the supplied arrays into a single line list.
+
+@param points: A 2D array of sequential points.
+@return: The line list length.
+*/
+{
 
-	for (size_t i = 0; i < points.size(); i++)
+	unsigned int length = 0;
+
+	for (const MPointArray& array : points)
 	{
 
-		length += points[i].length();
+		length += Drawable::staggerLength(array);
 
 	}
 
-	// Pre-allocate space for all points
-	//
-	MPointArray newPoints(length, MPoint::origin);
-	int counter = 0;
+	return length;
+
+};
+
+
+unsigned int Drawable::stagger(const MPointArray& points, MPoint* output)
+/**
+Staggers a series of points into a caller-provided buffer to form a line list.
+The buffer must be able to hold at least staggerLength(points) points, nothing is allocated.
+
+@param points: A series of sequential points.
+@param output: The buffer to write to.
+@return: The number of points written.
+*/
+{
 
-	for (size_t i = 0; i < points.size(); i++)
+	unsigned int length = Drawable::staggerLength(points);
+	unsigned int i, j;
+
+	for (i = 0, j = 0; j < length; i++, j += 2)
 	{
 
-		// Assign points to array
-		//
-		for (unsigned int j = 0; j < points[i].length(); j++)
-		{
+		output[j] = points[i];
+		output[j + 1] = points[i + 1];
 
-			newPoints[counter + j] = points[i][j];
+	}
 
-		}
+	return length;
 
-		counter += points[i].length();
+};
+
+
+unsigned int Drawable::stagger(const std::vector<MPointArray>& points, MPoint* output)
+/**
+Staggers a series of 2-dimensional arrays into a caller-provided buffer to form a single line list.
+The buffer must be able to hold at least staggerLength(points) points, nothing is allocated.
+
+@param points: A 2D array of sequential points.
+@param output: The buffer to write to.
+@return: The number of points written.
+*/
+{
+
+	unsigned int counter = 0;
+
+	for (const MPointArray& array : points)
+	{
+
+		counter += Drawable::stagger(array, output + counter);
 
 	}
 
-	return newPoints;
+	return counter;
+
+};
+
+
+void Drawable::stagger(const std::vector<MPointArray>& points, MPointArray& output)
+/**
+Staggers a series of 2-dimensional arrays into a reusable passed array to form a single line list.
+The passed array is only resized when its length differs, so repeated calls with the same topology do not allocate.
+
+@param points: A 2D array of sequential points.
+@param output: The passed array to write to.
+@return: void
+*/
+{
+
+	unsigned int length = Drawable::staggerLength(points);
+
+	if (output.length() != length)
+	{
+
+		output.setLength(length);
+
+	}
+
+	if (length > 0)
+	{
+
+		Drawable::stagger(points, &output[0]);
+
+	}
 
 };
 
@@ -119,22 +298,12 @@ For example: x[4] = {a, b, c, d}; becomes y[6] = {a, b, b, c, c, d};
 */
 {
 
-	// Calculate new length
-	//
-	unsigned int length = points.length();
-	unsigned int newLength = (length - 1) * 2;
-
-	MPointArray newPoints(newLength, MPoint::origin);
+	MPointArray newPoints(Drawable::staggerLength(points), MPoint::origin);
 
-	// Iterate through points
-	//
-	unsigned int i, j;
-
-	for (i = 0, j = 0; i < (length - 1); i++, j += 2)
+	if (newPoints.length() > 0)
 	{
 
-		newPoints[j] = points[i];
-		newPoints[j + 1] = points[i + 1];
+		Drawable::stagger(points, &newPoints[0]);
 
 	}
 
@@ -153,19 +322,76 @@ For example: x[4] = {a, b, c, d}; becomes y[6] = {a, b, b, c, c, d};
 */
 {
 
-	// Calculate new length
-	//
-	size_t size = points.size();
-	std::vector<MPointArray> newPoints(size);
+	MPointArray newPoints;
+	Drawable::stagger(points, newPoints);
+
+	return newPoints;
+
+};
+
+
+unsigned int Drawable::staggerIndices(const std::vector<MPointArray>& points, unsigned int* indices)
+/**
+Writes line list indices into a caller-provided buffer instead of duplicating points.
+The indices address the chained points, for example: x[4] = {a, b, c, d}; produces y[6] = {0, 1, 1, 2, 2, 3};
+The buffer must be able to hold at least staggerLength(points) indices, nothing is allocated.
+
+@param points: A 2D array of sequential points.
+@param indices: The buffer to write to.
+@return: The number of indices written.
+*/
+{
+
+	unsigned int offset = 0, counter = 0;
+
+	for (const MPointArray& array : points)
+	{
+
+		unsigned int length = array.length();
+
+		for (unsigned int i = 1; i < length; i++, counter += 2)
+		{
+
+			indices[counter] = offset + i - 1;
+			indices[counter + 1] = offset + i;
+
+		}
+
+		offset += length;
 
-	for (size_t i = 0; i < points.size(); i++)
+	}
+
+	return counter;
+
+};
+
+
+void Drawable::staggerIndices(const std::vector<MPointArray>& points, MUintArray& indices)
+/**
+Writes line list indices into a reusable passed array, pair these with chain() to draw an indexed line list.
+The passed array is only resized when its length differs, so repeated calls with the same topology do not allocate.
+
+@param points: A 2D array of sequential points.
+@param indices: The passed array to write to.
+@return: void
+*/
+{
+
+	unsigned int length = Drawable::staggerLength(points);
+
+	if (indices.length() != length)
 	{
 
-		newPoints[i] = Drawable::stagger(points[i]);
+		indices.setLength(length);
 
 	}
 
-	return Drawable::chain(newPoints);
+	if (length > 0)
+	{
+
+		Drawable::staggerIndices(points, &indices[0]);
+
+	}
 
 };
 
@@ -458,10 +684,57 @@ Returns a scale matrix from the supplied vector.
 };
 
 
+Drawable::Point4* Drawable::pointData(MPointArray& points)
+/**
+Returns a pointer to the contiguous storage behind the supplied point array.
+Each point is laid out as four packed doubles which allows the array to be passed straight to the transform kernels.
+
+@param points: The point array.
+@return: A pointer to the first point or null if the array is empty.
+*/
+{
+
+	static_assert(sizeof(MPoint) == sizeof(Drawable::Point4), "MPoint is expected to be four packed doubles!");
+	return (points.length() > 0) ? reinterpret_cast<Drawable::Point4*>(&points[0]) : nullptr;
+
+};
+
+
+const Drawable::Point4* Drawable::pointData(const MPointArray& points)
+/**
+Returns a read-only pointer to the contiguous storage behind the supplied point array.
+
+@param points: The point array.
+@return: A pointer to the first point or null if the array is empty.
+*/
+{
+
+	return (points.length() > 0) ? reinterpret_cast<const Drawable::Point4*>(&points[0]) : nullptr;
+
+};
+
+
+Drawable::Vector3* Drawable::vectorData(MVectorArray& vectors)
+/**
+Returns a pointer to the contiguous storage behind the supplied vector array.
+Each vector is laid out as three packed doubles.
+
+@param vectors: The vector array.
+@return: A pointer to the first vector or null if the array is empty.
+*/
+{
+
+	static_assert(sizeof(MVector) == sizeof(Drawable::Vector3), "MVector is expected to be three packed doubles!");
+	return (vectors.length() > 0) ? reinterpret_cast<Drawable::Vector3*>(&vectors[0]) : nullptr;
+
+};
+
+
 void Drawable::transform(const MMatrix& matrix, MPointArray& points)
 /**
 Function used to transform an array of points using the supplied transform matrix.
 This is an in place multiplication performed on a passed array so the original values will be lost!
+The points are processed in a single batch by the fastest transform kernel the host supports.
 
 @param matrix: Transform matrix.
 @param points: A passed array of points to be multiplied.
@@ -469,17 +742,34 @@ This is an in place multiplication performed on a passed array so the original v
 */
 {
 
-	// Iterate through points
-	//
+	TransformKernel::transform(matrix.matrix, Drawable::pointData(points), points.length());
+
+};
+
+
+void Drawable::transform(const MMatrix& matrix, const MPointArray& points, MPointArray& transformed)
+/**
+Function used to transform an array of points into a separate passed array.
+The passed array is only resized when its length differs, so it can be reused between calls without reallocating.
+
+@param matrix: Transform matrix.
+@param points: An array of points to be multiplied.
+@param transformed: The passed array to write the transformed points to.
+@return: void
+*/
+{
+
 	unsigned int numPoints = points.length();
 
-	for (unsigned int i = 0; i < numPoints; i++)
+	if (transformed.length() != numPoints)
 	{
 
-		points[i] *= matrix;
+		transformed.setLength(numPoints);
 
 	}
 
+	TransformKernel::transform(matrix.matrix, Drawable::pointData(points), Drawable::pointData(transformed), numPoints);
+
 };
 
 
@@ -498,15 +788,40 @@ Unlike the other function, this method will return a brand new array.
 	// Initialize new point array
 	//
 	MPointArray newPoints(numPoints, MPoint::origin);
+	TransformKernel::transform(matrix.matrix, points, Drawable::pointData(newPoints), numPoints);
 
-	for (int i = 0; i < numPoints; i++)
+	return newPoints;
+
+};
+
+
+void Drawable::transform(const std::vector<MMatrix>& matrices, std::vector<MPointArray>& points)
+/**
+Function used to transform many point arrays with many matrices in place.
+Each point array is multiplied by the matrix at the same index, which is useful for baking a whole set of bones at once.
+
+@param matrices: The transform matrices.
+@param points: The passed point arrays to be multiplied.
+@return: void
+*/
+{
+
+	static_assert(sizeof(MMatrix) == sizeof(double[4][4]), "MMatrix is expected to be sixteen packed doubles!");
+
+	size_t count = (matrices.size() < points.size()) ? matrices.size() : points.size();
+
+	std::vector<Drawable::Point4*> pointArrays(count, nullptr);
+	std::vector<size_t> numPoints(count, 0);
+
+	for (size_t i = 0; i < count; i++)
 	{
 
-		newPoints[i] = MPoint(points[i]) * matrix;
+		pointArrays[i] = Drawable::pointData(points[i]);
+		numPoints[i] = points[i].length();
 
 	}
 
-	return newPoints;
+	TransformKernel::transformBatch(reinterpret_cast<const double(*)[4][4]>(matrices.data()), pointArrays.data(), numPoints.data(), count);
 
 };
 
@@ -622,6 +937,7 @@ Static function used to quickly generate a list of points that make up a circle.
 MObject Drawable::sphere(const MVector& center, const double radius, const int subdivisionAxis, const int subdivisionHeight, MObject& parent)
 /**
 Creates a sphere primitive in the form of a mesh data object.
+If the parent has not been initialized the sphere is instantiated from the primitive cache, otherwise it is appended to the parent.
 
 @param center: The center of the sphere.
 @param radius: The radius of the sphere.
@@ -635,12 +951,15 @@ Creates a sphere primitive in the form of a mesh data object.
 	MStatus status;
 
 	// Check if parent has been initialized
+	// If not then instantiate the sphere from the primitive cache
 	//
 	if (parent.apiType() != MFn::kMeshData)
 	{
 
-		MFnMeshData fnMeshData;
-		parent = fnMeshData.create();
+		parent = PrimitiveCache::sphere(center, radius, subdivisionAxis, subdivisionHeight).createMeshData(&status);
+		CHECK_MSTATUS(status);
+
+		return parent;
 
 	}
 
@@ -750,6 +1069,7 @@ MObject Drawable::sector(const MVector& center, const MVector& normal, const dou
 /**
 Static function used to generate a sector for drawables.
 This is essentially a disc but with a start and end angle.
+If the parent has not been initialized the sector is instantiated from the primitive cache, otherwise it is appended to the parent.
 
 @param center: The center of this sector.
 @param normal: The forward vector for this sector.
@@ -765,12 +1085,15 @@ This is essentially a disc but with a start and end angle.
 	MStatus status;
 
 	// Check if parent has been initialized
+	// If not then instantiate the sector from the primitive cache
 	//
 	if (parent.apiType() != MFn::kMeshData)
 	{
 
-		MFnMeshData fnMeshData;
-		parent = fnMeshData.create();
+		parent = PrimitiveCache::sector(center, normal, radius, startAngle, endAngle, subdivisionAxis).createMeshData(&status);
+		CHECK_MSTATUS(status);
+
+		return parent;
 
 	}
 
@@ -810,6 +1133,7 @@ This is essentially a disc but with a start and end angle.
 MObject Drawable::cylinder(const MVector& center, const MVector& normal, const double radius, const double length, const int subdivisionAxis, MObject& parent)
 /**
 Static function used to generate a cylinder for drawables.
+If the parent has not been initialized the cylinder is instantiated from the primitive cache, otherwise it is appended to the parent.
 
 @param center: The center of this cylinder.
 @param normal: The forward vector for this cylinder.
@@ -824,12 +1148,15 @@ Static function used to generate a cylinder for drawables.
 	MStatus status;
 
 	// Check if parent has been initialized
+	// If not then instantiate the cylinder from the primitive cache
 	//
 	if (parent.apiType() != MFn::kMeshData)
 	{
 
-		MFnMeshData fnMeshData;
-		parent = fnMeshData.create();
+		parent = PrimitiveCache::cylinder(center, normal, radius, length, subdivisionAxis).createMeshData(&status);
+		CHECK_MSTATUS(status);
+
+		return parent;
 
 	}
 
@@ -971,6 +1298,7 @@ No error checking is performed to test if the incoming data is valid!
 MObject Drawable::copyMeshData(const MObject& source, const MMatrix& matrix, MStatus* status)
 /**
 Copies the supplied mesh data while simultaneously transforming the control points.
+Prefer a TransformedMesh when only the points, bounds or draw buffers are required.
 
 @param source: The source mesh data to copy.
 @param matrix: The transformation matrix.
@@ -1101,12 +1429,50 @@ Static function used to populate a point array from a mesh data object.
 };
 
 
-MStatus Drawable::getLines(const MObject& meshData, MPointArray& lines)
+MStatus Drawable::getHalfEdgeMesh(const MObject& meshData, HalfEdgeMesh& mesh)
 /**
-Static function used to populate a point array from a mesh data object.
+Static function used to build the half-edge topology of a mesh data object from a single bulk query.
+Edges are numbered in order of first appearance, use matchEdgeOrder() when Maya's edge indices are required.
 
-@param meshData: Mesh data object to copy points from.
-@param matrix: Point array to copy points to.
+@param meshData: Mesh data object to copy topology from.
+@param mesh: The half-edge mesh to populate.
+@return: Status.
+*/
+{
+
+	MStatus status;
+
+	// Initialize function set
+	//
+	MFnMesh fnMesh(meshData, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Build topology from polygon connects
+	//
+	int numVertices = fnMesh.numVertices(&status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MIntArray polygonCounts, polygonConnects;
+
+	status = fnMesh.getVertices(polygonCounts, polygonConnects);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	int numPolygons = polygonCounts.length();
+
+	mesh.build(numVertices, (numPolygons > 0) ? &polygonCounts[0] : nullptr, numPolygons, (polygonConnects.length() > 0) ? &polygonConnects[0] : nullptr);
+
+	return MS::kSuccess;
+
+};
+
+
+MStatus Drawable::matchEdgeOrder(const MObject& meshData, HalfEdgeMesh& mesh)
+/**
+Static function used to renumber the edges of a half-edge mesh to match the edge indices of a mesh data object.
+The API has no bulk edge query so this costs one call per edge, only use it when edge indices are passed back to Maya.
+
+@param meshData: Mesh data object the half-edge mesh was built from.
+@param mesh: The half-edge mesh to renumber.
 @return: Status.
 */
 {
@@ -1118,17 +1484,96 @@ Static function used to populate a point array from a mesh data object.
 	MFnMesh fnMesh(meshData, &status);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
-	// Create complete component
+	// Collect edge vertices
 	//
 	int numEdges = fnMesh.numEdges(&status);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
-	MObject component = Drawable::createComponent(MFn::kMeshEdgeComponent, numEdges, &status);
+	std::vector<int> edgeVertices(numEdges * 2);
+	int2 edgeVertexIndices;
+
+	for (int i = 0; i < numEdges; i++)
+	{
+
+		status = fnMesh.getEdgeVertices(i, edgeVertexIndices);
+		CHECK_MSTATUS_AND_RETURN_IT(status);
+
+		edgeVertices[i * 2] = edgeVertexIndices[0];
+		edgeVertices[(i * 2) + 1] = edgeVertexIndices[1];
+
+	}
+
+	bool success = mesh.setEdgeOrder(edgeVertices.data(), numEdges);
+	return success ? MS::kSuccess : MS::kFailure;
+
+};
+
+
+MStatus Drawable::getLines(const MObject& meshData, MPointArray& lines)
+/**
+Static function used to populate a point array from a mesh data object.
+
+@param meshData: Mesh data object to copy points from.
+@param matrix: Point array to copy points to.
+@return: Status.
+*/
+{
+
+	MStatus status;
+
+	// Build topology
+	//
+	HalfEdgeMesh mesh;
+
+	status = Drawable::getHalfEdgeMesh(meshData, mesh);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Get points in bulk
+	//
+	MPointArray points;
+
+	status = Drawable::getPoints(meshData, points);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
 	// Call overload function
 	//
-	return Drawable::getLines(meshData, component, lines);
+	return Drawable::getLines(mesh, points, lines);
+
+};
+
+
+MStatus Drawable::getLines(const HalfEdgeMesh& mesh, const MPointArray& points, MPointArray& lines)
+/**
+Static function used to populate a point array with the start and end point of every edge.
+Lines are written in edge order.
+
+@param mesh: The half-edge topology.
+@param points: The vertex positions.
+@param lines: Point array to copy points to.
+@return: Status.
+*/
+{
+
+	MStatus status;
+
+	// Resize array to fit points
+	//
+	int numEdges = mesh.numEdges();
+
+	status = lines.setLength(numEdges * 2);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Iterate through edges
+	//
+	for (int i = 0; i < numEdges; i++)
+	{
+
+		lines[i * 2] = points[mesh.edgeStart(i)];
+		lines[(i * 2) + 1] = points[mesh.edgeEnd(i)];
+
+	}
+
+	return MS::kSuccess;
 
 };
 
@@ -1325,40 +1770,54 @@ Since passed arrays can be reused this function has been structured to only resi
 
 	MStatus status;
 
-	// Initialize iterator
+	// Build topology
 	//
-	MItMeshEdge iterEdges(meshData, &status);
+	HalfEdgeMesh mesh;
+
+	status = Drawable::getHalfEdgeMesh(meshData, mesh);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
+	status = Drawable::matchEdgeOrder(meshData, mesh);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Call overload function
+	//
+	return Drawable::getBoundary(mesh, boundary);
+
+};
+
+
+MStatus Drawable::getBoundary(const HalfEdgeMesh& mesh, MIntArray& boundary)
+/**
+Static function used to populate an element array with every edge connected to a single face.
+Since passed arrays can be reused this function has been structured to only resize arrays when needed.
+
+@param mesh: The half-edge topology.
+@param boundary: Element array to copy edges to.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
 	// Set length to maximum possible number of edges
 	//
-	int count = iterEdges.count(&status);
-	CHECK_MSTATUS_AND_RETURN_IT(status);
+	int count = mesh.numEdges();
 
 	status = boundary.setLength(count);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
-	// Iterate through elements
+	// Iterate through edges
 	//
-	bool onBoundary;
-	MPoint start, end;
-
 	int insertAt = 0;
 
-	for (iterEdges.reset(); !iterEdges.isDone(); iterEdges.next())
+	for (int i = 0; i < count; i++)
 	{
 
-		// Check if edge is on boundary
-		//
-		onBoundary = iterEdges.onBoundary(&status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
-
-		if (onBoundary)
+		if (mesh.isBoundaryEdge(i))
 		{
 
-			boundary[insertAt] = iterEdges.index(&status);
-			CHECK_MSTATUS_AND_RETURN_IT(status);
-
+			boundary[insertAt] = i;
 			insertAt += 1;
 
 		}
@@ -1419,6 +1878,60 @@ Gets the angle between two face normals.
 };
 
 
+MStatus Drawable::getFaceNormals(const HalfEdgeMesh& mesh, const MPointArray& points, MVectorArray& normals)
+/**
+Static function used to populate a vector array with the normal of every face.
+Normals are calculated using Newell's method so non-planar polygons are handled.
+
+@param mesh: The half-edge topology.
+@param points: The vertex positions.
+@param normals: Vector array to copy normals to.
+@return: Status.
+*/
+{
+
+	MStatus status;
+
+	// Resize array to fit normals
+	//
+	int numFaces = mesh.numFaces();
+
+	status = normals.setLength(numFaces);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Iterate through faces
+	//
+	for (int i = 0; i < numFaces; i++)
+	{
+
+		int start = mesh.faceHalfEdge(i);
+		int count = mesh.faceSize(i);
+
+		MVector normal(0.0, 0.0, 0.0);
+
+		for (int j = 0; j < count; j++)
+		{
+
+			int halfEdge = start + j;
+
+			const MPoint& point = points[mesh.origin(halfEdge)];
+			const MPoint& nextPoint = points[mesh.destination(halfEdge)];
+
+			normal.x += (point.y - nextPoint.y) * (point.z + nextPoint.z);
+			normal.y += (point.z - nextPoint.z) * (point.x + nextPoint.x);
+			normal.z += (point.x - nextPoint.x) * (point.y + nextPoint.y);
+
+		}
+
+		normals[i] = normal.normal();
+
+	}
+
+	return MS::kSuccess;
+
+};
+
+
 MStatus Drawable::autoSmoothEdges(MObject& meshData)
 /**
 Auto smooths the edges on the supplied mesh based on a 45 degree angle.
@@ -1430,27 +1943,44 @@ Auto smooths the edges on the supplied mesh based on a 45 degree angle.
 
 	MStatus status;
 
-	// Initialize iterator
+	// Initialize function set
+	//
+	MFnMesh fnMesh(meshData, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Build topology and face normals
 	//
-	MItMeshEdge iterEdges(meshData, &status);
+	HalfEdgeMesh mesh;
+
+	status = Drawable::getHalfEdgeMesh(meshData, mesh);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = Drawable::matchEdgeOrder(meshData, mesh);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MPointArray points;
+
+	status = fnMesh.getPoints(points);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	MVectorArray normals;
+
+	status = Drawable::getFaceNormals(mesh, points, normals);
 	CHECK_MSTATUS_AND_RETURN_IT(status);
 
 	// Iterate through edges
 	//
-	int numConnectedFaces;
-	MIntArray connectedFaces;
+	int numEdges = mesh.numEdges();
+
+	MIntArray edgeIds(numEdges), smoothings(numEdges);
+	int faces[2], insertAt = 0;
 
 	double normalAngle;
 
-	for (iterEdges.reset(); !iterEdges.isDone(); iterEdges.next())
+	for (int i = 0; i < numEdges; i++)
 	{
 
-		// Get connected faces
-		//
-		numConnectedFaces = iterEdges.getConnectedFaces(connectedFaces, &status);
-		CHECK_MSTATUS_AND_RETURN_IT(status);
-
-		switch (numConnectedFaces)
+		switch (mesh.edgeFaces(i, faces))
 		{
 
 			case 1:
@@ -1458,7 +1988,10 @@ Auto smooths the edges on the supplied mesh based on a 45 degree angle.
 
 				// Assume hard edge for boundaries
 				//
-				iterEdges.setSmoothing(false);
+				edgeIds[insertAt] = i;
+				smoothings[insertAt] = 0;
+				insertAt += 1;
+
 				break;
 
 			}
@@ -1468,21 +2001,11 @@ Auto smooths the edges on the supplied mesh based on a 45 degree angle.
 
 				// Calculate normal difference to determine edge smoothing
 				//
-				normalAngle = Drawable::getFaceNormalDifference(meshData, connectedFaces[0], connectedFaces[1], &status);
-				CHECK_MSTATUS_AND_RETURN_IT(status);
-
-				if (normalAngle > 45.0)
-				{
-
-					iterEdges.setSmoothing(false);
-
-				}
-				else
-				{
+				normalAngle = normals[faces[0]].angle(normals[faces[1]]) * (180.0 / PI);
 
-					iterEdges.setSmoothing(true);
-
-				}
+				edgeIds[insertAt] = i;
+				smoothings[insertAt] = (normalAngle > 45.0) ? 0 : 1;
+				insertAt += 1;
 
 				break;
 
@@ -1499,6 +2022,14 @@ Auto smooths the edges on the supplied mesh based on a 45 degree angle.
 
 	}
 
-	return MS::kSuccess;
+	// Apply edge smoothings in bulk
+	//
+	edgeIds.setLength(insertAt);
+	smoothings.setLength(insertAt);
+
+	status = fnMesh.setEdgeSmoothings(edgeIds, smoothings);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	return fnMesh.cleanupEdgeSmoothing();
 
 };
\ No newline at end of file
@@ -6,11 +6,15 @@
 // Author: Ben Singleton
 //
 
+#include "TransformKernel.h"
+#include "HalfEdgeMesh.h"
+
 #include <maya/MObject.h>
 #include <maya/MDagPath.h>
 #include <maya/MPoint.h>
 #include <maya/MPointArray.h>
 #include <maya/MIntArray.h>
+#include <maya/MUintArray.h>
 #include <maya/MVector.h>
 #include <maya/MVectorArray.h>
 #include <maya/MQuaternion.h>
@@ -41,10 +45,21 @@ namespace Drawable
 	unsigned int	sum(const MIntArray& values);
 	MIntArray		range(int start, int end, int increment);
 	
+	unsigned int	chainLength(const std::vector<MPointArray>& points);
+	unsigned int	chain(const std::vector<MPointArray>& points, MPoint* output);
+	void			chain(const std::vector<MPointArray>& points, MPointArray& output);
 	MPointArray		chain(const std::vector<MPointArray>& points);
 	
+	unsigned int	staggerLength(const MPointArray& points);
+	unsigned int	staggerLength(const std::vector<MPointArray>& points);
+	unsigned int	stagger(const MPointArray& points, MPoint* output);
+	unsigned int	stagger(const std::vector<MPointArray>& points, MPoint* output);
+	void			stagger(const std::vector<MPointArray>& points, MPointArray& output);
 	MPointArray		stagger(const MPointArray& points);
 	MPointArray		stagger(const std::vector<MPointArray>& points);
+
+	unsigned int	staggerIndices(const std::vector<MPointArray>& points, unsigned int* indices);
+	void			staggerIndices(const std::vector<MPointArray>& points, MUintArray& indices);
 	
 	MMatrix			composeMatrix(const MVector& center, const MVector& normal, const MVector& up, const MVector& scale);
 	MMatrix			composeMatrix(const MVector& center, const MEulerRotation& eulerRotation, const MVector& scale);
@@ -69,8 +84,16 @@ namespace Drawable
 	MMatrix			createScaleMatrix(const double scale);
 	MMatrix			createScaleMatrix(const MVector& scale);
 	
+	typedef double	Point4[4];
+	Point4*			pointData(MPointArray& points);
+	const Point4*	pointData(const MPointArray& points);
+	typedef double	Vector3[3];
+	Vector3*		vectorData(MVectorArray& vectors);
+
 	void			transform(const MMatrix& matrix, MPointArray& points);
+	void			transform(const MMatrix& matrix, const MPointArray& points, MPointArray& transformed);
 	MPointArray		transform(const MMatrix& matrix, const double points[][4], const int numPoints);
+	void			transform(const std::vector<MMatrix>& matrices, std::vector<MPointArray>& points);
 	
 	MPointArray		line(const MPoint& start, const MPoint& end);
 	MPointArray		arc(const MVector& center, const MVector& normal, const double radius, const double startAngle, const double endAngle, const int numPoints);
@@ -90,14 +113,20 @@ namespace Drawable
 	MObject			createComponent(const MFn::Type componentType, const int count, MStatus* status);
 	
 	MStatus			getPoints(const MObject& meshData, MPointArray& points);
+	MStatus			getHalfEdgeMesh(const MObject& meshData, HalfEdgeMesh& mesh);
+	MStatus			matchEdgeOrder(const MObject& meshData, HalfEdgeMesh& mesh);
 	MStatus			getBoundary(MObject& meshData, MIntArray& boundary);
+	MStatus			getBoundary(const HalfEdgeMesh& mesh, MIntArray& boundary);
 	MStatus			getLines(const MObject& meshData, MPointArray& lines);
+	MStatus			getLines(const HalfEdgeMesh& mesh, const MPointArray& points, MPointArray& lines);
 	MStatus			getLines(const MObject& meshData, MIntArray& elements, MPointArray& lines);
 	MStatus			getLines(const MObject& meshData, const MObject& component, MPointArray& lines);
 	MStatus			getTriangles(const MObject& meshData, MPointArray& triangles, MVectorArray& normals);
 	
 	double			getFaceNormalDifference(const MObject& meshData, const int polygonIndex, const int otherPolygonIndex, MStatus* status);
 	
+	MStatus			getFaceNormals(const HalfEdgeMesh& mesh, const MPointArray& points, MVectorArray& normals);
+	
 	MStatus			autoSmoothEdges(MObject& meshData);
 
 };
@@ -0,0 +1,516 @@
+//
+// File: HalfEdgeMesh.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "HalfEdgeMesh.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+
+namespace
+{
+
+	inline uint64_t edgeKey(const int start, const int end)
+	/**
+	Returns an order independent key for the edge between the supplied vertices.
+
+	@param start: The start vertex.
+	@param end: The end vertex.
+	@return: uint64_t
+	*/
+	{
+
+		uint64_t low = static_cast<uint32_t>((start < end) ? start : end);
+		uint64_t high = static_cast<uint32_t>((start < end) ? end : start);
+
+		return (low << 32) | high;
+
+	};
+
+};
+
+
+HalfEdgeMesh::HalfEdgeMesh() : vertexCount(0) {};
+
+
+HalfEdgeMesh::~HalfEdgeMesh() {};
+
+
+void HalfEdgeMesh::build(const int numVertices, const int* polygonCounts, const int numPolygons, const int* polygonConnects)
+/**
+Builds the half-edge topology from the supplied polygon counts and connects.
+Edges are numbered in order of first appearance, use setEdgeIds() or setEdgeOrder() to adopt an external numbering.
+Edges shared by more than two faces are kept but have no twins.
+
+@param numVertices: The number of vertices.
+@param polygonCounts: The number of vertices in each polygon.
+@param numPolygons: The number of polygons.
+@param polygonConnects: The vertex indices of each polygon.
+@return: Void.
+*/
+{
+
+	this->clear();
+	this->vertexCount = numVertices;
+
+	// Count half-edges
+	//
+	this->faceOffsets.resize(numPolygons + 1);
+	this->faceOffsets[0] = 0;
+
+	for (int i = 0; i < numPolygons; i++)
+	{
+
+		this->faceOffsets[i + 1] = this->faceOffsets[i] + polygonCounts[i];
+
+	}
+
+	int numHalfEdges = this->faceOffsets[numPolygons];
+
+	this->halfEdgeOrigins.assign(polygonConnects, polygonConnects + numHalfEdges);
+	this->halfEdgeNexts.resize(numHalfEdges);
+	this->halfEdgePrevs.resize(numHalfEdges);
+	this->halfEdgeTwins.assign(numHalfEdges, -1);
+	this->halfEdgeFaces.resize(numHalfEdges);
+	this->halfEdgeEdges.resize(numHalfEdges);
+
+	// Link half-edges around each face
+	//
+	for (int i = 0; i < numPolygons; i++)
+	{
+
+		int start = this->faceOffsets[i];
+		int count = polygonCounts[i];
+
+		for (int j = 0; j < count; j++)
+		{
+
+			int halfEdge = start + j;
+
+			this->halfEdgeNexts[halfEdge] = start + ((j + 1) % count);
+			this->halfEdgePrevs[halfEdge] = start + ((j + count - 1) % count);
+			this->halfEdgeFaces[halfEdge] = i;
+
+		}
+
+	}
+
+	// Collect unique edges and pair up twins
+	//
+	std::unordered_map<uint64_t, int> edges;
+	edges.reserve(numHalfEdges);
+
+	this->edgeHalfEdges.reserve(numHalfEdges);
+	this->edgeFaceCounts.reserve(numHalfEdges);
+
+	for (int halfEdge = 0; halfEdge < numHalfEdges; halfEdge++)
+	{
+
+		uint64_t key = edgeKey(this->origin(halfEdge), this->destination(halfEdge));
+		auto found = edges.find(key);
+
+		if (found == edges.end())
+		{
+
+			int edge = static_cast<int>(this->edgeHalfEdges.size());
+			edges.emplace(key, edge);
+
+			this->edgeHalfEdges.push_back(halfEdge);
+			this->edgeFaceCounts.push_back(1);
+			this->halfEdgeEdges[halfEdge] = edge;
+
+			continue;
+
+		}
+
+		int edge = found->second;
+		int first = this->edgeHalfEdges[edge];
+
+		this->halfEdgeEdges[halfEdge] = edge;
+		this->edgeFaceCounts[edge]++;
+
+		if (this->edgeFaceCounts[edge] == 2)
+		{
+
+			this->halfEdgeTwins[first] = halfEdge;
+			this->halfEdgeTwins[halfEdge] = first;
+
+		}
+		else if (this->halfEdgeTwins[first] != -1)
+		{
+
+			// Non-manifold edge, unlink the previous pair
+			//
+			this->halfEdgeTwins[this->halfEdgeTwins[first]] = -1;
+			this->halfEdgeTwins[first] = -1;
+
+		}
+
+	}
+
+	this->buildVertexEdges();
+
+};
+
+
+bool HalfEdgeMesh::setEdgeIds(const int* edgeIds)
+/**
+Renumbers the edges using an id for every half-edge, in face-vertex order.
+The topology is left untouched if the ids are not a consistent one-to-one mapping of the existing edges.
+
+@param edgeIds: The edge id for each half-edge.
+@return: True if the ids were applied.
+*/
+{
+
+	int numEdges = this->numEdges();
+	int numHalfEdges = this->numHalfEdges();
+
+	std::vector<int> newIds(numEdges, -1);
+	std::vector<char> used(numEdges, 0);
+
+	for (int halfEdge = 0; halfEdge < numHalfEdges; halfEdge++)
+	{
+
+		int edge = this->halfEdgeEdges[halfEdge];
+		int id = edgeIds[halfEdge];
+
+		if (id < 0 || id >= numEdges)
+		{
+
+			return false;
+
+		}
+
+		if (newIds[edge] == -1)
+		{
+
+			if (used[id])
+			{
+
+				return false;
+
+			}
+
+			newIds[edge] = id;
+			used[id] = 1;
+
+		}
+		else if (newIds[edge] != id)
+		{
+
+			return false;
+
+		}
+
+	}
+
+	this->renumberEdges(newIds);
+	return true;
+
+};
+
+
+bool HalfEdgeMesh::setEdgeOrder(const int* edgeVertices, const int numEdges)
+/**
+Renumbers the edges so that edge i connects edgeVertices[i * 2] and edgeVertices[(i * 2) + 1].
+The topology is left untouched if the supplied edges do not match the existing edges one-to-one.
+
+@param edgeVertices: The vertex pair for each edge.
+@param numEdges: The number of edges.
+@return: True if the order was applied.
+*/
+{
+
+	if (numEdges != this->numEdges())
+	{
+
+		return false;
+
+	}
+
+	// Map existing edges by their vertices
+	//
+	std::unordered_map<uint64_t, int> edges;
+	edges.reserve(numEdges);
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		edges.emplace(edgeKey(this->edgeStart(edge), this->edgeEnd(edge)), edge);
+
+	}
+
+	// Assign new ids
+	//
+	std::vector<int> newIds(numEdges, -1);
+
+	for (int i = 0; i < numEdges; i++)
+	{
+
+		auto found = edges.find(edgeKey(edgeVertices[i * 2], edgeVertices[(i * 2) + 1]));
+
+		if (found == edges.end() || newIds[found->second] != -1)
+		{
+
+			return false;
+
+		}
+
+		newIds[found->second] = i;
+
+	}
+
+	this->renumberEdges(newIds);
+	return true;
+
+};
+
+
+void HalfEdgeMesh::renumberEdges(const std::vector<int>& newIds)
+/**
+Applies a permutation to the edge numbering.
+
+@param newIds: The new id for each existing edge.
+@return: Void.
+*/
+{
+
+	int numEdges = this->numEdges();
+
+	std::vector<int> edgeHalfEdges(numEdges), edgeFaceCounts(numEdges);
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		edgeHalfEdges[newIds[edge]] = this->edgeHalfEdges[edge];
+		edgeFaceCounts[newIds[edge]] = this->edgeFaceCounts[edge];
+
+	}
+
+	for (int& edge : this->halfEdgeEdges)
+	{
+
+		edge = newIds[edge];
+
+	}
+
+	this->edgeHalfEdges.swap(edgeHalfEdges);
+	this->edgeFaceCounts.swap(edgeFaceCounts);
+
+	this->buildVertexEdges();
+
+};
+
+
+void HalfEdgeMesh::buildVertexEdges()
+/**
+Builds the compressed vertex to edge adjacency used by the one-ring queries.
+
+@return: Void.
+*/
+{
+
+	int numEdges = this->numEdges();
+
+	this->vertexEdgeOffsets.assign(this->vertexCount + 1, 0);
+	this->vertexEdgeIndices.resize(numEdges * 2);
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		this->vertexEdgeOffsets[this->edgeStart(edge) + 1]++;
+		this->vertexEdgeOffsets[this->edgeEnd(edge) + 1]++;
+
+	}
+
+	for (int vertex = 0; vertex < this->vertexCount; vertex++)
+	{
+
+		this->vertexEdgeOffsets[vertex + 1] += this->vertexEdgeOffsets[vertex];
+
+	}
+
+	std::vector<int> insertAt(this->vertexEdgeOffsets.begin(), this->vertexEdgeOffsets.end() - 1);
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		this->vertexEdgeIndices[insertAt[this->edgeStart(edge)]++] = edge;
+		this->vertexEdgeIndices[insertAt[this->edgeEnd(edge)]++] = edge;
+
+	}
+
+};
+
+
+void HalfEdgeMesh::clear()
+/**
+Removes all topology.
+
+@return: Void.
+*/
+{
+
+	this->vertexCount = 0;
+
+	this->halfEdgeOrigins.clear();
+	this->halfEdgeNexts.clear();
+	this->halfEdgePrevs.clear();
+	this->halfEdgeTwins.clear();
+	this->halfEdgeFaces.clear();
+	this->halfEdgeEdges.clear();
+
+	this->faceOffsets.assign(1, 0);
+
+	this->edgeHalfEdges.clear();
+	this->edgeFaceCounts.clear();
+
+	this->vertexEdgeOffsets.assign(1, 0);
+	this->vertexEdgeIndices.clear();
+
+};
+
+
+int HalfEdgeMesh::numVertices() const { return this->vertexCount; };
+int HalfEdgeMesh::numFaces() const { return static_cast<int>(this->faceOffsets.size()) - 1; };
+int HalfEdgeMesh::numEdges() const { return static_cast<int>(this->edgeHalfEdges.size()); };
+int HalfEdgeMesh::numHalfEdges() const { return static_cast<int>(this->halfEdgeOrigins.size()); };
+
+int HalfEdgeMesh::origin(const int halfEdge) const { return this->halfEdgeOrigins[halfEdge]; };
+int HalfEdgeMesh::destination(const int halfEdge) const { return this->halfEdgeOrigins[this->halfEdgeNexts[halfEdge]]; };
+int HalfEdgeMesh::next(const int halfEdge) const { return this->halfEdgeNexts[halfEdge]; };
+int HalfEdgeMesh::prev(const int halfEdge) const { return this->halfEdgePrevs[halfEdge]; };
+int HalfEdgeMesh::twin(const int halfEdge) const { return this->halfEdgeTwins[halfEdge]; };
+int HalfEdgeMesh::face(const int halfEdge) const { return this->halfEdgeFaces[halfEdge]; };
+int HalfEdgeMesh::edge(const int halfEdge) const { return this->halfEdgeEdges[halfEdge]; };
+
+int HalfEdgeMesh::faceHalfEdge(const int face) const { return this->faceOffsets[face]; };
+int HalfEdgeMesh::faceSize(const int face) const { return this->faceOffsets[face + 1] - this->faceOffsets[face]; };
+
+int HalfEdgeMesh::edgeHalfEdge(const int edge) const { return this->edgeHalfEdges[edge]; };
+int HalfEdgeMesh::edgeStart(const int edge) const { return this->origin(this->edgeHalfEdges[edge]); };
+int HalfEdgeMesh::edgeEnd(const int edge) const { return this->destination(this->edgeHalfEdges[edge]); };
+int HalfEdgeMesh::edgeFaceCount(const int edge) const { return this->edgeFaceCounts[edge]; };
+bool HalfEdgeMesh::isBoundaryEdge(const int edge) const { return this->edgeFaceCounts[edge] == 1; };
+bool HalfEdgeMesh::isManifoldEdge(const int edge) const { return this->edgeFaceCounts[edge] <= 2; };
+
+
+int HalfEdgeMesh::edgeFaces(const int edge, int faces[2]) const
+/**
+Returns the faces connected to the supplied edge.
+Only the first two faces are written, the return value is the total number of connected faces.
+
+@param edge: The edge index.
+@param faces: The passed array to write up to two faces to.
+@return: The number of connected faces.
+*/
+{
+
+	int halfEdge = this->edgeHalfEdges[edge];
+	int twin = this->halfEdgeTwins[halfEdge];
+
+	faces[0] = this->halfEdgeFaces[halfEdge];
+	faces[1] = (twin != -1) ? this->halfEdgeFaces[twin] : -1;
+
+	return this->edgeFaceCounts[edge];
+
+};
+
+
+void HalfEdgeMesh::getBoundaryEdges(std::vector<int>& edges) const
+/**
+Populates the supplied array with every edge that is connected to a single face.
+
+@param edges: The passed array to populate.
+@return: Void.
+*/
+{
+
+	edges.clear();
+
+	int numEdges = this->numEdges();
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		if (this->edgeFaceCounts[edge] == 1)
+		{
+
+			edges.push_back(edge);
+
+		}
+
+	}
+
+};
+
+
+void HalfEdgeMesh::getEdgeVertices(std::vector<int>& edgeVertices) const
+/**
+Populates the supplied array with the start and end vertex of every edge.
+
+@param edgeVertices: The passed array to populate, two vertices per edge.
+@return: Void.
+*/
+{
+
+	int numEdges = this->numEdges();
+	edgeVertices.resize(numEdges * 2);
+
+	for (int edge = 0; edge < numEdges; edge++)
+	{
+
+		edgeVertices[edge * 2] = this->edgeStart(edge);
+		edgeVertices[(edge * 2) + 1] = this->edgeEnd(edge);
+
+	}
+
+};
+
+
+void HalfEdgeMesh::getVertexEdges(const int vertex, std::vector<int>& edges) const
+/**
+Populates the supplied array with the edges connected to the supplied vertex.
+
+@param vertex: The vertex index.
+@param edges: The passed array to populate.
+@return: Void.
+*/
+{
+
+	edges.assign(this->vertexEdgeIndices.begin() + this->vertexEdgeOffsets[vertex], this->vertexEdgeIndices.begin() + this->vertexEdgeOffsets[vertex + 1]);
+
+};
+
+
+void HalfEdgeMesh::getVertexOneRing(const int vertex, std::vector<int>& vertices) const
+/**
+Populates the supplied array with the vertices that share an edge with the supplied vertex.
+Boundary and non-manifold vertices are supported since the ring is gathered from edges rather than by walking faces.
+
+@param vertex: The vertex index.
+@param vertices: The passed array to populate.
+@return: Void.
+*/
+{
+
+	int start = this->vertexEdgeOffsets[vertex];
+	int end = this->vertexEdgeOffsets[vertex + 1];
+
+	vertices.resize(end - start);
+
+	for (int i = start; i < end; i++)
+	{
+
+		int edge = this->vertexEdgeIndices[i];
+		int edgeStart = this->edgeStart(edge);
+
+		vertices[i - start] = (edgeStart == vertex) ? this->edgeEnd(edge) : edgeStart;
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef _HALF_EDGE_MESH
+#define _HALF_EDGE_MESH
+//
+// File: HalfEdgeMesh.h
+//
+// Lightweight half-edge topology built once from polygon counts and connects.
+// Boundary edges, edge-face adjacency, vertex one-rings and edge lists are answered from flat arrays in linear time.
+// Edges may be renumbered to match an external numbering, such as the edge indices of a Maya mesh.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <cstddef>
+#include <vector>
+
+
+class HalfEdgeMesh
+{
+
+public:
+
+								HalfEdgeMesh();
+	virtual						~HalfEdgeMesh();
+
+			void				build(const int numVertices, const int* polygonCounts, const int numPolygons, const int* polygonConnects);
+			bool				setEdgeIds(const int* edgeIds);
+			bool				setEdgeOrder(const int* edgeVertices, const int numEdges);
+			void				clear();
+
+			int					numVertices() const;
+			int					numFaces() const;
+			int					numEdges() const;
+			int					numHalfEdges() const;
+
+			int					origin(const int halfEdge) const;
+			int					destination(const int halfEdge) const;
+			int					next(const int halfEdge) const;
+			int					prev(const int halfEdge) const;
+			int					twin(const int halfEdge) const;
+			int					face(const int halfEdge) const;
+			int					edge(const int halfEdge) const;
+
+			int					faceHalfEdge(const int face) const;
+			int					faceSize(const int face) const;
+
+			int					edgeHalfEdge(const int edge) const;
+			int					edgeStart(const int edge) const;
+			int					edgeEnd(const int edge) const;
+			int					edgeFaceCount(const int edge) const;
+			int					edgeFaces(const int edge, int faces[2]) const;
+			bool				isBoundaryEdge(const int edge) const;
+			bool				isManifoldEdge(const int edge) const;
+
+			void				getBoundaryEdges(std::vector<int>& edges) const;
+			void				getEdgeVertices(std::vector<int>& edgeVertices) const;
+			void				getVertexEdges(const int vertex, std::vector<int>& edges) const;
+			void				getVertexOneRing(const int vertex, std::vector<int>& vertices) const;
+
+protected:
+
+			void				renumberEdges(const std::vector<int>& newIds);
+			void				buildVertexEdges();
+
+protected:
+
+			int					vertexCount;
+
+			std::vector<int>	halfEdgeOrigins;
+			std::vector<int>	halfEdgeNexts;
+			std::vector<int>	halfEdgePrevs;
+			std::vector<int>	halfEdgeTwins;
+			std::vector<int>	halfEdgeFaces;
+			std::vector<int>	halfEdgeEdges;
+
+			std::vector<int>	faceOffsets;
+
+			std::vector<int>	edgeHalfEdges;
+			std::vector<int>	edgeFaceCounts;
+
+			std::vector<int>	vertexEdgeOffsets;
+			std::vector<int>	vertexEdgeIndices;
+
+};
+#endif
\ No newline at end of file
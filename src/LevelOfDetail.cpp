@@ -0,0 +1,100 @@
+//
+// File: LevelOfDetail.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "LevelOfDetail.h"
+
+#include <algorithm>
+#include <limits>
+
+
+double LevelOfDetail::projectedSize(const double min[3], const double max[3], const double matrix[4][4], const double viewportWidth, const double viewportHeight)
+/**
+Returns the larger screen dimension, in pixels, of the supplied box projected by a row-vector object to clip space matrix.
+Boxes that cross the camera plane are treated as infinitely large so they are never reduced.
+
+@param min: The minimum corner of the box.
+@param max: The maximum corner of the box.
+@param matrix: The object to clip space matrix.
+@param viewportWidth: The viewport width in pixels.
+@param viewportHeight: The viewport height in pixels.
+@return: double
+*/
+{
+
+	double minX = std::numeric_limits<double>::max(), minY = minX;
+	double maxX = -minX, maxY = -minX;
+
+	for (int i = 0; i < 8; i++)
+	{
+
+		double x = (i & 1) ? max[0] : min[0];
+		double y = (i & 2) ? max[1] : min[1];
+		double z = (i & 4) ? max[2] : min[2];
+
+		double clipX = (x * matrix[0][0]) + (y * matrix[1][0]) + (z * matrix[2][0]) + matrix[3][0];
+		double clipY = (x * matrix[0][1]) + (y * matrix[1][1]) + (z * matrix[2][1]) + matrix[3][1];
+		double clipW = (x * matrix[0][3]) + (y * matrix[1][3]) + (z * matrix[2][3]) + matrix[3][3];
+
+		if (clipW <= 1e-9)
+		{
+
+			return std::numeric_limits<double>::infinity();
+
+		}
+
+		double ndcX = clipX / clipW, ndcY = clipY / clipW;
+
+		minX = std::min(minX, ndcX);
+		minY = std::min(minY, ndcY);
+		maxX = std::max(maxX, ndcX);
+		maxY = std::max(maxY, ndcY);
+
+	}
+
+	// Normalized device coordinates span two units across the viewport
+	//
+	return std::max((maxX - minX) * 0.5 * viewportWidth, (maxY - minY) * 0.5 * viewportHeight);
+
+};
+
+
+LevelOfDetail::Level LevelOfDetail::select(const double size, const Thresholds& thresholds)
+/**
+Returns the level of detail for the supplied projected size.
+Thresholds are evaluated from the coarsest level upwards so overlapping values favour the cheaper level.
+
+@param size: The projected size in pixels.
+@param thresholds: The pixel sizes below which each reduced level is used.
+@return: Level
+*/
+{
+
+	if (size < thresholds.hide)
+	{
+
+		return kHidden;
+
+	}
+	else if (size < thresholds.line)
+	{
+
+		return kLine;
+
+	}
+	else if (size < thresholds.wire)
+	{
+
+		return kWire;
+
+	}
+	else
+	{
+
+		return kFull;
+
+	}
+
+};
\ No newline at end of file
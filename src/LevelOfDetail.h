@@ -0,0 +1,38 @@
+#ifndef _LEVEL_OF_DETAIL
+#define _LEVEL_OF_DETAIL
+//
+// File: LevelOfDetail.h
+//
+// Maya-free screen-size level of detail selection.
+// The projected size of a bounding box is measured in pixels and compared against user thresholds.
+//
+// Author: Benjamin H. Singleton
+//
+
+namespace LevelOfDetail
+{
+
+	enum Level : unsigned int
+	{
+
+		kFull = 0,
+		kWire = 1,
+		kLine = 2,
+		kHidden = 3
+
+	};
+
+	struct Thresholds
+	{
+
+		double	wire;
+		double	line;
+		double	hide;
+
+	};
+
+	double	projectedSize(const double min[3], const double max[3], const double matrix[4][4], const double viewportWidth, const double viewportHeight);
+	Level	select(const double size, const Thresholds& thresholds);
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+//
+// File: PreparedGeometryCache.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "PreparedGeometryCache.h"
+#include "BoneGeometryDrawOverride.h"
+
+#include <maya/MGlobal.h>
+
+
+namespace
+{
+
+	const char* optionVarName = "boneGeometryPreparedCacheSize";
+
+	PreparedGeometryCache::Store cache;
+
+};
+
+
+PreparedGeometryCache::PreparedGeometry::~PreparedGeometry()
+/**
+Destructor.
+Releases the buffers from the resident bytes gauge once the cache and every draw override have let go of them.
+*/
+{
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, -this->residentBytes);
+
+};
+
+
+void PreparedGeometryCache::PreparedGeometry::build(const Key& key)
+/**
+Regenerates the points and draw buffers for the supplied key.
+The arrays are only resized when the topology changes, so rebuilding an animated shape in place never allocates.
+
+@param key: The shape to build.
+@return: Void.
+*/
+{
+
+	BoneGeometryDrawOverride::getPoints(key.finMask, key.parameters, key.matrix, this->points);
+	BoneGeometryDrawOverride::getGeometry(this->points, key.finMask, this->triangles, this->normals, this->lines);
+
+	this->residentBytes = static_cast<int64_t>(((this->points.length() + this->triangles.length() + this->lines.length()) * sizeof(MPoint)) + (this->normals.length() * sizeof(MVector)));
+
+};
+
+
+PreparedGeometryCache::Store& PreparedGeometryCache::store()
+/**
+Returns the store shared by every draw override.
+
+@return: Store
+*/
+{
+
+	return cache;
+
+};
+
+
+std::shared_ptr<const PreparedGeometryCache::PreparedGeometry> PreparedGeometryCache::get(const Key& key, BoneGeometryStats::NodeCounters* nodeCounters)
+/**
+Returns the prepared geometry for the supplied key, building it on a miss.
+
+@param key: The shape to look up.
+@param nodeCounters: Optional per-node counters to receive any rebuild.
+@return: std::shared_ptr<const PreparedGeometry>
+*/
+{
+
+	return cache.get(key, nodeCounters);
+
+};
+
+
+void PreparedGeometryCache::setCapacity(const size_t bytes)
+/**
+Updates the number of bytes the cache may hold, evicting entries if it now exceeds it.
+
+@param bytes: The capacity in bytes, zero disables caching.
+@return: Void.
+*/
+{
+
+	cache.setCapacity(bytes);
+
+};
+
+
+size_t PreparedGeometryCache::capacity()
+/**
+Returns the number of bytes the cache may hold.
+
+@return: size_t
+*/
+{
+
+	return cache.capacity();
+
+};
+
+
+size_t PreparedGeometryCache::size()
+/**
+Returns the number of cached entries.
+
+@return: size_t
+*/
+{
+
+	return cache.size();
+
+};
+
+
+size_t PreparedGeometryCache::bytes()
+/**
+Returns the number of bytes held by the cached entries.
+
+@return: size_t
+*/
+{
+
+	return cache.bytes();
+
+};
+
+
+void PreparedGeometryCache::clear()
+/**
+Removes every cached entry.
+
+@return: Void.
+*/
+{
+
+	cache.clear();
+
+};
+
+
+void PreparedGeometryCache::initializeFromOptionVar()
+/**
+Sizes the cache from the "boneGeometryPreparedCacheSize" option variable, in megabytes, when it is set.
+
+@return: Void.
+*/
+{
+
+	bool exists = false;
+	int value = MGlobal::optionVarIntValue(optionVarName, &exists);
+
+	if (exists && value >= 0)
+	{
+
+		PreparedGeometryCache::setCapacity(static_cast<size_t>(value) * 1024 * 1024);
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef _PREPARED_GEOMETRY_CACHE
+#define _PREPARED_GEOMETRY_CACHE
+//
+// File: PreparedGeometryCache.h
+//
+// Plugin-wide cache of prepared bone draw buffers keyed by fin configuration, shape parameters and object-matrix.
+// Draw overrides share entries so restoring a previously drawn shape, such as a cached playback frame or a repeated crowd bone, never regenerates geometry.
+// Each draw override holds a Slot, which stops using the cache once its shape proves to be animated, see PreparedGeometryStore.h.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "PreparedGeometryStore.h"
+#include "BoneGeometryStats.h"
+
+#include <maya/MPointArray.h>
+#include <maya/MVectorArray.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+namespace PreparedGeometryCache
+{
+
+	typedef PreparedGeometryKey Key;
+
+	struct PreparedGeometry
+	{
+
+									~PreparedGeometry();
+
+				void				build(const Key& key);
+
+				MPointArray			points;
+				MPointArray			triangles;
+				MVectorArray		normals;
+				MPointArray			lines;
+
+				int64_t				residentBytes = 0;
+
+	};
+
+	typedef PreparedGeometryStore<PreparedGeometry> Store;
+	typedef PreparedGeometrySlot<PreparedGeometry> Slot;
+
+	Store&			store();
+
+	std::shared_ptr<const PreparedGeometry>	get(const Key& key, BoneGeometryStats::NodeCounters* nodeCounters = nullptr);
+
+	void			setCapacity(const size_t bytes);
+	size_t			capacity();
+	size_t			size();
+	size_t			bytes();
+	void			clear();
+
+	void			initializeFromOptionVar();
+
+};
+#endif
\ No newline at end of file
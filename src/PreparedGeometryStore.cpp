@@ -0,0 +1,130 @@
+//
+// File: PreparedGeometryStore.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "PreparedGeometryStore.h"
+
+#include <cstring>
+
+
+namespace
+{
+
+	void hashBytes(uint64_t& hash, const void* data, const size_t size)
+	/**
+	Folds the supplied bytes into an FNV-1a hash.
+
+	@param hash: The hash to update.
+	@param data: The bytes to fold in.
+	@param size: The number of bytes.
+	@return: Void.
+	*/
+	{
+
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+		for (size_t i = 0; i < size; i++)
+		{
+
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+
+		}
+
+	};
+
+	size_t hashKey(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double matrix[4][4])
+	/**
+	Returns an FNV-1a hash over the bytes compared by PreparedGeometryKey's equality operator.
+
+	@param finMask: The fin configuration.
+	@param parameters: The shape parameters.
+	@param matrix: The object-matrix.
+	@return: size_t
+	*/
+	{
+
+		uint64_t hash = 14695981039346656037ull;
+
+		hashBytes(hash, &finMask, sizeof(finMask));
+		hashBytes(hash, &parameters, sizeof(parameters));
+		hashBytes(hash, matrix, sizeof(double) * 16);
+
+		return static_cast<size_t>(hash);
+
+	};
+
+};
+
+
+PreparedGeometryKey::PreparedGeometryKey() : finMask(~0u), parameters(), matrix()
+/**
+Constructor.
+The default key never matches a real shape.
+*/
+{
+
+	this->digest = hashKey(this->finMask, this->parameters, this->matrix);
+
+};
+
+
+PreparedGeometryKey::PreparedGeometryKey(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double objectMatrix[4][4]) : finMask(finMask), parameters(parameters)
+/**
+Constructor.
+
+@param finMask: The fin configuration.
+@param parameters: The shape parameters.
+@param objectMatrix: The object-matrix the points are generated in.
+*/
+{
+
+	std::memcpy(this->matrix, objectMatrix, sizeof(this->matrix));
+	this->digest = hashKey(this->finMask, this->parameters, this->matrix);
+
+};
+
+
+bool PreparedGeometryKey::operator==(const PreparedGeometryKey& other) const
+/**
+Equality operator.
+Values are compared bitwise so a key always matches the exact shape it was built from, the hashes are compared first to reject most mismatches early.
+
+@param other: The key to compare against.
+@return: bool
+*/
+{
+
+	return this->digest == other.digest && this->finMask == other.finMask && std::memcmp(&this->parameters, &other.parameters, sizeof(this->parameters)) == 0 && std::memcmp(this->matrix, other.matrix, sizeof(this->matrix)) == 0;
+
+};
+
+
+bool PreparedGeometryKey::operator!=(const PreparedGeometryKey& other) const
+/**
+Inequality operator.
+
+@param other: The key to compare against.
+@return: bool
+*/
+{
+
+	return !(*this == other);
+
+};
+
+
+size_t PreparedGeometryKey::hash() const
+/**
+Returns a hash over the same bytes compared by the equality operator.
+The hash is computed once on construction, the store looks it up several times per miss.
+
+@return: size_t
+*/
+{
+
+	return this->digest;
+
+};
\ No newline at end of file
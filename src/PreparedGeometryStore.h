@@ -0,0 +1,546 @@
+#ifndef _PREPARED_GEOMETRY_STORE
+#define _PREPARED_GEOMETRY_STORE
+//
+// File: PreparedGeometryStore.h
+//
+// Maya-free core of the prepared geometry cache, templated on the buffers a draw override submits.
+// PreparedGeometryStore is the thread-safe, size-bounded LRU shared between draw overrides, PreparedGeometrySlot is the per-override handle into it.
+// The store is split into shards by key hash, each with its own lock, so overrides preparing on different threads rarely wait on each other.
+// Evicted entries no override still holds are recycled, an animated crowd that keeps missing rebuilds recycled buffers in place instead of allocating new ones.
+// The geometry type must provide a build(key) method that regenerates its buffers and updates its residentBytes member.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "BoneGenerator.h"
+#include "BoneGeometryStats.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+struct PreparedGeometryKey
+{
+
+								PreparedGeometryKey();
+								PreparedGeometryKey(const unsigned int finMask, const BoneGenerator::BoneParameters& parameters, const double objectMatrix[4][4]);
+
+			bool				operator==(const PreparedGeometryKey& other) const;
+			bool				operator!=(const PreparedGeometryKey& other) const;
+
+			size_t				hash() const;
+
+			unsigned int		finMask;
+			BoneGenerator::BoneParameters	parameters;
+			double				matrix[4][4];
+
+protected:
+
+			size_t				digest;
+
+};
+
+
+template<class Geometry> class PreparedGeometryStore
+{
+
+public:
+
+	typedef std::shared_ptr<const Geometry> Entry;
+
+	static	const size_t		NUM_SHARDS = 16;
+	static	const size_t		MAX_SPARES = 64;
+
+								PreparedGeometryStore(const size_t capacity = 64 * 1024 * 1024);
+								PreparedGeometryStore(const PreparedGeometryStore&) = delete;
+
+			PreparedGeometryStore&	operator=(const PreparedGeometryStore&) = delete;
+
+			Entry				find(const PreparedGeometryKey& key);
+			Entry				add(const PreparedGeometryKey& key, BoneGeometryStats::NodeCounters* nodeCounters = nullptr);
+			Entry				get(const PreparedGeometryKey& key, BoneGeometryStats::NodeCounters* nodeCounters = nullptr);
+
+	static	void				build(const PreparedGeometryKey& key, Geometry& geometry, BoneGeometryStats::NodeCounters* nodeCounters = nullptr);
+
+			void				setCapacity(const size_t bytes);
+			size_t				capacity();
+			size_t				size();
+			size_t				bytes();
+			void				clear();
+
+protected:
+
+	struct KeyHash
+	{
+
+		size_t operator()(const PreparedGeometryKey& key) const { return key.hash(); };
+
+	};
+
+	typedef std::list<std::pair<PreparedGeometryKey, std::shared_ptr<Geometry>>> Order;
+	typedef std::unordered_map<PreparedGeometryKey, typename Order::iterator, KeyHash> Entries;
+
+	struct Shard
+	{
+
+		std::mutex								mutex;
+		Order									order;
+		Entries									entries;
+
+		Order									spares;
+		std::vector<typename Entries::node_type>	spareNodes;
+
+		size_t									maxBytes = 0;
+		size_t									numBytes = 0;
+
+	};
+
+			Shard&				shard(const PreparedGeometryKey& key);
+			void				evict(Shard& shard);
+
+			Shard				shards[NUM_SHARDS];
+			std::atomic<size_t>	maxBytes;
+
+};
+
+
+template<class Geometry> class PreparedGeometrySlot
+{
+
+public:
+
+								PreparedGeometrySlot();
+
+			const Geometry*		prepare(const PreparedGeometryKey& key, const unsigned long long revision, PreparedGeometryStore<Geometry>& store, BoneGeometryStats::NodeCounters* nodeCounters = nullptr);
+			const Geometry*		geometry() const;
+
+protected:
+
+			std::shared_ptr<const Geometry>	shared;
+			unsigned long long	revision;
+
+};
+
+
+template<class Geometry> PreparedGeometryStore<Geometry>::PreparedGeometryStore(const size_t capacity) : maxBytes(0)
+/**
+Constructor.
+
+@param capacity: The number of bytes the store may hold, zero disables caching.
+*/
+{
+
+	for (Shard& shard : this->shards)
+	{
+
+		shard.spareNodes.reserve(MAX_SPARES);
+
+	}
+
+	this->setCapacity(capacity);
+
+};
+
+
+template<class Geometry> typename PreparedGeometryStore<Geometry>::Entry PreparedGeometryStore<Geometry>::find(const PreparedGeometryKey& key)
+/**
+Returns the entry for the supplied key and marks it as the most recently used.
+
+@param key: The shape to look up.
+@return: The entry, or null on a miss.
+*/
+{
+
+	Shard& shard = this->shard(key);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.entries.find(key);
+
+	if (found == shard.entries.end())
+	{
+
+		BoneGeometryStats::add(BoneGeometryStats::kPreparedCacheMisses);
+		return nullptr;
+
+	}
+
+	shard.order.splice(shard.order.begin(), shard.order, found->second);
+	BoneGeometryStats::add(BoneGeometryStats::kPreparedCacheHits);
+
+	return found->second->second;
+
+};
+
+
+template<class Geometry> typename PreparedGeometryStore<Geometry>::Entry PreparedGeometryStore<Geometry>::add(const PreparedGeometryKey& key, BoneGeometryStats::NodeCounters* nodeCounters)
+/**
+Builds the entry for the supplied key and publishes it.
+A recycled entry is rebuilt in place whenever the shard has one, only a shard without spares allocates new geometry.
+Geometry is built outside the lock, if two threads add the same key the first entry to be published is shared.
+
+@param key: The shape to build.
+@param nodeCounters: Optional per-node counters to also receive the rebuild.
+@return: Entry
+*/
+{
+
+	Shard& shard = this->shard(key);
+
+	// Take a spare entry, its list node travels with it
+	//
+	Order spare;
+
+	{
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		if (!shard.spares.empty())
+		{
+
+			spare.splice(spare.begin(), shard.spares, shard.spares.begin());
+			BoneGeometryStats::add(BoneGeometryStats::kPreparedCacheRecycles);
+
+		}
+
+	}
+
+	if (spare.empty())
+	{
+
+		spare.emplace_front(key, std::make_shared<Geometry>());
+
+	}
+
+	std::shared_ptr<Geometry> geometry = spare.front().second;
+	PreparedGeometryStore<Geometry>::build(key, *geometry, nodeCounters);
+
+	// Publish the entry
+	//
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.entries.find(key);
+
+	if (found != shard.entries.end())
+	{
+
+		if (shard.spares.size() < MAX_SPARES)
+		{
+
+			shard.spares.splice(shard.spares.begin(), spare);
+
+		}
+
+		return found->second->second;
+
+	}
+
+	spare.front().first = key;
+	shard.order.splice(shard.order.begin(), spare);
+
+	if (!shard.spareNodes.empty())
+	{
+
+		typename Entries::node_type node = std::move(shard.spareNodes.back());
+		shard.spareNodes.pop_back();
+
+		node.key() = key;
+		node.mapped() = shard.order.begin();
+
+		shard.entries.insert(std::move(node));
+
+	}
+	else
+	{
+
+		shard.entries.emplace(key, shard.order.begin());
+
+	}
+
+	shard.numBytes += static_cast<size_t>(geometry->residentBytes);
+	this->evict(shard);
+
+	return geometry;
+
+};
+
+
+template<class Geometry> typename PreparedGeometryStore<Geometry>::Entry PreparedGeometryStore<Geometry>::get(const PreparedGeometryKey& key, BoneGeometryStats::NodeCounters* nodeCounters)
+/**
+Returns the entry for the supplied key, building it on a miss.
+
+@param key: The shape to look up.
+@param nodeCounters: Optional per-node counters to receive any rebuild.
+@return: Entry
+*/
+{
+
+	Entry entry = this->find(key);
+
+	if (entry != nullptr)
+	{
+
+		return entry;
+
+	}
+
+	return this->add(key, nodeCounters);
+
+};
+
+
+template<class Geometry> void PreparedGeometryStore<Geometry>::build(const PreparedGeometryKey& key, Geometry& geometry, BoneGeometryStats::NodeCounters* nodeCounters)
+/**
+Regenerates the supplied geometry for the supplied key and records the rebuild.
+Every buffer is built up front so the geometry can be drawn at any level of detail.
+
+@param key: The shape to build.
+@param geometry: The passed geometry to rebuild.
+@param nodeCounters: Optional per-node counters to also receive the rebuild.
+@return: Void.
+*/
+{
+
+	BoneGeometryStats::ScopedTimer timer(nodeCounters);
+
+	int64_t residentBytes = geometry.residentBytes;
+	geometry.build(key);
+
+	BoneGeometryStats::addGauge(BoneGeometryStats::kResidentBytes, geometry.residentBytes - residentBytes);
+
+	BoneGeometryStats::add(BoneGeometryStats::kGeometryRebuilds);
+
+	if (nodeCounters != nullptr)
+	{
+
+		nodeCounters->rebuilds.fetch_add(1, std::memory_order_relaxed);
+
+	}
+
+};
+
+
+template<class Geometry> typename PreparedGeometryStore<Geometry>::Shard& PreparedGeometryStore<Geometry>::shard(const PreparedGeometryKey& key)
+/**
+Returns the shard that owns the supplied key.
+
+@param key: The shape to look up.
+@return: Shard
+*/
+{
+
+	return this->shards[key.hash() % NUM_SHARDS];
+
+};
+
+
+template<class Geometry> void PreparedGeometryStore<Geometry>::evict(Shard& shard)
+/**
+Removes the least recently used entries until the shard fits its capacity.
+Entries nothing else holds are kept as spares for add() to rebuild in place, up to MAX_SPARES per shard.
+Slots still holding an evicted entry keep it alive until they move on.
+The caller must hold the shard's mutex.
+
+@param shard: The shard to evict from.
+@return: Void.
+*/
+{
+
+	while (shard.numBytes > shard.maxBytes && !shard.order.empty())
+	{
+
+		typename Order::iterator last = std::prev(shard.order.end());
+		shard.numBytes -= static_cast<size_t>(last->second->residentBytes);
+
+		typename Entries::node_type node = shard.entries.extract(last->first);
+
+		if (shard.spareNodes.size() < MAX_SPARES)
+		{
+
+			shard.spareNodes.push_back(std::move(node));
+
+		}
+
+		// Entries are only handed out under the lock, so a unique entry cannot be picked up again while it is recycled
+		//
+		if (last->second.use_count() == 1 && shard.spares.size() < MAX_SPARES)
+		{
+
+			shard.spares.splice(shard.spares.begin(), shard.order, last);
+
+		}
+		else
+		{
+
+			shard.order.erase(last);
+
+		}
+
+	}
+
+};
+
+
+template<class Geometry> void PreparedGeometryStore<Geometry>::setCapacity(const size_t bytes)
+/**
+Updates the number of bytes the store may hold, evicting entries if it now exceeds it.
+The capacity is split evenly between the shards.
+
+@param bytes: The capacity in bytes, zero disables caching.
+@return: Void.
+*/
+{
+
+	this->maxBytes = bytes;
+
+	for (Shard& shard : this->shards)
+	{
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		shard.maxBytes = bytes / NUM_SHARDS;
+		this->evict(shard);
+
+	}
+
+};
+
+
+template<class Geometry> size_t PreparedGeometryStore<Geometry>::capacity()
+/**
+Returns the number of bytes the store may hold.
+
+@return: size_t
+*/
+{
+
+	return this->maxBytes;
+
+};
+
+
+template<class Geometry> size_t PreparedGeometryStore<Geometry>::size()
+/**
+Returns the number of stored entries.
+
+@return: size_t
+*/
+{
+
+	size_t size = 0;
+
+	for (Shard& shard : this->shards)
+	{
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		size += shard.entries.size();
+
+	}
+
+	return size;
+
+};
+
+
+template<class Geometry> size_t PreparedGeometryStore<Geometry>::bytes()
+/**
+Returns the number of bytes held by the stored entries, spares are not included.
+
+@return: size_t
+*/
+{
+
+	size_t bytes = 0;
+
+	for (Shard& shard : this->shards)
+	{
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		bytes += shard.numBytes;
+
+	}
+
+	return bytes;
+
+};
+
+
+template<class Geometry> void PreparedGeometryStore<Geometry>::clear()
+/**
+Removes every stored entry and spare.
+
+@return: Void.
+*/
+{
+
+	for (Shard& shard : this->shards)
+	{
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		shard.entries.clear();
+		shard.order.clear();
+		shard.spares.clear();
+		shard.spareNodes.clear();
+		shard.numBytes = 0;
+
+	}
+
+};
+
+
+template<class Geometry> PreparedGeometrySlot<Geometry>::PreparedGeometrySlot() : shared(), revision(0)
+/**
+Constructor.
+*/
+{
+};
+
+
+template<class Geometry> const Geometry* PreparedGeometrySlot<Geometry>::prepare(const PreparedGeometryKey& key, const unsigned long long revision, PreparedGeometryStore<Geometry>& store, BoneGeometryStats::NodeCounters* nodeCounters)
+/**
+Returns the geometry for the supplied shape, only going to the store when the revision has changed.
+Every shape goes through the store, so an animated shape that is restored by cached playback finds the entry built the first time the frame was drawn.
+The previous entry is released first, so the store can recycle it if this slot was its last holder.
+
+@param key: The shape to prepare.
+@param revision: The revision of the shape, see BoneGeometryData::dirtyBoundingBox().
+@param store: The store to share entries through.
+@param nodeCounters: Optional per-node counters to receive any rebuild.
+@return: The prepared geometry.
+*/
+{
+
+	if (this->shared != nullptr && this->revision == revision)
+	{
+
+		return this->shared.get();
+
+	}
+
+	this->shared.reset();
+	this->shared = store.get(key, nodeCounters);
+	this->revision = revision;
+
+	return this->shared.get();
+
+};
+
+
+template<class Geometry> const Geometry* PreparedGeometrySlot<Geometry>::geometry() const
+/**
+Returns the geometry from the last call to prepare().
+
+@return: The prepared geometry, or null if nothing has been prepared.
+*/
+{
+
+	return this->shared.get();
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,503 @@
+//
+// File: PrimitiveCache.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "PrimitiveCache.h"
+#include "BoneGeometryStats.h"
+
+#include <maya/MQuaternion.h>
+
+#include <cmath>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+
+namespace
+{
+
+	typedef std::tuple<int, int, int, double, double> Key;
+	typedef std::list<Key> Order;
+
+	const size_t MAX_PRIMITIVES = 256;
+	const double ANGLE_STEP = 0.001;
+
+	std::mutex cacheMutex;
+	Order order;
+	std::map<Key, std::pair<std::shared_ptr<const PrimitiveCache::UnitPrimitive>, Order::iterator>> cache;
+
+	double quantizeAngle(const double angle)
+	/**
+	Rounds the supplied angle to the nearest ANGLE_STEP so angles that only differ by noise share an entry.
+
+	@param angle: The angle in degrees.
+	@return: The quantized angle in degrees.
+	*/
+	{
+
+		return std::round(angle / ANGLE_STEP) * ANGLE_STEP;
+
+	};
+
+	void addPolygon(PrimitiveCache::UnitPrimitive& primitive, const std::initializer_list<int>& vertices)
+	/**
+	Appends a polygon to the supplied primitive.
+
+	@param primitive: The primitive to append to.
+	@param vertices: The vertex indices that make up the polygon.
+	@return: Void.
+	*/
+	{
+
+		primitive.polygonCounts.append(static_cast<int>(vertices.size()));
+
+		for (int vertex : vertices)
+		{
+
+			primitive.polygonConnects.append(vertex);
+
+		}
+
+	};
+
+
+	std::shared_ptr<PrimitiveCache::UnitPrimitive> buildSphere(const int subdivisionAxis, const int subdivisionHeight)
+	/**
+	Builds a unit sphere along the x-axis, the poles are shared vertices.
+	This matches the merged output of Drawable::sphere() with a radius of one.
+
+	@param subdivisionAxis: The number of faces around the x-axis.
+	@param subdivisionHeight: The number of faces along the x-axis.
+	@return: The unit primitive.
+	*/
+	{
+
+		std::shared_ptr<PrimitiveCache::UnitPrimitive> primitive = std::make_shared<PrimitiveCache::UnitPrimitive>();
+		primitive->type = PrimitiveCache::Type::kSphere;
+
+		// Add poles and rings
+		//
+		int numRings = subdivisionHeight - 1;
+		int southPole = 1 + (numRings * subdivisionAxis);
+
+		primitive->points.setLength(southPole + 1);
+		primitive->points[0] = MPoint(1.0, 0.0, 0.0);
+		primitive->points[southPole] = MPoint(-1.0, 0.0, 0.0);
+
+		double step = 360.0 / static_cast<double>(subdivisionAxis);
+
+		for (int ring = 1; ring <= numRings; ring++)
+		{
+
+			double latitude = (static_cast<double>(ring) / static_cast<double>(subdivisionHeight)) * Drawable::PI;
+			double x = cos(latitude);
+			double radius = sin(latitude);
+
+			for (int j = 0; j < subdivisionAxis; j++)
+			{
+
+				double angle = (step * static_cast<double>(j)) * (Drawable::PI / 180.0);
+				primitive->points[1 + ((ring - 1) * subdivisionAxis) + j] = MPoint(x, radius * sin(angle), radius * cos(angle));
+
+			}
+
+		}
+
+		// Add polygons in the same order as Drawable::sphere()
+		//
+		auto ringVertex = [subdivisionAxis](const int ring, const int index) { return 1 + ((ring - 1) * subdivisionAxis) + index; };
+
+		for (int i = 0; i < subdivisionHeight; i++)
+		{
+
+			for (int j = 0; j < subdivisionAxis; j++)
+			{
+
+				int startIndex = j;
+				int endIndex = (j < (subdivisionAxis - 1)) ? (startIndex + 1) : 0;
+
+				if (i == 0)
+				{
+
+					addPolygon(*primitive, { 0, ringVertex(1, endIndex), ringVertex(1, startIndex) });
+
+				}
+				else if (i < (subdivisionHeight - 1))
+				{
+
+					addPolygon(*primitive, { ringVertex(i, startIndex), ringVertex(i, endIndex), ringVertex(i + 1, endIndex), ringVertex(i + 1, startIndex) });
+
+				}
+				else
+				{
+
+					addPolygon(*primitive, { ringVertex(i, startIndex), ringVertex(i, endIndex), southPole });
+
+				}
+
+			}
+
+		}
+
+		primitive->buildTopology();
+		return primitive;
+
+	};
+
+
+	std::shared_ptr<PrimitiveCache::UnitPrimitive> buildSector(const int subdivisionAxis, const double startAngle, const double endAngle)
+	/**
+	Builds a unit sector on the yz plane facing down the x-axis.
+	Closed sectors, such as discs, share their first and last arc vertex.
+
+	@param subdivisionAxis: The number of faces around the x-axis.
+	@param startAngle: The start angle in degrees.
+	@param endAngle: The end angle in degrees.
+	@return: The unit primitive.
+	*/
+	{
+
+		std::shared_ptr<PrimitiveCache::UnitPrimitive> primitive = std::make_shared<PrimitiveCache::UnitPrimitive>();
+		primitive->type = PrimitiveCache::Type::kSector;
+
+		// Add arc points followed by the center
+		//
+		double sweep = endAngle - startAngle;
+		bool closed = (sweep != 0.0) && (std::fabs(std::remainder(sweep, 360.0)) < 1e-9);
+
+		int numArcPoints = closed ? subdivisionAxis : (subdivisionAxis + 1);
+		int center = numArcPoints;
+
+		primitive->points.setLength(numArcPoints + 1);
+		primitive->points[center] = MPoint::origin;
+
+		double step = sweep / static_cast<double>(subdivisionAxis);
+
+		for (int i = 0; i < numArcPoints; i++)
+		{
+
+			double angle = (startAngle + (step * static_cast<double>(i))) * (Drawable::PI / 180.0);
+			primitive->points[i] = MPoint(0.0, sin(angle), cos(angle));
+
+		}
+
+		// Add triangles
+		//
+		for (int i = 0; i < subdivisionAxis; i++)
+		{
+
+			int next = (closed && (i + 1) == numArcPoints) ? 0 : (i + 1);
+			addPolygon(*primitive, { i, next, center });
+
+		}
+
+		primitive->buildTopology();
+		return primitive;
+
+	};
+
+
+	std::shared_ptr<PrimitiveCache::UnitPrimitive> buildCylinder(const int subdivisionAxis, MStatus* status)
+	/**
+	Builds a unit cylinder along the x-axis with a radius and length of one.
+	The edge smoothing is evaluated once here, it is unaffected by the radius, length or orientation of an instance.
+
+	@param subdivisionAxis: The number of faces around the x-axis.
+	@param status: Return status.
+	@return: The unit primitive.
+	*/
+	{
+
+		std::shared_ptr<PrimitiveCache::UnitPrimitive> primitive = std::make_shared<PrimitiveCache::UnitPrimitive>();
+		primitive->type = PrimitiveCache::Type::kCylinder;
+
+		// Add front ring, back ring and cap centers
+		//
+		int frontCenter = subdivisionAxis * 2;
+		int backCenter = frontCenter + 1;
+
+		primitive->points.setLength(backCenter + 1);
+		primitive->points[frontCenter] = MPoint(0.5, 0.0, 0.0);
+		primitive->points[backCenter] = MPoint(-0.5, 0.0, 0.0);
+
+		double step = 360.0 / static_cast<double>(subdivisionAxis);
+
+		for (int i = 0; i < subdivisionAxis; i++)
+		{
+
+			double angle = (step * static_cast<double>(i)) * (Drawable::PI / 180.0);
+
+			primitive->points[i] = MPoint(0.5, sin(angle), cos(angle));
+			primitive->points[subdivisionAxis + i] = MPoint(-0.5, sin(angle), cos(angle));
+
+		}
+
+		// Add caps and bridges in the same order as Drawable::cylinder()
+		//
+		for (int i = 0; i < subdivisionAxis; i++)
+		{
+
+			int next = (i + 1) % subdivisionAxis;
+
+			addPolygon(*primitive, { i, next, frontCenter });
+			addPolygon(*primitive, { subdivisionAxis + i, subdivisionAxis + next, backCenter });
+			addPolygon(*primitive, { i, next, subdivisionAxis + next, subdivisionAxis + i });
+
+		}
+
+		// Evaluate edge smoothing and adopt the edge order of the mesh data
+		//
+		MObject meshData = Drawable::createMeshData(primitive->points, primitive->polygonCounts, primitive->polygonConnects, status);
+		CHECK_MSTATUS_AND_RETURN(*status, primitive);
+
+		*status = Drawable::autoSmoothEdges(meshData);
+		CHECK_MSTATUS_AND_RETURN(*status, primitive);
+
+		*status = primitive->build(meshData);
+		CHECK_MSTATUS_AND_RETURN(*status, primitive);
+
+		return primitive;
+
+	};
+
+
+	MMatrix orientMatrix(const MVector& center, const MVector& normal, const double x, const double y, const double z)
+	/**
+	Returns the matrix that scales a unit primitive, aligns its x-axis with the supplied normal and moves it to the center.
+
+	@param center: The center of the instance.
+	@param normal: The forward vector of the instance.
+	@param x: The scale along the normal.
+	@param y: The scale along the y-axis.
+	@param z: The scale along the z-axis.
+	@return: MMatrix
+	*/
+	{
+
+		MMatrix rotateMatrix = MVector::xAxis.rotateTo(normal).asMatrix();
+		return Drawable::createScaleMatrix(x, y, z) * rotateMatrix * Drawable::createPositionMatrix(center);
+
+	};
+
+};
+
+
+std::shared_ptr<const PrimitiveCache::UnitPrimitive> PrimitiveCache::get(const Type type, const int subdivisionAxis, const int subdivisionHeight, const double startAngle, const double endAngle)
+/**
+Returns the unit primitive for the supplied key, building it on first use.
+Parameters that do not apply to a primitive type are ignored so equivalent requests share an entry.
+Subdivisions are clamped to the minimum that produces a valid mesh and sector angles are quantized to a thousandth of a degree.
+Primitives are built outside the lock, the cache holds the MAX_PRIMITIVES most recently used and a primitive that failed to build is never cached.
+
+@param type: The primitive type.
+@param subdivisionAxis: The number of faces around the x-axis.
+@param subdivisionHeight: The number of faces along the x-axis, spheres only.
+@param startAngle: The start angle in degrees, sectors only.
+@param endAngle: The end angle in degrees, sectors only.
+@return: The shared unit primitive.
+*/
+{
+
+	// Normalize key
+	//
+	int axis = (subdivisionAxis > 3) ? subdivisionAxis : 3;
+	int height = (type == Type::kSphere) ? ((subdivisionHeight > 2) ? subdivisionHeight : 2) : 0;
+	double start = (type == Type::kSector) ? quantizeAngle(startAngle) : 0.0;
+	double end = (type == Type::kSector) ? quantizeAngle(endAngle) : 0.0;
+
+	if (type == Type::kSector)
+	{
+
+		axis = (subdivisionAxis > 1) ? subdivisionAxis : 1;
+
+	}
+
+	Key key = std::make_tuple(static_cast<int>(type), axis, height, start, end);
+
+	// Check if primitive already exists
+	//
+	{
+
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		auto found = cache.find(key);
+
+		if (found != cache.end())
+		{
+
+			order.splice(order.begin(), order, found->second.second);
+			BoneGeometryStats::add(BoneGeometryStats::kPrimitiveCacheHits);
+
+			return found->second.first;
+
+		}
+
+	}
+
+	BoneGeometryStats::add(BoneGeometryStats::kPrimitiveCacheMisses);
+
+	// Build primitive
+	//
+	MStatus status = MS::kSuccess;
+	std::shared_ptr<const UnitPrimitive> primitive;
+
+	switch (type)
+	{
+
+		case Type::kSphere:
+			primitive = buildSphere(axis, height);
+			break;
+
+		case Type::kCylinder:
+			primitive = buildCylinder(axis, &status);
+			CHECK_MSTATUS(status);
+			break;
+
+		case Type::kSector:
+			primitive = buildSector(axis, start, end);
+			break;
+
+	}
+
+	if (!status)
+	{
+
+		return primitive;
+
+	}
+
+	// Publish primitive, if another thread built the same key first its primitive is shared instead
+	//
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto found = cache.find(key);
+
+	if (found != cache.end())
+	{
+
+		return found->second.first;
+
+	}
+
+	order.push_front(key);
+	cache.emplace(key, std::make_pair(primitive, order.begin()));
+
+	while (cache.size() > MAX_PRIMITIVES)
+	{
+
+		cache.erase(order.back());
+		order.pop_back();
+
+	}
+
+	return primitive;
+
+};
+
+
+PrimitiveCache::Instance PrimitiveCache::sphere(const MVector& center, const double radius, const int subdivisionAxis, const int subdivisionHeight)
+/**
+Returns a sphere instance, see Drawable::sphere().
+
+@param center: The center of the sphere.
+@param radius: The radius of the sphere.
+@param subdivisionAxis: The number of faces around the x-axis.
+@param subdivisionHeight: The number of faces along the x-axis.
+@return: Instance
+*/
+{
+
+	MMatrix matrix = Drawable::createScaleMatrix(radius) * Drawable::createPositionMatrix(center);
+	return Instance(PrimitiveCache::get(Type::kSphere, subdivisionAxis, subdivisionHeight, 0.0, 0.0), matrix);
+
+};
+
+
+PrimitiveCache::Instance PrimitiveCache::cylinder(const MVector& center, const MVector& normal, const double radius, const double length, const int subdivisionAxis)
+/**
+Returns a cylinder instance, see Drawable::cylinder().
+As with Drawable::cylinder() the caps are offset by the unnormalized normal.
+
+@param center: The center of the cylinder.
+@param normal: The forward vector of the cylinder.
+@param radius: The radius of the cylinder.
+@param length: The length of the cylinder.
+@param subdivisionAxis: The number of faces around the x-axis.
+@return: Instance
+*/
+{
+
+	MMatrix matrix = orientMatrix(center, normal, length * normal.length(), radius, radius);
+	return Instance(PrimitiveCache::get(Type::kCylinder, subdivisionAxis, 0, 0.0, 0.0), matrix);
+
+};
+
+
+PrimitiveCache::Instance PrimitiveCache::disc(const MVector& center, const MVector& normal, const double radius, const int subdivisionAxis)
+/**
+Returns a disc instance, see Drawable::disc().
+
+@param center: The center of the disc.
+@param normal: The forward vector of the disc.
+@param radius: The radius of the disc.
+@param subdivisionAxis: The number of faces around the x-axis.
+@return: Instance
+*/
+{
+
+	return PrimitiveCache::sector(center, normal, radius, 0.0, 360.0, subdivisionAxis);
+
+};
+
+
+PrimitiveCache::Instance PrimitiveCache::sector(const MVector& center, const MVector& normal, const double radius, const double startAngle, const double endAngle, const int subdivisionAxis)
+/**
+Returns a sector instance, see Drawable::sector().
+
+@param center: The center of the sector.
+@param normal: The forward vector of the sector.
+@param radius: The radius of the sector.
+@param startAngle: The start angle in degrees.
+@param endAngle: The end angle in degrees.
+@param subdivisionAxis: The number of faces around the x-axis.
+@return: Instance
+*/
+{
+
+	MMatrix matrix = orientMatrix(center, normal, radius, radius, radius);
+	return Instance(PrimitiveCache::get(Type::kSector, subdivisionAxis, 0, startAngle, endAngle), matrix);
+
+};
+
+
+size_t PrimitiveCache::size()
+/**
+Returns the number of cached unit primitives.
+
+@return: size_t
+*/
+{
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return cache.size();
+
+};
+
+
+void PrimitiveCache::clear()
+/**
+Removes all cached unit primitives.
+Existing instances keep their primitive alive until they are released.
+
+@return: Void.
+*/
+{
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	cache.clear();
+	order.clear();
+
+};
\ No newline at end of file
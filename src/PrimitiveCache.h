@@ -0,0 +1,57 @@
+#ifndef _PRIMITIVE_CACHE
+#define _PRIMITIVE_CACHE
+//
+// File: PrimitiveCache.h
+//
+// Thread-safe, size-bounded cache of unit-space primitives keyed by type, subdivisions and angle range.
+// Callers receive the shared topology together with a transform, mesh data is only created when a real MObject is required.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "Drawable.h"
+#include "TransformedMesh.h"
+
+#include <maya/MObject.h>
+#include <maya/MPointArray.h>
+#include <maya/MIntArray.h>
+#include <maya/MVector.h>
+#include <maya/MMatrix.h>
+#include <maya/MStatus.h>
+
+#include <memory>
+
+
+namespace PrimitiveCache
+{
+
+	enum class Type
+	{
+
+		kSphere = 0,
+		kCylinder = 1,
+		kSector = 2
+
+	};
+
+	struct UnitPrimitive : public SharedMesh
+	{
+
+		Type			type;
+
+	};
+
+	typedef TransformedMesh	Instance;
+
+	std::shared_ptr<const UnitPrimitive>	get(const Type type, const int subdivisionAxis, const int subdivisionHeight, const double startAngle, const double endAngle);
+
+	Instance		sphere(const MVector& center, const double radius, const int subdivisionAxis, const int subdivisionHeight);
+	Instance		cylinder(const MVector& center, const MVector& normal, const double radius, const double length, const int subdivisionAxis);
+	Instance		disc(const MVector& center, const MVector& normal, const double radius, const int subdivisionAxis);
+	Instance		sector(const MVector& center, const MVector& normal, const double radius, const double startAngle, const double endAngle, const int subdivisionAxis);
+
+	size_t			size();
+	void			clear();
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+//
+// File: ScratchArena.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "ScratchArena.h"
+#include "BoneGeometryAllocations.h"
+
+#include <cstdint>
+
+
+ScratchArena::ScratchArena(const size_t blockSize) : blockSize(blockSize), blockIndex(0), offset(0)
+/**
+Constructor.
+No memory is reserved until the first allocation.
+
+@param blockSize: The minimum size of each block in bytes.
+*/
+{
+};
+
+
+ScratchArena::~ScratchArena()
+/**
+Destructor.
+*/
+{
+};
+
+
+ScratchArena& ScratchArena::local()
+/**
+Returns the arena owned by the calling thread.
+Viewport 2.0 may prepare on several threads at once, each gets its own arena so allocating never needs to synchronize.
+
+@return: ScratchArena
+*/
+{
+
+	thread_local ScratchArena arena;
+	return arena;
+
+};
+
+
+void* ScratchArena::allocate(const size_t size, const size_t alignment)
+/**
+Returns uninitialized memory that remains valid until the arena is rewound past it.
+The current block is used when it has room, otherwise the next retained block that fits, and only then a new block.
+
+@param size: The number of bytes to allocate.
+@param alignment: The required alignment, this must be a power of two.
+@return: void*
+*/
+{
+
+	while (this->blockIndex < this->blocks.size())
+	{
+
+		Block& block = this->blocks[this->blockIndex];
+
+		uintptr_t address = reinterpret_cast<uintptr_t>(block.data.get()) + this->offset;
+		size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+		if (this->offset + padding + size <= block.size)
+		{
+
+			this->offset += padding + size;
+			return reinterpret_cast<void*>(address + padding);
+
+		}
+
+		// Move on to the next block, inserting a large enough one if it would not fit either
+		//
+		this->blockIndex++;
+		this->offset = 0;
+
+		if (this->blockIndex < this->blocks.size() && this->blocks[this->blockIndex].size < size + alignment)
+		{
+
+			this->addBlock(this->blockIndex, size + alignment);
+
+		}
+
+	}
+
+	this->addBlock(this->blocks.size(), size + alignment);
+	return this->allocate(size, alignment);
+
+};
+
+
+ScratchArena::Marker ScratchArena::mark() const
+/**
+Returns the current position so it can be restored with rewind().
+
+@return: Marker
+*/
+{
+
+	return { this->blockIndex, this->offset };
+
+};
+
+
+void ScratchArena::rewind(const Marker& marker)
+/**
+Releases every allocation made since the supplied marker.
+Rewinding to the start merges any overflow blocks so the next pass fits in a single block.
+
+@param marker: A marker returned by mark().
+@return: Void.
+*/
+{
+
+	this->blockIndex = marker.block;
+	this->offset = marker.offset;
+
+	if (this->blockIndex == 0 && this->offset == 0)
+	{
+
+		this->consolidate();
+
+	}
+
+};
+
+
+void ScratchArena::reset()
+/**
+Releases every allocation while keeping the blocks for reuse.
+
+@return: Void.
+*/
+{
+
+	this->rewind({ 0, 0 });
+
+};
+
+
+size_t ScratchArena::capacity() const
+/**
+Returns the number of bytes held by the arena's blocks.
+
+@return: size_t
+*/
+{
+
+	size_t capacity = 0;
+
+	for (const Block& block : this->blocks)
+	{
+
+		capacity += block.size;
+
+	}
+
+	return capacity;
+
+};
+
+
+size_t ScratchArena::used() const
+/**
+Returns the number of bytes between the start of the arena and the current position, including padding and any unused tails of earlier blocks.
+
+@return: size_t
+*/
+{
+
+	size_t used = this->offset;
+
+	for (size_t i = 0; i < this->blockIndex && i < this->blocks.size(); i++)
+	{
+
+		used += this->blocks[i].size;
+
+	}
+
+	return used;
+
+};
+
+
+void ScratchArena::addBlock(const size_t index, const size_t size)
+/**
+Inserts a new block at the supplied index.
+
+@param index: The index to insert at.
+@param size: The minimum size of the block in bytes.
+@return: Void.
+*/
+{
+
+	size_t blockSize = (size > this->blockSize) ? size : this->blockSize;
+
+	Block block;
+	block.data.reset(new char[blockSize]);
+	block.size = blockSize;
+
+	this->blocks.insert(this->blocks.begin() + index, std::move(block));
+
+	BoneGeometryAllocations::record(BoneGeometryAllocations::kScratch, blockSize);
+
+};
+
+
+void ScratchArena::consolidate()
+/**
+Replaces multiple blocks with a single block of their combined size.
+Only valid while nothing is allocated.
+
+@return: Void.
+*/
+{
+
+	if (this->blocks.size() < 2)
+	{
+
+		return;
+
+	}
+
+	size_t size = this->capacity();
+
+	this->blocks.clear();
+	this->addBlock(0, size);
+
+};
+
+
+ScratchArena::Scope::Scope(ScratchArena& arena) : arena(arena), marker(arena.mark())
+/**
+Constructor.
+Records the arena's position.
+
+@param arena: The arena to rewind.
+*/
+{
+};
+
+
+ScratchArena::Scope::~Scope()
+/**
+Destructor.
+Releases every allocation made within the scope.
+*/
+{
+
+	this->arena.rewind(this->marker);
+
+};
\ No newline at end of file
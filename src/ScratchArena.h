@@ -0,0 +1,104 @@
+#ifndef _SCRATCH_ARENA
+#define _SCRATCH_ARENA
+//
+// File: ScratchArena.h
+//
+// Maya-free, per-thread bump allocator for scratch buffers that only live for a single prepare.
+// Allocating advances an offset into a retained block and a Scope rewinds it, individual allocations are never freed.
+// Blocks are kept between prepares, overflow blocks are merged into one on the next full rewind so a steady workload stops touching the heap.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+class ScratchArena
+{
+
+public:
+
+	struct Marker
+	{
+
+		size_t	block;
+		size_t	offset;
+
+	};
+
+	class Scope
+	{
+
+	public:
+
+								Scope(ScratchArena& arena);
+								~Scope();
+
+	protected:
+
+			ScratchArena&		arena;
+			Marker				marker;
+
+	};
+
+	template<typename T> class Allocator
+	{
+
+	public:
+
+		typedef T	value_type;
+
+							Allocator(ScratchArena& arena) : arena(&arena) {};
+		template<typename U>	Allocator(const Allocator<U>& other) : arena(other.arena) {};
+
+		T*					allocate(const size_t count) { return this->arena->allocate<T>(count); };
+		void				deallocate(T* pointer, const size_t count) {};
+
+		template<typename U>	bool operator==(const Allocator<U>& other) const { return this->arena == other.arena; };
+		template<typename U>	bool operator!=(const Allocator<U>& other) const { return this->arena != other.arena; };
+
+		ScratchArena*		arena;
+
+	};
+
+								ScratchArena(const size_t blockSize = 64 * 1024);
+								ScratchArena(const ScratchArena&) = delete;
+	virtual						~ScratchArena();
+
+			ScratchArena&		operator=(const ScratchArena&) = delete;
+
+	static	ScratchArena&		local();
+
+			void*				allocate(const size_t size, const size_t alignment = alignof(std::max_align_t));
+	template<typename T> T*		allocate(const size_t count) { return static_cast<T*>(this->allocate(count * sizeof(T), alignof(T))); };
+
+			Marker				mark() const;
+			void				rewind(const Marker& marker);
+			void				reset();
+
+			size_t				capacity() const;
+			size_t				used() const;
+
+protected:
+
+	struct Block
+	{
+
+		std::unique_ptr<char[]>	data;
+		size_t					size;
+
+	};
+
+			void				addBlock(const size_t index, const size_t size);
+			void				consolidate();
+
+			std::vector<Block>	blocks;
+			size_t				blockSize;
+			size_t				blockIndex;
+			size_t				offset;
+
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+//
+// File: SlabPool.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "SlabPool.h"
+#include "BoneGeometryAllocations.h"
+
+
+SlabPool::SlabPool(const size_t slotSize, const size_t slotsPerSlab) : freeList(nullptr), slotsPerSlab(slotsPerSlab > 0 ? slotsPerSlab : 1), numLive(0)
+/**
+Constructor.
+Slots are rounded up so every slot keeps the alignment of the slab, no memory is reserved until the first allocation.
+
+@param slotSize: The size of each slot in bytes.
+@param slotsPerSlab: The number of slots allocated at once whenever the pool runs out.
+*/
+{
+
+	const size_t alignment = alignof(std::max_align_t);
+	size_t size = (slotSize > sizeof(Slot)) ? slotSize : sizeof(Slot);
+
+	this->slotBytes = ((size + alignment - 1) / alignment) * alignment;
+
+};
+
+
+SlabPool::~SlabPool()
+/**
+Destructor.
+Every slab is released, any slot still in use becomes invalid.
+*/
+{
+};
+
+
+void* SlabPool::allocate()
+/**
+Returns an uninitialized slot, a new slab is only allocated once every existing slot is in use.
+
+@return: void*
+*/
+{
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	if (this->freeList == nullptr)
+	{
+
+		this->addSlab();
+
+	}
+
+	Slot* slot = this->freeList;
+	this->freeList = slot->next;
+	this->numLive++;
+
+	return slot;
+
+};
+
+
+void SlabPool::deallocate(void* pointer)
+/**
+Returns the supplied slot to the pool.
+
+@param pointer: A slot returned by allocate(), null is ignored.
+@return: Void.
+*/
+{
+
+	if (pointer == nullptr)
+	{
+
+		return;
+
+	}
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	Slot* slot = static_cast<Slot*>(pointer);
+	slot->next = this->freeList;
+
+	this->freeList = slot;
+	this->numLive--;
+
+};
+
+
+size_t SlabPool::slotSize() const
+/**
+Returns the size of each slot in bytes, including alignment padding.
+
+@return: size_t
+*/
+{
+
+	return this->slotBytes;
+
+};
+
+
+size_t SlabPool::capacity() const
+/**
+Returns the number of slots held by the pool's slabs.
+
+@return: size_t
+*/
+{
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->slabs.size() * this->slotsPerSlab;
+
+};
+
+
+size_t SlabPool::size() const
+/**
+Returns the number of slots currently in use.
+
+@return: size_t
+*/
+{
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->numLive;
+
+};
+
+
+void SlabPool::addSlab()
+/**
+Allocates a new slab and threads its slots onto the free list in address order.
+The caller must hold the mutex.
+
+@return: Void.
+*/
+{
+
+	size_t slabSize = this->slotBytes * this->slotsPerSlab;
+
+	this->slabs.emplace_back(new char[slabSize]);
+	char* slab = this->slabs.back().get();
+
+	for (size_t i = this->slotsPerSlab; i > 0; i--)
+	{
+
+		Slot* slot = reinterpret_cast<Slot*>(slab + ((i - 1) * this->slotBytes));
+		slot->next = this->freeList;
+
+		this->freeList = slot;
+
+	}
+
+	BoneGeometryAllocations::record(BoneGeometryAllocations::kUserData, slabSize);
+
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef _SLAB_POOL
+#define _SLAB_POOL
+//
+// File: SlabPool.h
+//
+// Maya-free pool of fixed-size slots carved out of large slabs.
+// Freed slots are threaded onto a free list and handed out again before any new slab is allocated, slabs are only released with the pool.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+class SlabPool
+{
+
+public:
+
+								SlabPool(const size_t slotSize, const size_t slotsPerSlab = 256);
+								SlabPool(const SlabPool&) = delete;
+	virtual						~SlabPool();
+
+			SlabPool&			operator=(const SlabPool&) = delete;
+
+			void*				allocate();
+			void				deallocate(void* pointer);
+
+			size_t				slotSize() const;
+			size_t				capacity() const;
+			size_t				size() const;
+
+protected:
+
+	struct Slot
+	{
+
+		Slot*	next;
+
+	};
+
+			void				addSlab();
+
+	mutable	std::mutex							mutex;
+			std::vector<std::unique_ptr<char[]>>	slabs;
+			Slot*								freeList;
+
+			size_t								slotBytes;
+			size_t								slotsPerSlab;
+			size_t								numLive;
+
+};
+#endif
\ No newline at end of file
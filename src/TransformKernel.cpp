@@ -0,0 +1,990 @@
+//
+// File: TransformKernel.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "TransformKernel.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TRANSFORM_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TRANSFORM_KERNEL_AVX2
+#else
+#define TRANSFORM_KERNEL_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+
+namespace
+{
+
+	typedef void (*PackedKernel)(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints);
+	typedef void (*PlanarKernel)(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints);
+	typedef void (*ComposeKernel)(const TransformKernel::TransformArrays& transforms, const size_t first, const size_t numMatrices, double (*matrices)[4][4], double (*inverseMatrices)[4][4]);
+	typedef void (*MultiplyKernel)(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4]);
+
+	void transformPackedScalar(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints)
+	/**
+	Scalar fallback for packed points, this performs a full homogeneous multiplication equivalent to MPoint * MMatrix within rounding.
+
+	@param matrix: Transform matrix.
+	@param source: The points to transform.
+	@param destination: The points to write to, this may be the source.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		double x, y, z, w;
+
+		for (size_t i = 0; i < numPoints; i++)
+		{
+
+			x = source[i][0];
+			y = source[i][1];
+			z = source[i][2];
+			w = source[i][3];
+
+			destination[i][0] = (x * matrix[0][0]) + (y * matrix[1][0]) + (z * matrix[2][0]) + (w * matrix[3][0]);
+			destination[i][1] = (x * matrix[0][1]) + (y * matrix[1][1]) + (z * matrix[2][1]) + (w * matrix[3][1]);
+			destination[i][2] = (x * matrix[0][2]) + (y * matrix[1][2]) + (z * matrix[2][2]) + (w * matrix[3][2]);
+			destination[i][3] = (x * matrix[0][3]) + (y * matrix[1][3]) + (z * matrix[2][3]) + (w * matrix[3][3]);
+
+		}
+
+	};
+
+
+	void transformPlanarScalar(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints)
+	/**
+	Scalar fallback for planar points, w is assumed to be one.
+
+	@param matrix: Transform matrix.
+	@param x: The x components to transform in place.
+	@param y: The y components to transform in place.
+	@param z: The z components to transform in place.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		double px, py, pz;
+
+		for (size_t i = 0; i < numPoints; i++)
+		{
+
+			px = x[i];
+			py = y[i];
+			pz = z[i];
+
+			x[i] = (px * matrix[0][0]) + (py * matrix[1][0]) + (pz * matrix[2][0]) + matrix[3][0];
+			y[i] = (px * matrix[0][1]) + (py * matrix[1][1]) + (pz * matrix[2][1]) + matrix[3][1];
+			z[i] = (px * matrix[0][2]) + (py * matrix[1][2]) + (pz * matrix[2][2]) + matrix[3][2];
+
+		}
+
+	};
+
+
+	void composeScalar(const TransformKernel::TransformArrays& transforms, const size_t first, const size_t numMatrices, double (*matrices)[4][4], double (*inverseMatrices)[4][4])
+	/**
+	Scalar fallback for composing scale, xyz rotation and translation into a matrix and its inverse, equivalent to S * R * T as built by Drawable within rounding.
+	The inverse is built analytically as T^-1 * R^T * S^-1 so every scale must be non-zero.
+
+	@param transforms: The structure-of-arrays transform values.
+	@param first: The index of the first transform.
+	@param numMatrices: The number of transforms to compose.
+	@param matrices: The matrices to write to.
+	@param inverseMatrices: The inverse matrices to write to.
+	@return: Void.
+	*/
+	{
+
+		for (size_t i = first; i < (first + numMatrices); i++)
+		{
+
+			double cosX = std::cos(transforms.rotate[0][i]), sinX = std::sin(transforms.rotate[0][i]);
+			double cosY = std::cos(transforms.rotate[1][i]), sinY = std::sin(transforms.rotate[1][i]);
+			double cosZ = std::cos(transforms.rotate[2][i]), sinZ = std::sin(transforms.rotate[2][i]);
+
+			const double rotation[3][3] =
+			{
+				{ cosY * cosZ, cosY * sinZ, -sinY },
+				{ (sinX * sinY * cosZ) - (cosX * sinZ), (sinX * sinY * sinZ) + (cosX * cosZ), sinX * cosY },
+				{ (cosX * sinY * cosZ) + (sinX * sinZ), (cosX * sinY * sinZ) - (sinX * cosZ), cosX * cosY }
+			};
+
+			const double translate[3] = { transforms.translate[0][i], transforms.translate[1][i], transforms.translate[2][i] };
+			const double scale[3] = { transforms.scale[0][i], transforms.scale[1][i], transforms.scale[2][i] };
+
+			double (*matrix)[4] = matrices[i];
+			double (*inverseMatrix)[4] = inverseMatrices[i];
+
+			for (int row = 0; row < 3; row++)
+			{
+
+				for (int column = 0; column < 3; column++)
+				{
+
+					matrix[row][column] = scale[row] * rotation[row][column];
+					inverseMatrix[row][column] = rotation[column][row] / scale[column];
+
+				}
+
+				matrix[row][3] = 0.0;
+				inverseMatrix[row][3] = 0.0;
+
+			}
+
+			for (int column = 0; column < 3; column++)
+			{
+
+				matrix[3][column] = translate[column];
+				inverseMatrix[3][column] = -((translate[0] * inverseMatrix[0][column]) + (translate[1] * inverseMatrix[1][column]) + (translate[2] * inverseMatrix[2][column]));
+
+			}
+
+			matrix[3][3] = 1.0;
+			inverseMatrix[3][3] = 1.0;
+
+		}
+
+	};
+
+
+	void multiplyScalar(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4])
+	/**
+	Scalar fallback for multiplying pairs of matrices, equivalent to MMatrix * MMatrix within rounding.
+
+	@param left: The left-hand matrices.
+	@param right: The right-hand matrices.
+	@param numMatrices: The number of pairs.
+	@param destination: The matrices to write to, this may be either input.
+	@return: Void.
+	*/
+	{
+
+		double product[4][4];
+
+		for (size_t i = 0; i < numMatrices; i++)
+		{
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				for (int column = 0; column < 4; column++)
+				{
+
+					product[row][column] = (left[i][row][0] * right[i][0][column]) + (left[i][row][1] * right[i][1][column]) + (left[i][row][2] * right[i][2][column]) + (left[i][row][3] * right[i][3][column]);
+
+				}
+
+			}
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				for (int column = 0; column < 4; column++)
+				{
+
+					destination[i][row][column] = product[row][column];
+
+				}
+
+			}
+
+		}
+
+	};
+
+#ifdef TRANSFORM_KERNEL_X86
+
+	void transformPackedSSE2(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints)
+	/**
+	SSE2 kernel for packed points, each point is processed as two lanes of xy and zw.
+
+	@param matrix: Transform matrix.
+	@param source: The points to transform.
+	@param destination: The points to write to, this may be the source.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		const __m128d r0xy = _mm_loadu_pd(&matrix[0][0]), r0zw = _mm_loadu_pd(&matrix[0][2]);
+		const __m128d r1xy = _mm_loadu_pd(&matrix[1][0]), r1zw = _mm_loadu_pd(&matrix[1][2]);
+		const __m128d r2xy = _mm_loadu_pd(&matrix[2][0]), r2zw = _mm_loadu_pd(&matrix[2][2]);
+		const __m128d r3xy = _mm_loadu_pd(&matrix[3][0]), r3zw = _mm_loadu_pd(&matrix[3][2]);
+
+		__m128d x, y, z, w, xy, zw;
+
+		for (size_t i = 0; i < numPoints; i++)
+		{
+
+			x = _mm_load1_pd(&source[i][0]);
+			y = _mm_load1_pd(&source[i][1]);
+			z = _mm_load1_pd(&source[i][2]);
+			w = _mm_load1_pd(&source[i][3]);
+
+			xy = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, r0xy), _mm_mul_pd(y, r1xy)), _mm_add_pd(_mm_mul_pd(z, r2xy), _mm_mul_pd(w, r3xy)));
+			zw = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, r0zw), _mm_mul_pd(y, r1zw)), _mm_add_pd(_mm_mul_pd(z, r2zw), _mm_mul_pd(w, r3zw)));
+
+			_mm_storeu_pd(&destination[i][0], xy);
+			_mm_storeu_pd(&destination[i][2], zw);
+
+		}
+
+	};
+
+
+	void transformPlanarSSE2(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints)
+	/**
+	SSE2 kernel for planar points, two points are processed per iteration.
+
+	@param matrix: Transform matrix.
+	@param x: The x components to transform in place.
+	@param y: The y components to transform in place.
+	@param z: The z components to transform in place.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		const __m128d m00 = _mm_set1_pd(matrix[0][0]), m01 = _mm_set1_pd(matrix[0][1]), m02 = _mm_set1_pd(matrix[0][2]);
+		const __m128d m10 = _mm_set1_pd(matrix[1][0]), m11 = _mm_set1_pd(matrix[1][1]), m12 = _mm_set1_pd(matrix[1][2]);
+		const __m128d m20 = _mm_set1_pd(matrix[2][0]), m21 = _mm_set1_pd(matrix[2][1]), m22 = _mm_set1_pd(matrix[2][2]);
+		const __m128d m30 = _mm_set1_pd(matrix[3][0]), m31 = _mm_set1_pd(matrix[3][1]), m32 = _mm_set1_pd(matrix[3][2]);
+
+		size_t i = 0;
+		__m128d px, py, pz;
+
+		for (; (i + 2) <= numPoints; i += 2)
+		{
+
+			px = _mm_loadu_pd(x + i);
+			py = _mm_loadu_pd(y + i);
+			pz = _mm_loadu_pd(z + i);
+
+			_mm_storeu_pd(x + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, m00), _mm_mul_pd(py, m10)), _mm_add_pd(_mm_mul_pd(pz, m20), m30)));
+			_mm_storeu_pd(y + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, m01), _mm_mul_pd(py, m11)), _mm_add_pd(_mm_mul_pd(pz, m21), m31)));
+			_mm_storeu_pd(z + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, m02), _mm_mul_pd(py, m12)), _mm_add_pd(_mm_mul_pd(pz, m22), m32)));
+
+		}
+
+		transformPlanarScalar(matrix, x + i, y + i, z + i, numPoints - i);
+
+	};
+
+
+	void multiplySSE2(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4])
+	/**
+	SSE2 kernel for multiplying pairs of matrices, each row is processed as two lanes of xy and zw.
+
+	@param left: The left-hand matrices.
+	@param right: The right-hand matrices.
+	@param numMatrices: The number of pairs.
+	@param destination: The matrices to write to, this may be either input.
+	@return: Void.
+	*/
+	{
+
+		__m128d xy[4], zw[4];
+
+		for (size_t i = 0; i < numMatrices; i++)
+		{
+
+			const __m128d r0xy = _mm_loadu_pd(&right[i][0][0]), r0zw = _mm_loadu_pd(&right[i][0][2]);
+			const __m128d r1xy = _mm_loadu_pd(&right[i][1][0]), r1zw = _mm_loadu_pd(&right[i][1][2]);
+			const __m128d r2xy = _mm_loadu_pd(&right[i][2][0]), r2zw = _mm_loadu_pd(&right[i][2][2]);
+			const __m128d r3xy = _mm_loadu_pd(&right[i][3][0]), r3zw = _mm_loadu_pd(&right[i][3][2]);
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				const __m128d x = _mm_load1_pd(&left[i][row][0]), y = _mm_load1_pd(&left[i][row][1]);
+				const __m128d z = _mm_load1_pd(&left[i][row][2]), w = _mm_load1_pd(&left[i][row][3]);
+
+				xy[row] = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, r0xy), _mm_mul_pd(y, r1xy)), _mm_add_pd(_mm_mul_pd(z, r2xy), _mm_mul_pd(w, r3xy)));
+				zw[row] = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, r0zw), _mm_mul_pd(y, r1zw)), _mm_add_pd(_mm_mul_pd(z, r2zw), _mm_mul_pd(w, r3zw)));
+
+			}
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				_mm_storeu_pd(&destination[i][row][0], xy[row]);
+				_mm_storeu_pd(&destination[i][row][2], zw[row]);
+
+			}
+
+		}
+
+	};
+
+
+	TRANSFORM_KERNEL_AVX2 void transformPackedAVX2(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints)
+	/**
+	AVX2 kernel for packed points, each point occupies a single register.
+
+	@param matrix: Transform matrix.
+	@param source: The points to transform.
+	@param destination: The points to write to, this may be the source.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		const __m256d r0 = _mm256_loadu_pd(matrix[0]);
+		const __m256d r1 = _mm256_loadu_pd(matrix[1]);
+		const __m256d r2 = _mm256_loadu_pd(matrix[2]);
+		const __m256d r3 = _mm256_loadu_pd(matrix[3]);
+
+		__m256d point;
+
+		for (size_t i = 0; i < numPoints; i++)
+		{
+
+			point = _mm256_mul_pd(_mm256_broadcast_sd(&source[i][0]), r0);
+			point = _mm256_fmadd_pd(_mm256_broadcast_sd(&source[i][1]), r1, point);
+			point = _mm256_fmadd_pd(_mm256_broadcast_sd(&source[i][2]), r2, point);
+			point = _mm256_fmadd_pd(_mm256_broadcast_sd(&source[i][3]), r3, point);
+
+			_mm256_storeu_pd(destination[i], point);
+
+		}
+
+	};
+
+
+	TRANSFORM_KERNEL_AVX2 void transformPlanarAVX2(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints)
+	/**
+	AVX2 kernel for planar points, four points are processed per iteration.
+
+	@param matrix: Transform matrix.
+	@param x: The x components to transform in place.
+	@param y: The y components to transform in place.
+	@param z: The z components to transform in place.
+	@param numPoints: The number of points.
+	@return: Void.
+	*/
+	{
+
+		const __m256d m00 = _mm256_set1_pd(matrix[0][0]), m01 = _mm256_set1_pd(matrix[0][1]), m02 = _mm256_set1_pd(matrix[0][2]);
+		const __m256d m10 = _mm256_set1_pd(matrix[1][0]), m11 = _mm256_set1_pd(matrix[1][1]), m12 = _mm256_set1_pd(matrix[1][2]);
+		const __m256d m20 = _mm256_set1_pd(matrix[2][0]), m21 = _mm256_set1_pd(matrix[2][1]), m22 = _mm256_set1_pd(matrix[2][2]);
+		const __m256d m30 = _mm256_set1_pd(matrix[3][0]), m31 = _mm256_set1_pd(matrix[3][1]), m32 = _mm256_set1_pd(matrix[3][2]);
+
+		size_t i = 0;
+		__m256d px, py, pz;
+
+		for (; (i + 4) <= numPoints; i += 4)
+		{
+
+			px = _mm256_loadu_pd(x + i);
+			py = _mm256_loadu_pd(y + i);
+			pz = _mm256_loadu_pd(z + i);
+
+			_mm256_storeu_pd(x + i, _mm256_fmadd_pd(px, m00, _mm256_fmadd_pd(py, m10, _mm256_fmadd_pd(pz, m20, m30))));
+			_mm256_storeu_pd(y + i, _mm256_fmadd_pd(px, m01, _mm256_fmadd_pd(py, m11, _mm256_fmadd_pd(pz, m21, m31))));
+			_mm256_storeu_pd(z + i, _mm256_fmadd_pd(px, m02, _mm256_fmadd_pd(py, m12, _mm256_fmadd_pd(pz, m22, m32))));
+
+		}
+
+		transformPlanarScalar(matrix, x + i, y + i, z + i, numPoints - i);
+
+	};
+
+
+	TRANSFORM_KERNEL_AVX2 void composeAVX2(const TransformKernel::TransformArrays& transforms, const size_t first, const size_t numMatrices, double (*matrices)[4][4], double (*inverseMatrices)[4][4])
+	/**
+	AVX2 kernel for composing matrices, four transforms are processed per iteration with one transform in each lane.
+	Sines and cosines are evaluated per lane, everything after that is vectorised and the lanes are scattered back into the matrices at the end.
+
+	@param transforms: The structure-of-arrays transform values.
+	@param first: The index of the first transform.
+	@param numMatrices: The number of transforms to compose.
+	@param matrices: The matrices to write to.
+	@param inverseMatrices: The inverse matrices to write to.
+	@return: Void.
+	*/
+	{
+
+		alignas(32) double cosines[3][4], sines[3][4];
+		alignas(32) double elements[2][16][4];
+
+		const __m256d zero = _mm256_setzero_pd();
+		const __m256d one = _mm256_set1_pd(1.0);
+
+		size_t i = first, last = first + numMatrices;
+
+		for (; (i + 4) <= last; i += 4)
+		{
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+
+				for (int lane = 0; lane < 4; lane++)
+				{
+
+					cosines[axis][lane] = std::cos(transforms.rotate[axis][i + lane]);
+					sines[axis][lane] = std::sin(transforms.rotate[axis][i + lane]);
+
+				}
+
+			}
+
+			const __m256d cosX = _mm256_load_pd(cosines[0]), sinX = _mm256_load_pd(sines[0]);
+			const __m256d cosY = _mm256_load_pd(cosines[1]), sinY = _mm256_load_pd(sines[1]);
+			const __m256d cosZ = _mm256_load_pd(cosines[2]), sinZ = _mm256_load_pd(sines[2]);
+
+			const __m256d sinXsinY = _mm256_mul_pd(sinX, sinY);
+			const __m256d cosXsinY = _mm256_mul_pd(cosX, sinY);
+
+			const __m256d rotation[3][3] =
+			{
+				{ _mm256_mul_pd(cosY, cosZ), _mm256_mul_pd(cosY, sinZ), _mm256_sub_pd(zero, sinY) },
+				{ _mm256_fmsub_pd(sinXsinY, cosZ, _mm256_mul_pd(cosX, sinZ)), _mm256_fmadd_pd(sinXsinY, sinZ, _mm256_mul_pd(cosX, cosZ)), _mm256_mul_pd(sinX, cosY) },
+				{ _mm256_fmadd_pd(cosXsinY, cosZ, _mm256_mul_pd(sinX, sinZ)), _mm256_fmsub_pd(cosXsinY, sinZ, _mm256_mul_pd(sinX, cosZ)), _mm256_mul_pd(cosX, cosY) }
+			};
+
+			const __m256d translate[3] = { _mm256_loadu_pd(transforms.translate[0] + i), _mm256_loadu_pd(transforms.translate[1] + i), _mm256_loadu_pd(transforms.translate[2] + i) };
+			const __m256d scale[3] = { _mm256_loadu_pd(transforms.scale[0] + i), _mm256_loadu_pd(transforms.scale[1] + i), _mm256_loadu_pd(transforms.scale[2] + i) };
+			const __m256d inverseScale[3] = { _mm256_div_pd(one, scale[0]), _mm256_div_pd(one, scale[1]), _mm256_div_pd(one, scale[2]) };
+
+			// Build every element of both matrices across the four lanes
+			//
+			for (int row = 0; row < 3; row++)
+			{
+
+				for (int column = 0; column < 3; column++)
+				{
+
+					_mm256_store_pd(elements[0][(row * 4) + column], _mm256_mul_pd(scale[row], rotation[row][column]));
+					_mm256_store_pd(elements[1][(row * 4) + column], _mm256_mul_pd(rotation[column][row], inverseScale[column]));
+
+				}
+
+				_mm256_store_pd(elements[0][(row * 4) + 3], zero);
+				_mm256_store_pd(elements[1][(row * 4) + 3], zero);
+
+			}
+
+			for (int column = 0; column < 3; column++)
+			{
+
+				__m256d inverseTranslate = _mm256_mul_pd(translate[0], _mm256_load_pd(elements[1][column]));
+				inverseTranslate = _mm256_fmadd_pd(translate[1], _mm256_load_pd(elements[1][4 + column]), inverseTranslate);
+				inverseTranslate = _mm256_fmadd_pd(translate[2], _mm256_load_pd(elements[1][8 + column]), inverseTranslate);
+
+				_mm256_store_pd(elements[0][12 + column], translate[column]);
+				_mm256_store_pd(elements[1][12 + column], _mm256_sub_pd(zero, inverseTranslate));
+
+			}
+
+			_mm256_store_pd(elements[0][15], one);
+			_mm256_store_pd(elements[1][15], one);
+
+			// Scatter lanes back into the matrices
+			//
+			for (int lane = 0; lane < 4; lane++)
+			{
+
+				double* matrix = &matrices[i + lane][0][0];
+				double* inverseMatrix = &inverseMatrices[i + lane][0][0];
+
+				for (int element = 0; element < 16; element++)
+				{
+
+					matrix[element] = elements[0][element][lane];
+					inverseMatrix[element] = elements[1][element][lane];
+
+				}
+
+			}
+
+		}
+
+		composeScalar(transforms, i, last - i, matrices, inverseMatrices);
+
+	};
+
+
+	TRANSFORM_KERNEL_AVX2 void multiplyAVX2(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4])
+	/**
+	AVX2 kernel for multiplying pairs of matrices, each row occupies a single register.
+
+	@param left: The left-hand matrices.
+	@param right: The right-hand matrices.
+	@param numMatrices: The number of pairs.
+	@param destination: The matrices to write to, this may be either input.
+	@return: Void.
+	*/
+	{
+
+		__m256d product[4];
+
+		for (size_t i = 0; i < numMatrices; i++)
+		{
+
+			const __m256d r0 = _mm256_loadu_pd(right[i][0]);
+			const __m256d r1 = _mm256_loadu_pd(right[i][1]);
+			const __m256d r2 = _mm256_loadu_pd(right[i][2]);
+			const __m256d r3 = _mm256_loadu_pd(right[i][3]);
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				product[row] = _mm256_mul_pd(_mm256_broadcast_sd(&left[i][row][0]), r0);
+				product[row] = _mm256_fmadd_pd(_mm256_broadcast_sd(&left[i][row][1]), r1, product[row]);
+				product[row] = _mm256_fmadd_pd(_mm256_broadcast_sd(&left[i][row][2]), r2, product[row]);
+				product[row] = _mm256_fmadd_pd(_mm256_broadcast_sd(&left[i][row][3]), r3, product[row]);
+
+			}
+
+			for (int row = 0; row < 4; row++)
+			{
+
+				_mm256_storeu_pd(destination[i][row], product[row]);
+
+			}
+
+		}
+
+	};
+
+
+	bool supportsAVX2()
+	/**
+	Evaluates whether the host processor and operating system support AVX2 and FMA.
+
+	@return: bool
+	*/
+	{
+
+#if defined(_MSC_VER)
+
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+		{
+
+			return false;
+
+		}
+
+		__cpuid(info, 1);
+
+		bool hasFMA = (info[2] & (1 << 12)) != 0;
+		bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+
+		if (!hasFMA || !hasOSXSave || (_xgetbv(0) & 0x6) != 0x6)
+		{
+
+			return false;
+
+		}
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+
+#else
+
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+#endif
+
+	};
+
+#endif
+
+	TransformKernel::InstructionSet detectInstructionSet()
+	/**
+	Returns the best instruction set supported by the host.
+
+	@return: InstructionSet
+	*/
+	{
+
+#ifdef TRANSFORM_KERNEL_X86
+
+		return supportsAVX2() ? TransformKernel::InstructionSet::kAVX2 : TransformKernel::InstructionSet::kSSE2;
+
+#else
+
+		return TransformKernel::InstructionSet::kScalar;
+
+#endif
+
+	};
+
+
+	std::atomic<TransformKernel::InstructionSet>& currentInstructionSet()
+	/**
+	Returns the instruction set used for dispatching, this is detected on first use.
+
+	@return: The current instruction set.
+	*/
+	{
+
+		static std::atomic<TransformKernel::InstructionSet> instructionSet(TransformKernel::supportedInstructionSet());
+		return instructionSet;
+
+	};
+
+
+	PackedKernel packedKernel()
+	/**
+	Returns the packed kernel for the current instruction set.
+
+	@return: PackedKernel
+	*/
+	{
+
+		switch (currentInstructionSet().load(std::memory_order_relaxed))
+		{
+
+#ifdef TRANSFORM_KERNEL_X86
+
+			case TransformKernel::InstructionSet::kAVX2:
+				return transformPackedAVX2;
+
+			case TransformKernel::InstructionSet::kSSE2:
+				return transformPackedSSE2;
+
+#endif
+
+			default:
+				return transformPackedScalar;
+
+		}
+
+	};
+
+
+	PlanarKernel planarKernel()
+	/**
+	Returns the planar kernel for the current instruction set.
+
+	@return: PlanarKernel
+	*/
+	{
+
+		switch (currentInstructionSet().load(std::memory_order_relaxed))
+		{
+
+#ifdef TRANSFORM_KERNEL_X86
+
+			case TransformKernel::InstructionSet::kAVX2:
+				return transformPlanarAVX2;
+
+			case TransformKernel::InstructionSet::kSSE2:
+				return transformPlanarSSE2;
+
+#endif
+
+			default:
+				return transformPlanarScalar;
+
+		}
+
+	};
+
+
+	ComposeKernel composeKernel()
+	/**
+	Returns the compose kernel for the current instruction set, SSE2 uses the scalar kernel as two lanes do not cover the cost of scattering.
+
+	@return: ComposeKernel
+	*/
+	{
+
+		switch (currentInstructionSet().load(std::memory_order_relaxed))
+		{
+
+#ifdef TRANSFORM_KERNEL_X86
+
+			case TransformKernel::InstructionSet::kAVX2:
+				return composeAVX2;
+
+#endif
+
+			default:
+				return composeScalar;
+
+		}
+
+	};
+
+
+	MultiplyKernel multiplyKernel()
+	/**
+	Returns the multiply kernel for the current instruction set.
+
+	@return: MultiplyKernel
+	*/
+	{
+
+		switch (currentInstructionSet().load(std::memory_order_relaxed))
+		{
+
+#ifdef TRANSFORM_KERNEL_X86
+
+			case TransformKernel::InstructionSet::kAVX2:
+				return multiplyAVX2;
+
+			case TransformKernel::InstructionSet::kSSE2:
+				return multiplySSE2;
+
+#endif
+
+			default:
+				return multiplyScalar;
+
+		}
+
+	};
+
+};
+
+
+TransformKernel::InstructionSet TransformKernel::instructionSet()
+/**
+Returns the instruction set currently used by the transform functions.
+
+@return: InstructionSet
+*/
+{
+
+	return currentInstructionSet().load(std::memory_order_relaxed);
+
+};
+
+
+TransformKernel::InstructionSet TransformKernel::supportedInstructionSet()
+/**
+Returns the best instruction set supported by the host.
+The result is cached after the first query.
+
+@return: InstructionSet
+*/
+{
+
+	static const InstructionSet instructionSet = detectInstructionSet();
+	return instructionSet;
+
+};
+
+
+void TransformKernel::setInstructionSet(const InstructionSet instructionSet)
+/**
+Overrides the instruction set used by the transform functions.
+Requests for an unsupported instruction set are clamped to the best supported one, this is mostly useful for benchmarking.
+
+@param instructionSet: The instruction set to use.
+@return: Void.
+*/
+{
+
+	InstructionSet supported = TransformKernel::supportedInstructionSet();
+	currentInstructionSet().store((instructionSet > supported) ? supported : instructionSet, std::memory_order_relaxed);
+
+};
+
+
+const char* TransformKernel::instructionSetName(const InstructionSet instructionSet)
+/**
+Returns the display name for the supplied instruction set.
+
+@param instructionSet: The instruction set.
+@return: The display name.
+*/
+{
+
+	switch (instructionSet)
+	{
+
+		case InstructionSet::kAVX2:
+			return "avx2";
+
+		case InstructionSet::kSSE2:
+			return "sse2";
+
+		default:
+			return "scalar";
+
+	}
+
+};
+
+
+void TransformKernel::transform(const double matrix[4][4], double (*points)[4], const size_t numPoints)
+/**
+Transforms an array of packed homogeneous points in place.
+The result is equivalent to MPoint * MMatrix within rounding, including the w component.
+
+@param matrix: Transform matrix.
+@param points: The points to transform in place.
+@param numPoints: The number of points.
+@return: Void.
+*/
+{
+
+	packedKernel()(matrix, points, points, numPoints);
+
+};
+
+
+void TransformKernel::transform(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints)
+/**
+Transforms an array of packed homogeneous points into a separate array.
+
+@param matrix: Transform matrix.
+@param source: The points to transform.
+@param destination: The points to write to, this must be at least as long as the source.
+@param numPoints: The number of points.
+@return: Void.
+*/
+{
+
+	packedKernel()(matrix, source, destination, numPoints);
+
+};
+
+
+void TransformKernel::transform(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints)
+/**
+Transforms a structure-of-arrays set of points in place.
+Since there is no w component the matrix is treated as an affine transform.
+
+@param matrix: Transform matrix.
+@param x: The x components.
+@param y: The y components.
+@param z: The z components.
+@param numPoints: The number of points.
+@return: Void.
+*/
+{
+
+	planarKernel()(matrix, x, y, z, numPoints);
+
+};
+
+
+void TransformKernel::transformBatch(const double (*matrices)[4][4], const size_t* offsets, const size_t numMatrices, double (*points)[4])
+/**
+Transforms many point ranges with many matrices in place.
+The points belonging to matrix i are found in the range [offsets[i], offsets[i + 1]), so the offsets array must be numMatrices + 1 long.
+
+@param matrices: The transform matrices.
+@param offsets: The start offset for each matrix followed by the total number of points.
+@param numMatrices: The number of matrices.
+@param points: The points to transform in place.
+@return: Void.
+*/
+{
+
+	TransformKernel::transformBatch(matrices, offsets, numMatrices, points, points);
+
+};
+
+
+void TransformKernel::transformBatch(const double (*matrices)[4][4], const size_t* offsets, const size_t numMatrices, const double (*source)[4], double (*destination)[4])
+/**
+Transforms many point ranges with many matrices into a separate array.
+The points belonging to matrix i are found in the range [offsets[i], offsets[i + 1]), so the offsets array must be numMatrices + 1 long.
+
+@param matrices: The transform matrices.
+@param offsets: The start offset for each matrix followed by the total number of points.
+@param numMatrices: The number of matrices.
+@param source: The points to transform.
+@param destination: The points to write to.
+@return: Void.
+*/
+{
+
+	PackedKernel kernel = packedKernel();
+
+	for (size_t i = 0; i < numMatrices; i++)
+	{
+
+		kernel(matrices[i], source + offsets[i], destination + offsets[i], offsets[i + 1] - offsets[i]);
+
+	}
+
+};
+
+
+void TransformKernel::transformBatch(const double (*matrices)[4][4], double (* const* points)[4], const size_t* numPoints, const size_t numMatrices)
+/**
+Transforms many separately allocated point arrays with many matrices in place.
+The points belonging to matrix i start at points[i] and hold numPoints[i] elements, empty arrays may pass a null pointer.
+
+@param matrices: The transform matrices.
+@param points: The start of each point array.
+@param numPoints: The number of points in each array.
+@param numMatrices: The number of matrices.
+@return: Void.
+*/
+{
+
+	PackedKernel kernel = packedKernel();
+
+	for (size_t i = 0; i < numMatrices; i++)
+	{
+
+		if (numPoints[i] == 0)
+		{
+
+			continue;
+
+		}
+
+		kernel(matrices[i], points[i], points[i], numPoints[i]);
+
+	}
+
+};
+
+
+void TransformKernel::composeBatch(const TransformArrays& transforms, const size_t numMatrices, double (*matrices)[4][4], double (*inverseMatrices)[4][4])
+/**
+Composes scale, xyz rotation in radians and translation into matrices and their inverses.
+The result is equivalent to Drawable::createScaleMatrix() * Drawable::createRotationMatrix() * Drawable::createPositionMatrix() within rounding.
+The inverses are built analytically, so callers must ensure every scale is non-zero.
+
+@param transforms: The structure-of-arrays transform values, each array must be numMatrices long.
+@param numMatrices: The number of transforms.
+@param matrices: The matrices to write to.
+@param inverseMatrices: The inverse matrices to write to.
+@return: Void.
+*/
+{
+
+	composeKernel()(transforms, 0, numMatrices, matrices, inverseMatrices);
+
+};
+
+
+void TransformKernel::multiplyBatch(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4])
+/**
+Multiplies pairs of matrices, destination[i] = left[i] * right[i].
+
+@param left: The left-hand matrices.
+@param right: The right-hand matrices.
+@param numMatrices: The number of pairs.
+@param destination: The matrices to write to, this may be either input.
+@return: Void.
+*/
+{
+
+	multiplyKernel()(left, right, numMatrices, destination);
+
+};
\ No newline at end of file
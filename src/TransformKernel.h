@@ -0,0 +1,56 @@
+#ifndef _TRANSFORM_KERNEL
+#define _TRANSFORM_KERNEL
+//
+// File: TransformKernel.h
+//
+// Batched point transforms over contiguous buffers.
+// The best instruction set supported by the host (AVX2, SSE2 or scalar) is selected at runtime.
+// The AVX2 paths use fused multiply-add, so results can differ from Maya's own products in the last bit.
+// Matrices use Maya's row-vector convention, where the fourth row holds the translation.
+// Batches of matrices can also be composed from structure-of-arrays transform values and multiplied together.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include <cstddef>
+
+
+namespace TransformKernel
+{
+
+	enum class InstructionSet
+	{
+
+		kScalar = 0,
+		kSSE2 = 1,
+		kAVX2 = 2
+
+	};
+
+	struct TransformArrays
+	{
+
+		const double*	translate[3];
+		const double*	rotate[3];
+		const double*	scale[3];
+
+	};
+
+	InstructionSet	instructionSet();
+	InstructionSet	supportedInstructionSet();
+	void			setInstructionSet(const InstructionSet instructionSet);
+	const char*		instructionSetName(const InstructionSet instructionSet);
+
+	void			transform(const double matrix[4][4], double (*points)[4], const size_t numPoints);
+	void			transform(const double matrix[4][4], const double (*source)[4], double (*destination)[4], const size_t numPoints);
+	void			transform(const double matrix[4][4], double* x, double* y, double* z, const size_t numPoints);
+
+	void			transformBatch(const double (*matrices)[4][4], const size_t* offsets, const size_t numMatrices, double (*points)[4]);
+	void			transformBatch(const double (*matrices)[4][4], const size_t* offsets, const size_t numMatrices, const double (*source)[4], double (*destination)[4]);
+	void			transformBatch(const double (*matrices)[4][4], double (* const* points)[4], const size_t* numPoints, const size_t numMatrices);
+
+	void			composeBatch(const TransformArrays& transforms, const size_t numMatrices, double (*matrices)[4][4], double (*inverseMatrices)[4][4]);
+	void			multiplyBatch(const double (*left)[4][4], const double (*right)[4][4], const size_t numMatrices, double (*destination)[4][4]);
+
+};
+#endif
\ No newline at end of file
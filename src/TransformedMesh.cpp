@@ -0,0 +1,526 @@
+//
+// File: TransformedMesh.cpp
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "TransformedMesh.h"
+
+#include <maya/MFnMesh.h>
+
+
+void SharedMesh::build(const MPointArray& points, const MIntArray& polygonCounts, const MIntArray& polygonConnects)
+/**
+Builds this mesh from the supplied arrays.
+Without edge smoothings every face is drawn flat.
+
+@param points: The vertex positions.
+@param polygonCounts: The number of vertices in each polygon.
+@param polygonConnects: The vertex indices of each polygon.
+@return: Void.
+*/
+{
+
+	this->points = points;
+	this->polygonCounts = polygonCounts;
+	this->polygonConnects = polygonConnects;
+
+	this->buildTopology();
+
+};
+
+
+MStatus SharedMesh::build(const MObject& meshData)
+/**
+Builds this mesh from the supplied mesh data, including its edge smoothing.
+The topology adopts the edge order of the mesh data so the smoothings can be indexed by edge.
+
+@param meshData: The mesh data object to copy from.
+@return: Return status.
+*/
+{
+
+	MStatus status;
+
+	// Copy points and polygons
+	//
+	MFnMesh fnMesh(meshData, &status);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = fnMesh.getPoints(this->points);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = fnMesh.getVertices(this->polygonCounts, this->polygonConnects);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = Drawable::getHalfEdgeMesh(meshData, this->topology);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	status = Drawable::matchEdgeOrder(meshData, this->topology);
+	CHECK_MSTATUS_AND_RETURN_IT(status);
+
+	// Copy edge smoothings
+	//
+	int numEdges = this->topology.numEdges();
+	this->edgeSmoothings.setLength(numEdges);
+
+	for (int i = 0; i < numEdges; i++)
+	{
+
+		this->edgeSmoothings[i] = fnMesh.isEdgeSmooth(i) ? 1 : 0;
+
+	}
+
+	this->update();
+
+	return MS::kSuccess;
+
+};
+
+
+void SharedMesh::buildTopology()
+/**
+Builds the topology from the current points and polygons, edges are numbered in order of first appearance.
+Any edge smoothings are discarded since they may no longer line up with the edges.
+
+@return: Void.
+*/
+{
+
+	int numPolygons = this->polygonCounts.length();
+	this->topology.build(this->points.length(), (numPolygons > 0) ? &this->polygonCounts[0] : nullptr, numPolygons, (this->polygonConnects.length() > 0) ? &this->polygonConnects[0] : nullptr);
+
+	this->edgeSmoothings.clear();
+	this->update();
+
+};
+
+
+void SharedMesh::update()
+/**
+Updates the bounding box and draw buffers from the points, polygons and topology.
+Polygons are fan triangulated and each corner normal is averaged across the faces reached through smooth edges.
+
+@return: Void.
+*/
+{
+
+	// Update bounding box
+	//
+	unsigned int numPoints = this->points.length();
+	this->boundingBox.clear();
+
+	for (unsigned int i = 0; i < numPoints; i++)
+	{
+
+		this->boundingBox.expand(this->points[i]);
+
+	}
+
+	// Calculate face and corner normals
+	//
+	MVectorArray faceNormals;
+	Drawable::getFaceNormals(this->topology, this->points, faceNormals);
+
+	int numHalfEdges = this->topology.numHalfEdges();
+	bool hasSmoothings = static_cast<int>(this->edgeSmoothings.length()) == this->topology.numEdges();
+
+	MVectorArray cornerNormals(numHalfEdges);
+
+	for (int halfEdge = 0; halfEdge < numHalfEdges; halfEdge++)
+	{
+
+		MVector normal = faceNormals[this->topology.face(halfEdge)];
+
+		if (hasSmoothings)
+		{
+
+			// Rotate forwards across smooth outgoing edges
+			// Inconsistently wound neighbours are treated as hard edges
+			//
+			int vertex = this->topology.origin(halfEdge);
+			bool closed = false;
+			int current = halfEdge;
+
+			while (true)
+			{
+
+				int twin = this->topology.twin(current);
+
+				if (twin == -1 || this->edgeSmoothings[this->topology.edge(current)] == 0 || this->topology.destination(twin) != vertex)
+				{
+
+					break;
+
+				}
+
+				current = this->topology.next(twin);
+
+				if (current == halfEdge)
+				{
+
+					closed = true;
+					break;
+
+				}
+
+				normal += faceNormals[this->topology.face(current)];
+
+			}
+
+			// Rotate backwards across smooth incoming edges, an open fan stops at the same hard edge from the other side
+			//
+			current = halfEdge;
+
+			while (!closed)
+			{
+
+				int prev = this->topology.prev(current);
+				int twin = this->topology.twin(prev);
+
+				if (twin == -1 || this->edgeSmoothings[this->topology.edge(prev)] == 0 || this->topology.origin(twin) != vertex)
+				{
+
+					break;
+
+				}
+
+				current = twin;
+				normal += faceNormals[this->topology.face(current)];
+
+			}
+
+		}
+
+		cornerNormals[halfEdge] = normal.normal();
+
+	}
+
+	// Fan triangulate polygons
+	//
+	int numFaces = this->topology.numFaces();
+	int numTriangles = 0;
+
+	for (int i = 0; i < numFaces; i++)
+	{
+
+		numTriangles += (this->topology.faceSize(i) > 2) ? (this->topology.faceSize(i) - 2) : 0;
+
+	}
+
+	this->triangleVertices.setLength(numTriangles * 3);
+	this->triangleNormals.setLength(numTriangles * 3);
+
+	int insertAt = 0;
+
+	for (int i = 0; i < numFaces; i++)
+	{
+
+		int start = this->topology.faceHalfEdge(i);
+		int count = this->topology.faceSize(i);
+
+		for (int j = 1; j < (count - 1); j++)
+		{
+
+			int corners[3] = { start, start + j, start + j + 1 };
+
+			for (int corner : corners)
+			{
+
+				this->triangleVertices[insertAt] = this->topology.origin(corner);
+				this->triangleNormals[insertAt] = cornerNormals[corner];
+
+				insertAt++;
+
+			}
+
+		}
+
+	}
+
+};
+
+
+std::shared_ptr<const SharedMesh> SharedMesh::create(const MPointArray& points, const MIntArray& polygonCounts, const MIntArray& polygonConnects)
+/**
+Returns a new shared mesh built from the supplied arrays.
+
+@param points: The vertex positions.
+@param polygonCounts: The number of vertices in each polygon.
+@param polygonConnects: The vertex indices of each polygon.
+@return: The shared mesh.
+*/
+{
+
+	std::shared_ptr<SharedMesh> mesh = std::make_shared<SharedMesh>();
+	mesh->build(points, polygonCounts, polygonConnects);
+
+	return mesh;
+
+};
+
+
+std::shared_ptr<const SharedMesh> SharedMesh::create(const MObject& meshData, MStatus* status)
+/**
+Returns a new shared mesh built from the supplied mesh data.
+
+@param meshData: The mesh data object to copy from.
+@param status: Return status.
+@return: The shared mesh.
+*/
+{
+
+	std::shared_ptr<SharedMesh> mesh = std::make_shared<SharedMesh>();
+	*status = mesh->build(meshData);
+
+	return mesh;
+
+};
+
+
+TransformedMesh::TransformedMesh() : objectMatrix(MMatrix::identity) {};
+
+
+TransformedMesh::TransformedMesh(const std::shared_ptr<const SharedMesh>& source, const MMatrix& matrix) : sharedMesh(source), objectMatrix(matrix) {};
+
+
+TransformedMesh::~TransformedMesh() {};
+
+
+bool TransformedMesh::isValid() const
+/**
+Evaluates if this view references a source mesh.
+
+@return: bool
+*/
+{
+
+	return this->sharedMesh != nullptr;
+
+};
+
+
+const std::shared_ptr<const SharedMesh>& TransformedMesh::source() const
+/**
+Returns the shared source mesh.
+
+@return: The shared mesh.
+*/
+{
+
+	return this->sharedMesh;
+
+};
+
+
+const MMatrix& TransformedMesh::matrix() const
+/**
+Returns the matrix that places the source mesh.
+
+@return: MMatrix
+*/
+{
+
+	return this->objectMatrix;
+
+};
+
+
+void TransformedMesh::setMatrix(const MMatrix& matrix)
+/**
+Updates the matrix that places the source mesh.
+The source mesh is never modified so other views are unaffected.
+
+@param matrix: The new matrix.
+@return: Void.
+*/
+{
+
+	this->objectMatrix = matrix;
+
+};
+
+
+TransformedMesh TransformedMesh::transformed(const MMatrix& matrix) const
+/**
+Returns a view of the same source mesh with the supplied matrix applied after this view's matrix.
+
+@param matrix: The matrix to apply.
+@return: TransformedMesh
+*/
+{
+
+	return TransformedMesh(this->sharedMesh, this->objectMatrix * matrix);
+
+};
+
+
+unsigned int TransformedMesh::numPoints() const
+/**
+Returns the number of points in the source mesh.
+
+@return: unsigned int
+*/
+{
+
+	return this->isValid() ? this->sharedMesh->points.length() : 0;
+
+};
+
+
+void TransformedMesh::getPoints(MPointArray& points) const
+/**
+Populates the supplied array with the transformed points.
+
+@param points: The passed array to populate.
+@return: Void.
+*/
+{
+
+	if (!this->isValid())
+	{
+
+		points.setLength(0);
+		return;
+
+	}
+
+	Drawable::transform(this->objectMatrix, this->sharedMesh->points, points);
+
+};
+
+
+MBoundingBox TransformedMesh::boundingBox() const
+/**
+Returns the bounding box of the source mesh transformed by this view's matrix.
+The box is exact for scales and translations and may be loose under rotation, no points are transformed.
+
+@return: MBoundingBox
+*/
+{
+
+	if (!this->isValid())
+	{
+
+		return MBoundingBox();
+
+	}
+
+	MBoundingBox boundingBox(this->sharedMesh->boundingBox);
+	boundingBox.transformUsing(this->objectMatrix);
+
+	return boundingBox;
+
+};
+
+
+void TransformedMesh::getLines(MPointArray& lines) const
+/**
+Populates the supplied array with the transformed start and end point of every edge.
+
+@param lines: The passed array to populate.
+@return: Void.
+*/
+{
+
+	if (!this->isValid())
+	{
+
+		lines.setLength(0);
+		return;
+
+	}
+
+	const HalfEdgeMesh& topology = this->sharedMesh->topology;
+	const MPointArray& points = this->sharedMesh->points;
+
+	int numEdges = topology.numEdges();
+	lines.setLength(numEdges * 2);
+
+	for (int i = 0; i < numEdges; i++)
+	{
+
+		lines[i * 2] = points[topology.edgeStart(i)] * this->objectMatrix;
+		lines[(i * 2) + 1] = points[topology.edgeEnd(i)] * this->objectMatrix;
+
+	}
+
+};
+
+
+void TransformedMesh::getTriangles(MPointArray& triangles, MVectorArray& normals) const
+/**
+Populates the supplied arrays with the transformed triangle points and normals.
+Normals are transformed by the inverse transpose so non-uniform scales keep them perpendicular.
+
+@param triangles: The passed point array to populate.
+@param normals: The passed normal array to populate.
+@return: Void.
+*/
+{
+
+	if (!this->isValid())
+	{
+
+		triangles.setLength(0);
+		normals.setLength(0);
+		return;
+
+	}
+
+	const SharedMesh& mesh = *this->sharedMesh;
+	MMatrix normalMatrix = this->objectMatrix.inverse().transpose();
+
+	unsigned int length = mesh.triangleVertices.length();
+
+	triangles.setLength(length);
+	normals.setLength(length);
+
+	for (unsigned int i = 0; i < length; i++)
+	{
+
+		triangles[i] = mesh.points[mesh.triangleVertices[i]] * this->objectMatrix;
+		normals[i] = (mesh.triangleNormals[i] * normalMatrix).normal();
+
+	}
+
+};
+
+
+MObject TransformedMesh::createMeshData(MStatus* status) const
+/**
+Creates a mesh data object for this view.
+This is the only point at which Maya mesh data is built, prefer the other accessors when drawing.
+
+@param status: Return status.
+@return: MObject
+*/
+{
+
+	if (!this->isValid())
+	{
+
+		*status = MS::kFailure;
+		return MObject::kNullObj;
+
+	}
+
+	MPointArray points;
+	this->getPoints(points);
+
+	const SharedMesh& mesh = *this->sharedMesh;
+
+	if (mesh.edgeSmoothings.length() > 0)
+	{
+
+		return Drawable::createMeshData(points, mesh.polygonCounts, mesh.polygonConnects, mesh.edgeSmoothings, status);
+
+	}
+	else
+	{
+
+		return Drawable::createMeshData(points, mesh.polygonCounts, mesh.polygonConnects, status);
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef _TRANSFORMED_MESH
+#define _TRANSFORMED_MESH
+//
+// File: TransformedMesh.h
+//
+// Copy-on-write view of an immutable shared mesh placed by a matrix.
+// Bounds and draw buffers are derived from the shared source, mesh data is only created when Maya requires a real MObject.
+//
+// Author: Benjamin H. Singleton
+//
+
+#include "Drawable.h"
+#include "HalfEdgeMesh.h"
+
+#include <maya/MObject.h>
+#include <maya/MPointArray.h>
+#include <maya/MVectorArray.h>
+#include <maya/MIntArray.h>
+#include <maya/MMatrix.h>
+#include <maya/MBoundingBox.h>
+#include <maya/MStatus.h>
+
+#include <memory>
+
+
+struct SharedMesh
+{
+
+	MPointArray		points;
+	MIntArray		polygonCounts;
+	MIntArray		polygonConnects;
+	MIntArray		edgeSmoothings;
+
+	HalfEdgeMesh	topology;
+	MBoundingBox	boundingBox;
+	MIntArray		triangleVertices;
+	MVectorArray	triangleNormals;
+
+	void			build(const MPointArray& points, const MIntArray& polygonCounts, const MIntArray& polygonConnects);
+	MStatus			build(const MObject& meshData);
+	void			buildTopology();
+	void			update();
+
+	static std::shared_ptr<const SharedMesh>	create(const MPointArray& points, const MIntArray& polygonCounts, const MIntArray& polygonConnects);
+	static std::shared_ptr<const SharedMesh>	create(const MObject& meshData, MStatus* status);
+
+};
+
+
+class TransformedMesh
+{
+
+public:
+
+								TransformedMesh();
+								TransformedMesh(const std::shared_ptr<const SharedMesh>& source, const MMatrix& matrix);
+	virtual						~TransformedMesh();
+
+			bool				isValid() const;
+			const std::shared_ptr<const SharedMesh>&	source() const;
+
+			const MMatrix&		matrix() const;
+			void				setMatrix(const MMatrix& matrix);
+			TransformedMesh		transformed(const MMatrix& matrix) const;
+
+			unsigned int		numPoints() const;
+			void				getPoints(MPointArray& points) const;
+			MBoundingBox		boundingBox() const;
+			void				getLines(MPointArray& lines) const;
+			void				getTriangles(MPointArray& triangles, MVectorArray& normals) const;
+
+			MObject				createMeshData(MStatus* status) const;
+
+protected:
+
+			std::shared_ptr<const SharedMesh>	sharedMesh;
+			MMatrix								objectMatrix;
+
+};
+#endif
\ No newline at end of file
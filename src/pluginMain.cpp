@@ -6,6 +6,16 @@
 
 #include "BoneGeometry.h"
 #include "BoneGeometryDrawOverride.h"
+#include "BoneGeometryBatch.h"
+#include "BoneGeometryBatchOverride.h"
+#include "BoneGeometryCameraWatch.h"
+#include "BoneGeometryDirtyQueue.h"
+#include "BoneGeometryEvaluator.h"
+#include "BoneGeometryProfiler.h"
+#include "BoneGeometryStatsCommand.h"
+#include "BoneGeometryTraceCommand.h"
+#include "BoneGeometryAllocationsCommand.h"
+#include "PreparedGeometryCache.h"
 
 #include <maya/MFnPlugin.h>
 #include <maya/MDrawRegistry.h>
@@ -37,6 +47,100 @@ MStatus initializePlugin(MObject obj)
 
 	}
 
+	status = plugin.registerNode("boneGeometryBatch", BoneGeometryBatch::id, &BoneGeometryBatch::creator, &BoneGeometryBatch::initialize, MPxNode::kLocatorNode, &BoneGeometryBatch::drawDbClassification);
+
+	if (!status)
+	{
+
+		status.perror("registerNode");
+		return status;
+
+	}
+
+	status = MHWRender::MDrawRegistry::registerSubSceneOverrideCreator(BoneGeometryBatch::drawDbClassification, BoneGeometryBatch::drawRegistrantId, BoneGeometryBatchOverride::creator);
+
+	if (!status)
+	{
+
+		status.perror("registerSubSceneOverrideCreator");
+		return status;
+
+	}
+
+	status = plugin.registerEvaluator(BoneGeometryEvaluator::evaluatorName, BoneGeometryEvaluator::evaluatorPriority, BoneGeometryEvaluator::creator);
+
+	if (!status)
+	{
+
+		status.perror("registerEvaluator");
+		return status;
+
+	}
+
+	status = plugin.registerCommand(BoneGeometryStatsCommand::commandName, &BoneGeometryStatsCommand::creator, &BoneGeometryStatsCommand::newSyntax);
+
+	if (!status)
+	{
+
+		status.perror("registerCommand");
+		return status;
+
+	}
+
+	status = plugin.registerCommand(BoneGeometryTraceCommand::commandName, &BoneGeometryTraceCommand::creator, &BoneGeometryTraceCommand::newSyntax);
+
+	if (!status)
+	{
+
+		status.perror("registerCommand");
+		return status;
+
+	}
+
+	status = plugin.registerCommand(BoneGeometryAllocationsCommand::commandName, &BoneGeometryAllocationsCommand::creator, &BoneGeometryAllocationsCommand::newSyntax);
+
+	if (!status)
+	{
+
+		status.perror("registerCommand");
+		return status;
+
+	}
+
+	status = BoneGeometryAllocationsCommand::addFrameNotification();
+
+	if (!status)
+	{
+
+		status.perror("addFrameNotification");
+		return status;
+
+	}
+
+	status = BoneGeometryDirtyQueue::addCallbacks();
+
+	if (!status)
+	{
+
+		status.perror("addCallbacks");
+		return status;
+
+	}
+
+	status = BoneGeometryCameraWatch::addCallbacks();
+
+	if (!status)
+	{
+
+		status.perror("addCallbacks");
+		return status;
+
+	}
+
+	BoneGeometryTraceCommand::initializeFromOptionVar();
+	BoneGeometryAllocationsCommand::initializeFromOptionVar();
+	PreparedGeometryCache::initializeFromOptionVar();
+
 	return status;
 
 }
@@ -46,6 +150,27 @@ MStatus uninitializePlugin(MObject obj)
 
 	MStatus   status;
 
+	MFnPlugin plugin(obj);
+	status = plugin.deregisterEvaluator(BoneGeometryEvaluator::evaluatorName);
+
+	if (!status)
+	{
+
+		status.perror("deregisterEvaluator");
+		return status;
+
+	}
+
+	status = MHWRender::MDrawRegistry::deregisterSubSceneOverrideCreator(BoneGeometryBatch::drawDbClassification, BoneGeometryBatch::drawRegistrantId);
+
+	if (!status)
+	{
+
+		status.perror("deregisterSubSceneOverrideCreator");
+		return status;
+
+	}
+
 	status = MHWRender::MDrawRegistry::deregisterDrawOverrideCreator(BoneGeometry::drawDbClassification, BoneGeometry::drawRegistrantId);
 
 	if (!status) 
@@ -56,7 +181,76 @@ MStatus uninitializePlugin(MObject obj)
 
 	}
 
-	MFnPlugin plugin(obj);
+	status = BoneGeometryCameraWatch::removeCallbacks();
+
+	if (!status)
+	{
+
+		status.perror("removeCallbacks");
+		return status;
+
+	}
+
+	status = BoneGeometryDirtyQueue::removeCallbacks();
+
+	if (!status)
+	{
+
+		status.perror("removeCallbacks");
+		return status;
+
+	}
+
+	status = BoneGeometryAllocationsCommand::removeFrameNotification();
+
+	if (!status)
+	{
+
+		status.perror("removeFrameNotification");
+		return status;
+
+	}
+
+	status = plugin.deregisterCommand(BoneGeometryAllocationsCommand::commandName);
+
+	if (!status)
+	{
+
+		status.perror("deregisterCommand");
+		return status;
+
+	}
+
+	status = plugin.deregisterCommand(BoneGeometryTraceCommand::commandName);
+
+	if (!status)
+	{
+
+		status.perror("deregisterCommand");
+		return status;
+
+	}
+
+	status = plugin.deregisterCommand(BoneGeometryStatsCommand::commandName);
+
+	if (!status)
+	{
+
+		status.perror("deregisterCommand");
+		return status;
+
+	}
+
+	status = plugin.deregisterNode(BoneGeometryBatch::id);
+
+	if (!status)
+	{
+
+		status.perror("deregisterNode");
+		return status;
+
+	}
+
 	status = plugin.deregisterNode(BoneGeometry::id);
 
 	if (!status) 
@@ -67,6 +261,9 @@ MStatus uninitializePlugin(MObject obj)
 
 	}
 
+	PreparedGeometryCache::clear();
+	BoneGeometryProfiler::removeCategory();
+
 	return status;
 
-}
+}
\ No newline at end of file